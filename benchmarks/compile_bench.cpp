@@ -0,0 +1,185 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/codegen/codegen.hpp"
+#include "cinder/codegen/codegen_opts.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "cinder/support/compile_stats.hpp"
+#include "llvm/Support/FileSystem.h"
+#include "workload_generator.hpp"
+
+namespace {
+
+/** @brief Parsed modules kept alive for one benchmark iteration. */
+struct ParsedProgram {
+  std::vector<std::unique_ptr<Stmt>> roots;
+
+  std::vector<ModuleStmt*> Modules() const {
+    std::vector<ModuleStmt*> modules;
+    modules.reserve(roots.size());
+    for (const auto& root : roots) {
+      modules.push_back(static_cast<ModuleStmt*>(root.get()));
+    }
+    return modules;
+  }
+};
+
+/** @brief Scales the default workload by the benchmark argument. */
+WorkloadSpec SpecFor(const benchmark::State& state) {
+  WorkloadSpec spec;
+  spec.functions_per_module = static_cast<int>(state.range(0));
+  return spec;
+}
+
+std::vector<std::vector<cinder::Token>> LexAll(
+    const std::vector<GeneratedModule>& workload) {
+  std::vector<std::vector<cinder::Token>> tokens;
+  tokens.reserve(workload.size());
+  for (const auto& mod : workload) {
+    Lexer lexer{mod.source};
+    lexer.ScanTokens();
+    tokens.push_back(lexer.GetTokens());
+  }
+  return tokens;
+}
+
+ParsedProgram ParseAll(const std::vector<std::vector<cinder::Token>>& tokens) {
+  ParsedProgram program;
+  program.roots.reserve(tokens.size());
+  for (const auto& module_tokens : tokens) {
+    Parser parser{module_tokens};
+    program.roots.push_back(parser.Parse());
+  }
+  return program;
+}
+
+uint64_t CountAstNodes(const ParsedProgram& program) {
+  CompileStats::Enable(true);
+  CompileStats::Global().Reset();
+  CompileStats::Global().CountAst(program.Modules());
+  uint64_t nodes = 0;
+  for (const auto& [name, count] : CompileStats::Global().expr_counts) {
+    nodes += count;
+  }
+  for (const auto& [name, count] : CompileStats::Global().stmt_counts) {
+    nodes += count;
+  }
+  CompileStats::Global().Reset();
+  CompileStats::Enable(false);
+  return nodes;
+}
+
+uint64_t CountInstructions(llvm::Module& mod) {
+  uint64_t instructions = 0;
+  for (const llvm::Function& func : mod) {
+    for (const llvm::BasicBlock& block : func) {
+      instructions += block.size();
+    }
+  }
+  return instructions;
+}
+
+}  // namespace
+
+static void BM_Lexer(benchmark::State& state) {
+  auto workload = GenerateWorkload(SpecFor(state));
+  uint64_t tokens = 0;
+  for (auto _ : state) {
+    for (const auto& mod : workload) {
+      Lexer lexer{mod.source};
+      lexer.ScanTokens();
+      tokens += lexer.GetTokens().size();
+    }
+  }
+  state.counters["tokens/s"] =
+      benchmark::Counter(static_cast<double>(tokens),
+                         benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Lexer)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_Parser(benchmark::State& state) {
+  auto tokens = LexAll(GenerateWorkload(SpecFor(state)));
+  uint64_t nodes_per_program = CountAstNodes(ParseAll(tokens));
+  uint64_t nodes = 0;
+  for (auto _ : state) {
+    ParsedProgram program = ParseAll(tokens);
+    benchmark::DoNotOptimize(program.roots.data());
+    nodes += nodes_per_program;
+  }
+  state.counters["nodes/s"] = benchmark::Counter(
+      static_cast<double>(nodes), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Parser)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_Semantic(benchmark::State& state) {
+  auto tokens = LexAll(GenerateWorkload(SpecFor(state)));
+  uint64_t symbols = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    ParsedProgram program = ParseAll(tokens);
+    TypeContext types;
+    SemanticAnalyzer analyzer{types};
+    state.ResumeTiming();
+
+    analyzer.AnalyzeProgram(program.Modules());
+    symbols += analyzer.SymbolCount();
+  }
+  state.counters["symbols/s"] = benchmark::Counter(
+      static_cast<double>(symbols), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Semantic)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_Codegen(benchmark::State& state) {
+  auto tokens = LexAll(GenerateWorkload(SpecFor(state)));
+  uint64_t instructions = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    ParsedProgram program = ParseAll(tokens);
+    CodegenOpts opts{"cinder_bench.ll", CodegenOpts::Opt::EMIT_LLVM, false,
+                     {}};
+    Codegen cg{program.Modules(), opts};
+    if (!cg.SemanticPass(cg.modules_)) {
+      state.SkipWithError("generated workload failed semantic analysis");
+      break;
+    }
+    cg.ctx_->DebugInfo().Init(false, cg.ctx_->GetModule(), cg.modules_);
+    state.ResumeTiming();
+
+    cg.GenerateIR();
+    instructions += CountInstructions(cg.ctx_->GetModule());
+  }
+  state.counters["instructions/s"] = benchmark::Counter(
+      static_cast<double>(instructions), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Codegen)->RangeMultiplier(4)->Range(4, 256);
+
+/// Full pipeline from source text to a linked executable. The second
+/// argument is the optimization level.
+static void BM_EndToEnd(benchmark::State& state) {
+  auto workload = GenerateWorkload(SpecFor(state));
+  const std::string out_path = "cinder_bench_e2e";
+  for (auto _ : state) {
+    ParsedProgram program = ParseAll(LexAll(workload));
+    CodegenOpts opts{out_path, CodegenOpts::Opt::COMPILE, false, {}};
+    opts.opt_level = static_cast<unsigned>(state.range(1));
+    Codegen cg{program.Modules(), opts};
+    if (!cg.Generate()) {
+      state.SkipWithError("end-to-end compile failed");
+      break;
+    }
+  }
+  llvm::sys::fs::remove(out_path);
+}
+BENCHMARK(BM_EndToEnd)
+    ->ArgNames({"functions", "O"})
+    ->ArgsProduct({{16, 64}, {0, 1, 2, 3}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
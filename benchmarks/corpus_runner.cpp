@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../cinder/vendor/cxxopts.hpp"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Program.h"
+#include "llvm/Support/raw_ostream.h"
+
+/// Runs the `.ci` runtime corpus at every optimization level and backend and
+/// reports compile time, binary size and median runtime as JSON.
+///
+/// Backends:
+///   native - `cinder --compile`, cinder's own object emission and link.
+///   clang  - `cinder --emit-llvm`, then clang compiles and links the IR at
+///            the same optimization level.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct RunnerConfig {
+  std::string cinder;
+  std::string clang;
+  std::string corpus;
+  std::string work_dir;
+  std::vector<unsigned> levels;
+  std::vector<std::string> backends;
+  std::string filter;
+  unsigned runs;
+};
+
+double SecondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// Runs `args[0]` with `args` and optional stdout redirect, returns exit code.
+int Execute(const std::vector<std::string>& args,
+            std::optional<llvm::StringRef> stdout_path = std::nullopt,
+            std::string* error = nullptr) {
+  std::vector<llvm::StringRef> argv(args.begin(), args.end());
+  std::optional<llvm::StringRef> redirects[] = {std::nullopt, stdout_path,
+                                                std::nullopt};
+  return llvm::sys::ExecuteAndWait(args[0], argv, std::nullopt, redirects, 0,
+                                   0, error);
+}
+
+std::optional<std::string> ReadFile(const std::string& path) {
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer) {
+    return std::nullopt;
+  }
+  return (*buffer)->getBuffer().str();
+}
+
+/// Compiles `source` to `exe` with the requested backend.
+bool Compile(const RunnerConfig& config, const std::string& backend,
+             const std::string& source, const std::string& exe,
+             unsigned level, std::string* error) {
+  std::string opt = "-O" + std::to_string(level);
+  if (backend == "native") {
+    return Execute({config.cinder, "--compile", opt, "--l-flags=-lm", "-o",
+                    exe, source},
+                   std::nullopt, error) == 0;
+  }
+
+  std::string ir = exe + ".ll";
+  if (Execute({config.cinder, "--emit-llvm", opt, "-o", ir, source},
+              std::nullopt, error) != 0) {
+    return false;
+  }
+  bool ok = Execute({config.clang, opt, ir, "-o", exe, "-lm"}, std::nullopt,
+                    error) == 0;
+  llvm::sys::fs::remove(ir);
+  return ok;
+}
+
+llvm::json::Object RunOne(const RunnerConfig& config,
+                          const std::string& program,
+                          const std::string& backend, unsigned level,
+                          bool* ok) {
+  llvm::json::Object result{{"program", program},
+                            {"backend", backend},
+                            {"opt_level", level}};
+
+  llvm::SmallString<256> source{config.corpus};
+  llvm::sys::path::append(source, program + ".ci");
+  llvm::SmallString<256> expected_path{config.corpus};
+  llvm::sys::path::append(expected_path, program + ".expected");
+  llvm::SmallString<256> exe{config.work_dir};
+  llvm::sys::path::append(exe,
+                          program + "-" + backend + "-O" + std::to_string(level));
+  std::string output = exe.str().str() + ".out";
+
+  std::string error;
+  auto start = Clock::now();
+  if (!Compile(config, backend, source.str().str(), exe.str().str(), level,
+               &error)) {
+    result["error"] = "compile failed" + (error.empty() ? "" : ": " + error);
+    *ok = false;
+    return result;
+  }
+  result["compile_seconds"] = SecondsSince(start);
+
+  uint64_t size = 0;
+  if (!llvm::sys::fs::file_size(exe, size)) {
+    result["binary_bytes"] = size;
+  }
+
+  std::vector<double> times;
+  bool matches = true;
+  std::optional<std::string> expected = ReadFile(expected_path.str().str());
+  for (unsigned run = 0; run < config.runs; ++run) {
+    start = Clock::now();
+    int rc = Execute({exe.str().str()}, llvm::StringRef(output), &error);
+    times.push_back(SecondsSince(start));
+    if (rc != 0) {
+      result["error"] = "exit code " + std::to_string(rc);
+      matches = false;
+      break;
+    }
+    if (run == 0 && expected) {
+      matches = ReadFile(output) == expected;
+    }
+  }
+
+  llvm::json::Array run_seconds;
+  for (double t : times) {
+    run_seconds.push_back(t);
+  }
+  std::sort(times.begin(), times.end());
+  if (!times.empty()) {
+    result["median_seconds"] = times[times.size() / 2];
+  }
+  result["run_seconds"] = std::move(run_seconds);
+  result["output_matches"] = matches;
+  *ok = *ok && matches;
+
+  llvm::sys::fs::remove(exe);
+  llvm::sys::fs::remove(output);
+  return result;
+}
+
+std::vector<std::string> CorpusPrograms(const RunnerConfig& config) {
+  std::vector<std::string> programs;
+  std::error_code ec;
+  for (llvm::sys::fs::directory_iterator it(config.corpus, ec), end;
+       it != end && !ec; it.increment(ec)) {
+    llvm::StringRef path = it->path();
+    if (llvm::sys::path::extension(path) != ".ci") {
+      continue;
+    }
+    std::string stem = llvm::sys::path::stem(path).str();
+    if (stem.find(config.filter) != std::string::npos) {
+      programs.push_back(stem);
+    }
+  }
+  std::sort(programs.begin(), programs.end());
+  return programs;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  using namespace cxxopts;
+  Options options{"cinder_corpus",
+                  "Runs the cinder runtime benchmark corpus"};
+  options.add_options()("h,help", "Print this help message");
+  options.add_options()("cinder", "Path to the cinder compiler",
+                        value<std::string>()->default_value(CINDER_EXE));
+  options.add_options()("clang", "Path to clang for the clang backend",
+                        value<std::string>()->default_value("clang"));
+  options.add_options()("corpus", "Directory with .ci and .expected files",
+                        value<std::string>()->default_value(CINDER_CORPUS_DIR));
+  options.add_options()("levels", "Optimization levels to run",
+                        value<std::vector<unsigned>>()->default_value(
+                            "0,1,2,3"));
+  options.add_options()("backends", "Backends to run (native, clang)",
+                        value<std::vector<std::string>>()->default_value(
+                            "native,clang"));
+  options.add_options()("runs", "Timed runs per binary",
+                        value<unsigned>()->default_value("5"));
+  options.add_options()("filter", "Only run programs containing this text",
+                        value<std::string>()->default_value(""));
+  options.add_options()("o,output", "Write JSON results here (default stdout)",
+                        value<std::string>());
+
+  auto result = options.parse(argc, argv);
+  if (result.contains("help")) {
+    std::cout << options.help() << std::endl;
+    return 0;
+  }
+
+  RunnerConfig config;
+  config.cinder = result["cinder"].as<std::string>();
+  config.corpus = result["corpus"].as<std::string>();
+  config.levels = result["levels"].as<std::vector<unsigned>>();
+  config.backends = result["backends"].as<std::vector<std::string>>();
+  config.runs = std::max(1u, result["runs"].as<unsigned>());
+  config.filter = result["filter"].as<std::string>();
+
+  auto clang = llvm::sys::findProgramByName(result["clang"].as<std::string>());
+  config.clang = clang ? *clang : "";
+
+  llvm::SmallString<128> work_dir;
+  if (llvm::sys::fs::createUniqueDirectory("cinder-corpus", work_dir)) {
+    llvm::errs() << "cinder_corpus: could not create a work directory\n";
+    return 1;
+  }
+  config.work_dir = work_dir.str().str();
+
+  bool ok = true;
+  llvm::json::Array results;
+  for (const std::string& program : CorpusPrograms(config)) {
+    for (const std::string& backend : config.backends) {
+      if (backend != "native" && backend != "clang") {
+        llvm::errs() << "cinder_corpus: unknown backend " << backend << "\n";
+        return 1;
+      }
+      if (backend == "clang" && config.clang.empty()) {
+        llvm::errs() << "cinder_corpus: clang not found, skipping backend\n";
+        continue;
+      }
+      for (unsigned level : config.levels) {
+        llvm::errs() << program << " [" << backend << " -O" << level
+                     << "]\n";
+        results.push_back(RunOne(config, program, backend, level, &ok));
+      }
+    }
+  }
+  llvm::sys::fs::remove(config.work_dir);
+
+  llvm::json::Value report = llvm::json::Object{
+      {"cinder", config.cinder},
+      {"runs", config.runs},
+      {"results", std::move(results)},
+  };
+
+  if (result.contains("output")) {
+    std::error_code ec;
+    llvm::raw_fd_ostream out(result["output"].as<std::string>(), ec);
+    if (ec) {
+      llvm::errs() << "cinder_corpus: " << ec.message() << "\n";
+      return 1;
+    }
+    out << llvm::formatv("{0:2}", report) << "\n";
+  } else {
+    llvm::outs() << llvm::formatv("{0:2}", report) << "\n";
+  }
+  return ok ? 0 : 1;
+}
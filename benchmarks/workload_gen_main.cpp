@@ -0,0 +1,47 @@
+#include <iostream>
+#include <string>
+
+#include "../cinder/vendor/cxxopts.hpp"
+#include "workload_generator.hpp"
+
+int main(int argc, char** argv) {
+  using namespace cxxopts;
+  Options options{"cinder_workload_gen",
+                  "Writes a synthetic cinder program for benchmarking"};
+  options.add_options()("h,help", "Print this help message");
+  options.add_options()("o,output", "Output directory",
+                        value<std::string>()->default_value("workload"));
+  options.add_options()("modules", "Library modules in the import chain",
+                        value<int>()->default_value("4"));
+  options.add_options()("functions", "Functions per module",
+                        value<int>()->default_value("16"));
+  options.add_options()("structs", "Structs per module",
+                        value<int>()->default_value("4"));
+  options.add_options()("statements", "Local declarations per function",
+                        value<int>()->default_value("8"));
+  options.add_options()("depth", "Expression nesting depth",
+                        value<int>()->default_value("6"));
+  options.add_options()("seed", "Generator seed",
+                        value<uint32_t>()->default_value("1"));
+
+  auto result = options.parse(argc, argv);
+  if (result.contains("help")) {
+    std::cout << options.help() << std::endl;
+    return 0;
+  }
+
+  WorkloadSpec spec;
+  spec.modules = result["modules"].as<int>();
+  spec.functions_per_module = result["functions"].as<int>();
+  spec.structs_per_module = result["structs"].as<int>();
+  spec.statements_per_function = result["statements"].as<int>();
+  spec.expr_depth = result["depth"].as<int>();
+  spec.seed = result["seed"].as<uint32_t>();
+
+  const std::string dir = result["output"].as<std::string>();
+  if (!WriteWorkload(GenerateWorkload(spec), dir)) {
+    std::cout << "error writing workload to < " << dir << " >\n";
+    return 1;
+  }
+  return 0;
+}
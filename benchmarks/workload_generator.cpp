@@ -0,0 +1,143 @@
+#include "workload_generator.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+namespace {
+
+/** @brief Emits one module of the import chain. */
+class ModuleWriter {
+  const WorkloadSpec& spec_;
+  std::mt19937 rng_;
+  std::ostringstream out_;
+
+  int Pick(int bound) {
+    return std::uniform_int_distribution<int>(0, bound - 1)(rng_);
+  }
+
+  std::string Leaf(const std::vector<std::string>& names) {
+    if (names.empty() || Pick(3) == 0) {
+      return std::to_string(Pick(100));
+    }
+    return names[Pick(static_cast<int>(names.size()))];
+  }
+
+  std::string Expr(int depth, const std::vector<std::string>& names) {
+    if (depth <= 0) {
+      return Leaf(names);
+    }
+    static const char* kOps[] = {"+", "-", "*"};
+    return "(" + Expr(depth - 1, names) + " " + kOps[Pick(3)] + " " +
+           Expr(depth - 1, names) + ")";
+  }
+
+ public:
+  ModuleWriter(const WorkloadSpec& spec, uint32_t seed)
+      : spec_(spec), rng_(seed) {}
+
+  std::string Library(int index) {
+    const std::string mod = "m" + std::to_string(index);
+    out_ << "mod " << mod << ";\n";
+    if (index > 0) {
+      out_ << "import m" << index - 1 << ";\n";
+    }
+    out_ << "\n";
+
+    for (int s = 0; s < spec_.structs_per_module; ++s) {
+      out_ << "struct S" << index << "_" << s << "\n"
+           << "    int32: a;\n"
+           << "    int32: b;\n"
+           << "end\n\n";
+    }
+
+    for (int f = 0; f < spec_.functions_per_module; ++f) {
+      out_ << "def f" << index << "_" << f << "(int32 x, int32 y) -> int32\n";
+      std::vector<std::string> names{"x", "y"};
+      for (int v = 0; v < spec_.statements_per_function; ++v) {
+        std::string local = "v" + std::to_string(v);
+        out_ << "    int32: " << local << " = "
+             << Expr(spec_.expr_depth, names) << ";\n";
+        names.push_back(local);
+      }
+
+      out_ << "    int32: acc = " << names.back() << ";\n"
+           << "    for int32: i = 0; i < 4; ++i\n"
+           << "        acc = acc + i;\n"
+           << "    end\n";
+
+      if (spec_.structs_per_module > 0) {
+        out_ << "    S" << index << "_" << f % spec_.structs_per_module
+             << ": s = S" << index << "_" << f % spec_.structs_per_module
+             << "(x, y);\n"
+             << "    s.a = s.a + acc;\n";
+      }
+
+      out_ << "    return ";
+      if (spec_.structs_per_module > 0) {
+        out_ << "s.a + s.b";
+      } else {
+        out_ << "acc";
+      }
+      if (f > 0) {
+        out_ << " + f" << index << "_" << f - 1 << "(x, y)";
+      }
+      if (index > 0) {
+        out_ << " + m" << index - 1 << ".f" << index - 1 << "_"
+             << Pick(spec_.functions_per_module) << "(y, x)";
+      }
+      out_ << ";\nend\n\n";
+    }
+    return out_.str();
+  }
+
+  std::string Main() {
+    out_ << "mod main;\n";
+    int last = spec_.modules - 1;
+    if (last >= 0) {
+      out_ << "import m" << last << ";\n";
+    }
+    out_ << "\ndef main() -> int32\n"
+         << "    int32: total = 0;\n";
+    if (last >= 0) {
+      for (int f = 0; f < spec_.functions_per_module; ++f) {
+        out_ << "    total = total + m" << last << ".f" << last << "_" << f
+             << "(" << f << ", total);\n";
+      }
+    }
+    out_ << "    return 0;\nend\n";
+    return out_.str();
+  }
+};
+
+}  // namespace
+
+std::vector<GeneratedModule> GenerateWorkload(const WorkloadSpec& spec) {
+  std::vector<GeneratedModule> modules;
+  modules.reserve(spec.modules + 1);
+  for (int i = 0; i < spec.modules; ++i) {
+    ModuleWriter writer{spec, spec.seed + static_cast<uint32_t>(i)};
+    modules.push_back({"m" + std::to_string(i), writer.Library(i)});
+  }
+  ModuleWriter writer{spec, spec.seed};
+  modules.push_back({"main", writer.Main()});
+  return modules;
+}
+
+bool WriteWorkload(const std::vector<GeneratedModule>& modules,
+                   const std::string& dir) {
+  std::error_code ec;
+  std::filesystem::create_directories(dir, ec);
+  if (ec) {
+    return false;
+  }
+  for (const auto& mod : modules) {
+    std::ofstream file{std::filesystem::path(dir) / (mod.name + ".ci")};
+    if (!file) {
+      return false;
+    }
+    file << mod.source;
+  }
+  return true;
+}
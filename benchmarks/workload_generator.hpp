@@ -0,0 +1,43 @@
+#ifndef WORKLOAD_GENERATOR_H_
+#define WORKLOAD_GENERATOR_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Shape of a synthetic cinder program.
+ *
+ * Modules form a single import chain (`m1` imports `m0`, `m2` imports `m1`,
+ * ...) ending in a `main` module, so loading and name resolution scale with
+ * the chain length.
+ */
+struct WorkloadSpec {
+  int modules = 4;               /**< Library modules before `main`. */
+  int functions_per_module = 16; /**< Functions defined in each module. */
+  int structs_per_module = 4;    /**< Structs declared in each module. */
+  int statements_per_function = 8; /**< Local declarations per function. */
+  int expr_depth = 6; /**< Nesting depth of generated arithmetic. */
+  uint32_t seed = 1;  /**< Seed for the deterministic generator. */
+};
+
+/** @brief One generated `.ci` translation unit. */
+struct GeneratedModule {
+  std::string name;   /**< Module name, also used as the file stem. */
+  std::string source; /**< Full module source text. */
+};
+
+/**
+ * @brief Generates a program described by `spec`.
+ * @return Modules in dependency order; the last one is `main`.
+ */
+std::vector<GeneratedModule> GenerateWorkload(const WorkloadSpec& spec);
+
+/**
+ * @brief Writes each module to `<dir>/<name>.ci`.
+ * @return False when a file could not be written.
+ */
+bool WriteWorkload(const std::vector<GeneratedModule>& modules,
+                   const std::string& dir);
+
+#endif
@@ -5,6 +5,7 @@
 #include <optional>
 #include <string>
 #include <system_error>
+#include <variant>
 #include <vector>
 
 #include "cinder/ast/types.hpp"
@@ -26,6 +27,16 @@ struct CallExpr;
 struct Assign;
 struct MemberAssign;
 struct Conditional;
+struct Logical;
+struct Unary;
+struct IfExpr;
+struct IndexAccess;
+struct IndexAssign;
+struct ArrayLiteral;
+struct NewArray;
+struct Cast;
+struct IntrinsicCall;
+struct SliceExpr;
 
 /** @brief Code generation visitor interface for expression nodes. */
 struct CodegenExprVisitor {
@@ -40,6 +51,16 @@ struct CodegenExprVisitor {
   virtual llvm::Value* Visit(Assign& expr) = 0;
   virtual llvm::Value* Visit(MemberAssign& expr) = 0;
   virtual llvm::Value* Visit(Conditional& expr) = 0;
+  virtual llvm::Value* Visit(Logical& expr) = 0;
+  virtual llvm::Value* Visit(Unary& expr) = 0;
+  virtual llvm::Value* Visit(IfExpr& expr) = 0;
+  virtual llvm::Value* Visit(IndexAccess& expr) = 0;
+  virtual llvm::Value* Visit(IndexAssign& expr) = 0;
+  virtual llvm::Value* Visit(ArrayLiteral& expr) = 0;
+  virtual llvm::Value* Visit(NewArray& expr) = 0;
+  virtual llvm::Value* Visit(Cast& expr) = 0;
+  virtual llvm::Value* Visit(IntrinsicCall& expr) = 0;
+  virtual llvm::Value* Visit(SliceExpr& expr) = 0;
 };
 
 /** @brief Semantic analysis visitor interface for expression nodes. */
@@ -55,6 +76,16 @@ struct SemanticExprVisitor {
   virtual void Visit(Assign& expr) = 0;
   virtual void Visit(MemberAssign& expr) = 0;
   virtual void Visit(Conditional& expr) = 0;
+  virtual void Visit(Logical& expr) = 0;
+  virtual void Visit(Unary& expr) = 0;
+  virtual void Visit(IfExpr& expr) = 0;
+  virtual void Visit(IndexAccess& expr) = 0;
+  virtual void Visit(IndexAssign& expr) = 0;
+  virtual void Visit(ArrayLiteral& expr) = 0;
+  virtual void Visit(NewArray& expr) = 0;
+  virtual void Visit(Cast& expr) = 0;
+  virtual void Visit(IntrinsicCall& expr) = 0;
+  virtual void Visit(SliceExpr& expr) = 0;
 };
 
 struct ExprDumperVisitor {
@@ -69,8 +100,26 @@ struct ExprDumperVisitor {
   virtual std::string Visit(Assign& expr) = 0;
   virtual std::string Visit(MemberAssign& expr) = 0;
   virtual std::string Visit(Conditional& expr) = 0;
+  virtual std::string Visit(Logical& expr) = 0;
+  virtual std::string Visit(Unary& expr) = 0;
+  virtual std::string Visit(IfExpr& expr) = 0;
+  virtual std::string Visit(IndexAccess& expr) = 0;
+  virtual std::string Visit(IndexAssign& expr) = 0;
+  virtual std::string Visit(ArrayLiteral& expr) = 0;
+  virtual std::string Visit(NewArray& expr) = 0;
+  virtual std::string Visit(Cast& expr) = 0;
+  virtual std::string Visit(IntrinsicCall& expr) = 0;
+  virtual std::string Visit(SliceExpr& expr) = 0;
 };
 
+/**
+ * @brief Compile-time value of a scalar expression.
+ *
+ * Integers are held sign- or zero-extended from their type's width, so a
+ * `uint64` above `INT64_MAX` reads back negative.
+ */
+using ConstValue = std::variant<int64_t, double, bool>;
+
 /** @brief Abstract base class for all expression AST nodes. */
 struct Expr {
   enum class ExprType {
@@ -84,10 +133,21 @@ struct Expr {
     Assign,
     MemberAssign,
     Conditional,
+    Logical,
+    Unary,
+    IfExpr,
+    Index,
+    IndexAssign,
+    ArrayLiteral,
+    NewArray,
+    Cast,
+    Intrinsic,
+    Slice,
     Unknown
   };
   cinder::types::Type* type = nullptr; /**< Resolved semantic type, if known. */
   std::optional<SymbolId> id = std::nullopt; /**< Bound symbol id, if any. */
+  std::optional<ConstValue> constant; /**< Folded value, if compile-time. */
   ExprType expr_type;
 
   Expr(ExprType type) : expr_type(type) {}
@@ -130,6 +190,26 @@ struct Expr {
   bool IsMemberAssign();
   /** @brief Returns whether this node is `Conditional`. */
   bool IsConditional();
+  /** @brief Returns whether this node is `Logical`. */
+  bool IsLogical();
+  /** @brief Returns whether this node is `Unary`. */
+  bool IsUnary();
+  /** @brief Returns whether this node is `IfExpr`. */
+  bool IsIfExpr();
+  /** @brief Returns whether this node is `Index`. */
+  bool IsIndexAccess();
+  /** @brief Returns whether this node is `IndexAssign`. */
+  bool IsIndexAssign();
+  /** @brief Returns whether this node is `ArrayLiteral`. */
+  bool IsArrayLiteral();
+  /** @brief Returns whether this node is `NewArray`. */
+  bool IsNewArray();
+  /** @brief Returns whether this node is `Cast`. */
+  bool IsCast();
+  /** @brief Returns whether this node is `IntrinsicCall`. */
+  bool IsIntrinsic();
+  /** @brief Returns whether this node is `Slice`. */
+  bool IsSliceExpr();
   /** @brief Returns whether this node's id contains a value. */
   bool HasID();
   /** @brief Returns the underlying symbol id. */
@@ -164,6 +244,7 @@ struct Expr {
 /** @brief Literal expression node. */
 struct Literal : Expr {
   cinder::TokenValue value; /**< Literal value payload. */
+  std::optional<cinder::Token::Type> suffix; /**< Suffix type, if any. */
 
   explicit Literal(cinder::TokenValue value);
 
@@ -285,6 +366,8 @@ struct Conditional : Expr {
   std::unique_ptr<Expr> left;  /**< Left-hand side expression. */
   std::unique_ptr<Expr> right; /**< Right-hand side expression. */
   cinder::Token op;            /**< Comparison operator token. */
+  /** @brief Common type both operands are compared as, once analyzed. */
+  cinder::types::Type* operand_type = nullptr;
 
   Conditional(std::unique_ptr<Expr> left, std::unique_ptr<Expr> right,
               cinder::Token op);
@@ -302,6 +385,71 @@ struct Conditional : Expr {
   std::string Accept(ExprDumperVisitor& visitor) override;
 };
 
+/** @brief Short-circuiting `&&` or `||` expression node. */
+struct Logical : Expr {
+  std::unique_ptr<Expr> left;  /**< Always evaluated. */
+  std::unique_ptr<Expr> right; /**< Evaluated only if `left` does not decide. */
+  cinder::Token op;            /**< `&&` or `||` token. */
+
+  Logical(std::unique_ptr<Expr> left, std::unique_ptr<Expr> right,
+          cinder::Token op);
+
+  /**
+   * @brief Accepts a codegen visitor.
+   * @param visitor Codegen visitor.
+   * @return Value produced by code generation.
+   */
+  llvm::Value* Accept(CodegenExprVisitor& visitor) override;
+
+  /** @brief Accepts a semantic visitor. */
+  void Accept(SemanticExprVisitor& visitor) override;
+
+  std::string Accept(ExprDumperVisitor& visitor) override;
+};
+
+/** @brief Prefix operator applied to a value (`!done`). */
+struct Unary : Expr {
+  cinder::Token op;              /**< Operator token. */
+  std::unique_ptr<Expr> operand; /**< Operand expression. */
+
+  Unary(cinder::Token op, std::unique_ptr<Expr> operand);
+
+  /**
+   * @brief Accepts a codegen visitor.
+   * @param visitor Codegen visitor.
+   * @return Value produced by code generation.
+   */
+  llvm::Value* Accept(CodegenExprVisitor& visitor) override;
+
+  /** @brief Accepts a semantic visitor. */
+  void Accept(SemanticExprVisitor& visitor) override;
+
+  std::string Accept(ExprDumperVisitor& visitor) override;
+};
+
+/** @brief Conditional expression node (`a if cond else b`). */
+struct IfExpr : Expr {
+  std::unique_ptr<Expr> then;      /**< Value when `cond` holds. */
+  std::unique_ptr<Expr> cond;      /**< Boolean condition. */
+  std::unique_ptr<Expr> otherwise; /**< Value when `cond` does not hold. */
+  cinder::Token if_token;          /**< `if` token. */
+
+  IfExpr(std::unique_ptr<Expr> then, std::unique_ptr<Expr> cond,
+         std::unique_ptr<Expr> otherwise, cinder::Token if_token);
+
+  /**
+   * @brief Accepts a codegen visitor.
+   * @param visitor Codegen visitor.
+   * @return Value produced by code generation.
+   */
+  llvm::Value* Accept(CodegenExprVisitor& visitor) override;
+
+  /** @brief Accepts a semantic visitor. */
+  void Accept(SemanticExprVisitor& visitor) override;
+
+  std::string Accept(ExprDumperVisitor& visitor) override;
+};
+
 /** @brief Assignment expression node. */
 struct Assign : Expr {
   cinder::Token name;          /**< Target variable identifier token. */
@@ -341,6 +489,7 @@ struct MemberAssign : Expr {
 struct CallExpr : Expr {
   std::unique_ptr<Expr> callee;            /**< Callee expression. */
   std::vector<std::unique_ptr<Expr>> args; /**< Call argument expressions. */
+  bool is_tail = false; /**< Emitted `musttail`; set by `return tail`. */
 
   CallExpr(std::unique_ptr<Expr> callee,
            std::vector<std::unique_ptr<Expr>> args);
@@ -358,4 +507,129 @@ struct CallExpr : Expr {
   std::string Accept(ExprDumperVisitor& visitor) override;
 };
 
+/** @brief Bounds-check requirement computed for an element access. */
+enum class BoundsCheck {
+  Required, /**< Checked at the access itself. */
+  Proven,   /**< Index is provably in range; no check is needed. */
+  Hoisted,  /**< Covered by one range check ahead of the enclosing loop. */
+};
+
+/** @brief Element access expression node (`object[index]`). */
+struct IndexAccess : Expr {
+  std::unique_ptr<Expr> object; /**< Indexed array or slice expression. */
+  std::unique_ptr<Expr> index;  /**< Element index expression. */
+  cinder::Token bracket;        /**< Closing `]` token, used for locations. */
+  BoundsCheck bounds = BoundsCheck::Required; /**< Check classification. */
+  Expr* loop_offset = nullptr; /**< Loop-invariant index term, if hoisted. */
+
+  IndexAccess(std::unique_ptr<Expr> object, std::unique_ptr<Expr> index,
+              cinder::Token bracket);
+
+  llvm::Value* Accept(CodegenExprVisitor& visitor) override;
+  void Accept(SemanticExprVisitor& visitor) override;
+  std::string Accept(ExprDumperVisitor& visitor) override;
+};
+
+/** @brief Element assignment expression node (`object[index] = value`). */
+struct IndexAssign : Expr {
+  std::unique_ptr<IndexAccess> target; /**< Element being written. */
+  std::unique_ptr<Expr> value;         /**< Value expression to store. */
+
+  IndexAssign(std::unique_ptr<IndexAccess> target,
+              std::unique_ptr<Expr> value);
+
+  llvm::Value* Accept(CodegenExprVisitor& visitor) override;
+  void Accept(SemanticExprVisitor& visitor) override;
+  std::string Accept(ExprDumperVisitor& visitor) override;
+};
+
+/** @brief Array literal expression node (`[a, b, c]`). */
+struct ArrayLiteral : Expr {
+  cinder::Token bracket;                       /**< Opening `[` token. */
+  std::vector<std::unique_ptr<Expr>> elements; /**< Element expressions. */
+
+  ArrayLiteral(cinder::Token bracket,
+               std::vector<std::unique_ptr<Expr>> elements);
+
+  llvm::Value* Accept(CodegenExprVisitor& visitor) override;
+  void Accept(SemanticExprVisitor& visitor) override;
+  std::string Accept(ExprDumperVisitor& visitor) override;
+};
+
+/** @brief Heap slice allocation expression node (`new int32[n]`). */
+struct NewArray : Expr {
+  cinder::Token keyword;        /**< The `new` keyword token. */
+  cinder::Token element_type;   /**< Element type token. */
+  std::unique_ptr<Expr> length; /**< Element count expression. */
+
+  NewArray(cinder::Token keyword, cinder::Token element_type,
+           std::unique_ptr<Expr> length);
+
+  llvm::Value* Accept(CodegenExprVisitor& visitor) override;
+  void Accept(SemanticExprVisitor& visitor) override;
+  std::string Accept(ExprDumperVisitor& visitor) override;
+};
+
+/** @brief Explicit numeric conversion expression node (`int64(x)`). */
+struct Cast : Expr {
+  cinder::Token target;        /**< Target type specifier token. */
+  std::unique_ptr<Expr> value; /**< Converted expression. */
+
+  Cast(cinder::Token target, std::unique_ptr<Expr> value);
+
+  llvm::Value* Accept(CodegenExprVisitor& visitor) override;
+  void Accept(SemanticExprVisitor& visitor) override;
+  std::string Accept(ExprDumperVisitor& visitor) override;
+};
+
+/** @brief Builtin operations spelled `@name(...)`. */
+enum class IntrinsicKind {
+  Sqrt,     /**< `@sqrt(x)` */
+  Fma,      /**< `@fma(a, b, c)` */
+  Abs,      /**< `@abs(x)` */
+  Floor,    /**< `@floor(x)` */
+  Ceil,     /**< `@ceil(x)` */
+  Min,      /**< `@min(a, b)` */
+  Max,      /**< `@max(a, b)` */
+  Popcount, /**< `@popcount(x)` */
+  Ctz,      /**< `@ctz(x)` */
+  Clz,      /**< `@clz(x)` */
+  Prefetch, /**< `@prefetch(xs[i])` */
+  Expect,   /**< `@expect(value, expected)` */
+};
+
+/** @brief Compiler intrinsic call expression node (`@sqrt(x)`). */
+struct IntrinsicCall : Expr {
+  cinder::Token name;                      /**< Intrinsic name token. */
+  std::vector<std::unique_ptr<Expr>> args; /**< Argument expressions. */
+  std::optional<IntrinsicKind> kind; /**< Resolved during semantic analysis. */
+
+  IntrinsicCall(cinder::Token name, std::vector<std::unique_ptr<Expr>> args);
+
+  llvm::Value* Accept(CodegenExprVisitor& visitor) override;
+  void Accept(SemanticExprVisitor& visitor) override;
+  std::string Accept(ExprDumperVisitor& visitor) override;
+};
+
+/**
+ * @brief Subrange expression node (`object[start:end]`).
+ *
+ * Views elements `start` up to but excluding `end` of a string, slice or
+ * array without copying. Either bound may be omitted, defaulting to 0 and
+ * the length.
+ */
+struct SliceExpr : Expr {
+  std::unique_ptr<Expr> object; /**< String, slice or array being sliced. */
+  std::unique_ptr<Expr> start;  /**< First element, or null for 0. */
+  std::unique_ptr<Expr> end;    /**< One past the last, or null for length. */
+  cinder::Token bracket;        /**< Closing `]` token, used for locations. */
+
+  SliceExpr(std::unique_ptr<Expr> object, std::unique_ptr<Expr> start,
+            std::unique_ptr<Expr> end, cinder::Token bracket);
+
+  llvm::Value* Accept(CodegenExprVisitor& visitor) override;
+  void Accept(SemanticExprVisitor& visitor) override;
+  std::string Accept(ExprDumperVisitor& visitor) override;
+};
+
 #endif
@@ -14,6 +14,35 @@
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Value.h"
 
+/** @brief Source-level expectation for a branch condition. */
+enum class BranchHint {
+  None,     /**< No annotation. */
+  Likely,   /**< `likely cond`: the condition is usually true. */
+  Unlikely, /**< `unlikely cond`: the condition is usually false. */
+};
+
+/** @brief Side effects an `extern` declaration promises to be free of. */
+enum class ExternEffects {
+  None,  /**< May read and write any memory. */
+  Pure,  /**< `extern pure`: reads memory but writes none. */
+  Const, /**< `extern const`: depends on its arguments alone. */
+};
+
+/** @brief Inlining request from a `def` annotation. */
+enum class InlinePolicy {
+  Default, /**< Left to the inliner's cost model. */
+  Hint,    /**< `@inline`: favoured by the cost model. */
+  Always,  /**< `@always_inline`: inlined into every caller. */
+  Never,   /**< `@noinline`: kept out of line. */
+};
+
+/** @brief Expected call frequency from a `def` annotation. */
+enum class CallFrequency {
+  Default, /**< No annotation. */
+  Cold,    /**< `@cold`: rarely called; optimized for size. */
+  Hot,     /**< `@hot`: on a hot path. */
+};
+
 struct ModuleStmt;
 struct ExpressionStmt;
 struct FunctionStmt;
@@ -23,6 +52,7 @@ struct VarDeclarationStmt;
 struct IfStmt;
 struct ForStmt;
 struct WhileStmt;
+struct MatchStmt;
 struct ImportStmt;
 struct StructStmt;
 
@@ -38,6 +68,7 @@ struct StmtVisitor {
   virtual llvm::Value* Visit(IfStmt& stmt) = 0;
   virtual llvm::Value* Visit(ForStmt& stmt) = 0;
   virtual llvm::Value* Visit(WhileStmt& stmt) = 0;
+  virtual llvm::Value* Visit(MatchStmt& stmt) = 0;
   virtual llvm::Value* Visit(ImportStmt& stmt) = 0;
   virtual llvm::Value* Visit(StructStmt& stmt) = 0;
 };
@@ -54,6 +85,7 @@ struct SemanticStmtVisitor {
   virtual void Visit(IfStmt& stmt) = 0;
   virtual void Visit(ForStmt& stmt) = 0;
   virtual void Visit(WhileStmt& stmt) = 0;
+  virtual void Visit(MatchStmt& stmt) = 0;
   virtual void Visit(ImportStmt& stmt) = 0;
   virtual void Visit(StructStmt& stmt) = 0;
 };
@@ -69,6 +101,7 @@ struct StmtDumperVisitor {
   virtual std::string Visit(IfStmt& stmt) = 0;
   virtual std::string Visit(ForStmt& stmt) = 0;
   virtual std::string Visit(WhileStmt& stmt) = 0;
+  virtual std::string Visit(MatchStmt& stmt) = 0;
   virtual std::string Visit(ImportStmt& stmt) = 0;
   virtual std::string Visit(StructStmt& stmt) = 0;
 };
@@ -85,6 +118,7 @@ struct Stmt {
     If,
     For,
     While,
+    Match,
     Import,
     Struct,
   };
@@ -128,6 +162,8 @@ struct Stmt {
   bool IsFor();
   /** @brief Returns whether this node is `WhileStmt`. */
   bool IsWhile();
+  /** @brief Returns whether this node is `MatchStmt`. */
+  bool IsMatch();
   /** @brief Returns whether this node is `ImportStmt`. */
   bool IsImport();
   /** @brief Returns whether this node is `StructStmt`. */
@@ -206,11 +242,23 @@ struct FunctionProto : Stmt {
   std::vector<cinder::FuncArg> args; /**< Function parameter list. */
   bool is_variadic; /**< True when prototype accepts varargs. */
   bool is_extern;   /**< True when declared with `extern`. */
+  ExternEffects effects = ExternEffects::None; /**< Declared C effects. */
+  InlinePolicy inline_policy = InlinePolicy::Default; /**< `@inline` etc. */
+  CallFrequency frequency = CallFrequency::Default;   /**< `@cold`/`@hot`. */
+  cinder::types::FunctionType* resolved_type =
+      nullptr; /**< Resolved signature (if analyzed). */
 
   FunctionProto(cinder::Token name, cinder::Token return_type,
                 std::vector<cinder::FuncArg> args, bool is_variadic,
                 bool is_extern = false);
 
+  /**
+   * @brief Returns whether C code enters this function: `main` and
+   * `extern` declarations keep the C calling convention, the rest use
+   * `fastcc`.
+   */
+  bool IsExported() const;
+
   /**
    * @brief Accepts a code generation visitor.
    * @param visitor Codegen visitor.
@@ -245,6 +293,9 @@ struct FunctionStmt : Stmt {
 struct ReturnStmt : Stmt {
   cinder::Token ret_token;     /**< `return` token. */
   std::unique_ptr<Expr> value; /**< Optional returned expression. */
+  cinder::types::Type* resolved_type =
+      nullptr; /**< Enclosing function's return type (if analyzed). */
+  bool is_tail = false; /**< `return tail f(...)`: a guaranteed tail call. */
 
   ReturnStmt(cinder::Token ret_token, std::unique_ptr<Expr> value);
 
@@ -264,6 +315,10 @@ struct VarDeclarationStmt : Stmt {
   cinder::Token type;          /**< Declared type token. */
   cinder::Token name;          /**< Variable identifier token. */
   std::unique_ptr<Expr> value; /**< Initializer expression. */
+  cinder::types::Type* resolved_type =
+      nullptr;           /**< Resolved declared type (if analyzed). */
+  bool is_const = false;  /**< Declared with `const`; value is folded. */
+  bool is_global = false; /**< Declared at module scope. */
 
   VarDeclarationStmt(cinder::Token type, cinder::Token name,
                      std::unique_ptr<Expr> value);
@@ -281,9 +336,10 @@ struct VarDeclarationStmt : Stmt {
 
 /** @brief If/else statement node. */
 struct IfStmt : Stmt {
-  std::unique_ptr<Expr> cond;      /**< Condition expression. */
-  std::unique_ptr<Stmt> then;      /**< Then-branch statement. */
-  std::unique_ptr<Stmt> otherwise; /**< Optional else-branch statement. */
+  std::unique_ptr<Expr> cond;         /**< Condition expression. */
+  std::unique_ptr<Stmt> then;         /**< Then-branch statement. */
+  std::unique_ptr<Stmt> otherwise;    /**< Optional else-branch statement. */
+  BranchHint hint = BranchHint::None; /**< Expected condition outcome. */
 
   IfStmt(std::unique_ptr<Expr> cond, std::unique_ptr<Stmt> then,
          std::unique_ptr<Stmt> otherwise);
@@ -305,6 +361,10 @@ struct ForStmt : Stmt {
   std::unique_ptr<Expr> condition;         /**< Loop continuation condition. */
   std::unique_ptr<Expr> step;              /**< Optional step expression. */
   std::vector<std::unique_ptr<Stmt>> body; /**< Loop body statements. */
+  BranchHint hint = BranchHint::None;      /**< Expected condition outcome. */
+  Expr* range_bound = nullptr; /**< Exclusive bound of a counted loop. */
+  std::vector<IndexAccess*>
+      hoisted_checks; /**< Accesses range-checked ahead of the loop. */
 
   ForStmt(std::unique_ptr<Stmt> initializer, std::unique_ptr<Expr> condition,
           std::unique_ptr<Expr> step, std::vector<std::unique_ptr<Stmt>> body);
@@ -324,6 +384,7 @@ struct ForStmt : Stmt {
 struct WhileStmt : Stmt {
   std::unique_ptr<Expr> condition;         /**< Loop continuation condition. */
   std::vector<std::unique_ptr<Stmt>> body; /**< Loop body statements. */
+  BranchHint hint = BranchHint::None;      /**< Expected condition outcome. */
 
   WhileStmt(std::unique_ptr<Expr> condition,
             std::vector<std::unique_ptr<Stmt>> body);
@@ -339,6 +400,44 @@ struct WhileStmt : Stmt {
   std::string Accept(StmtDumperVisitor& visitor) override;
 };
 
+/** @brief One value, or inclusive `low...high` range, a `match` arm takes. */
+struct MatchPattern {
+  std::unique_ptr<Expr> low;  /**< The value, or the first of the range. */
+  std::unique_ptr<Expr> high; /**< Last value of a range; null otherwise. */
+  int64_t low_value = 0;  /**< Folded `low` in the subject's type. */
+  int64_t high_value = 0; /**< Folded `high`, or `low_value` for a value. */
+};
+
+/** @brief One `case` arm of a `match` statement. */
+struct MatchArm {
+  cinder::Token case_token;                /**< `case` token. */
+  std::vector<MatchPattern> patterns;      /**< Values taking this arm. */
+  std::vector<std::unique_ptr<Stmt>> body; /**< Arm statements. */
+};
+
+/** @brief Multi-way branch on an integer (`match x case 1 ... end`). */
+struct MatchStmt : Stmt {
+  cinder::Token match_token;     /**< `match` token. */
+  std::unique_ptr<Expr> subject; /**< Integer being matched. */
+  std::vector<MatchArm> arms;    /**< `case` arms in source order. */
+  std::vector<std::unique_ptr<Stmt>>
+      otherwise; /**< `else` arm statements; empty when absent. */
+
+  MatchStmt(cinder::Token match_token, std::unique_ptr<Expr> subject,
+            std::vector<MatchArm> arms,
+            std::vector<std::unique_ptr<Stmt>> otherwise);
+
+  /**
+   * @brief Accepts a code generation visitor.
+   * @param visitor Codegen visitor.
+   * @return Value produced by code generation.
+   */
+  llvm::Value* Accept(StmtVisitor& visitor) override;
+  /** @brief Accepts a semantic analysis visitor. */
+  void Accept(SemanticStmtVisitor& visitor) override;
+  std::string Accept(StmtDumperVisitor& visitor) override;
+};
+
 struct ImportStmt : Stmt {
   cinder::Token mod_name;
 
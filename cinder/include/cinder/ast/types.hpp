@@ -1,6 +1,7 @@
 #ifndef TYPES_H_
 #define TYPES_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <system_error>
@@ -22,6 +23,10 @@ enum class TypeKind {
   String,
   Function,
   Struct,
+  Array,
+  Slice,
+  Vector,
+  Reference,
 };
 
 struct IntType;
@@ -30,6 +35,10 @@ struct BoolType;
 struct StructType;
 struct FunctionType;
 struct StructType;
+struct ArrayType;
+struct SliceType;
+struct VectorType;
+struct ReferenceType;
 
 /** @brief Base class for all semantic type descriptors. */
 struct Type {
@@ -51,9 +60,27 @@ struct Type {
   bool Function();
   /** @brief Returns whether this is `TypeKind::Struct`. */
   bool Struct();
-  /** @brief Returns whether this and `type` have the same `TypeKind`. */
+  /** @brief Returns whether this is `TypeKind::Array`. */
+  bool Array();
+  /** @brief Returns whether this is `TypeKind::Slice`. */
+  bool Slice();
+  /** @brief Returns whether this is `TypeKind::Vector`. */
+  bool Vector();
+  /** @brief Returns whether this is `TypeKind::Reference`. */
+  bool Reference();
+  /**
+   * @brief Returns the element count fixed by the type.
+   * @return Array length or vector lane count, or 0 for other types.
+   */
+  uint64_t FixedLength();
+  /**
+   * @brief Returns whether this and `type` are the same type.
+   *
+   * Integers must also agree on width and signedness and floats on width;
+   * structs, arrays, slices, vectors and references compare structurally.
+   */
   bool IsThisType(Type* type);
-  /** @brief Returns whether this and `type` have the same `TypeKind`. */
+  /** @brief Reference overload of `IsThisType(Type*)`. */
   bool IsThisType(Type& type);
   /** @brief Returns whether this has exactly `type` kind. */
   bool IsThisType(TypeKind type);
@@ -144,6 +171,54 @@ struct StructType : Type {
   int FieldIndex(const std::string& field) const;
 };
 
+/** @brief Fixed-length array stored inline (`int32[8]`). */
+struct ArrayType : Type {
+  Type* element;   /**< Element type. */
+  uint64_t length; /**< Number of elements. */
+
+  ArrayType(Type* element, uint64_t length)
+      : Type(TypeKind::Array), element(element), length(length) {}
+};
+
+/**
+ * @brief Heap-backed view over contiguous elements (`int32[]`).
+ *
+ * Lowered as a `{ptr, i64}` pair of data pointer and element count.
+ */
+struct SliceType : Type {
+  Type* element; /**< Element type. */
+
+  explicit SliceType(Type* element) : Type(TypeKind::Slice), element(element) {}
+};
+
+/**
+ * @brief SIMD vector of scalar lanes (`flt32x4`), lowered to `<N x T>`.
+ *
+ * Vectors of `bool` are the masks produced by lane-wise comparisons.
+ */
+struct VectorType : Type {
+  Type* element;  /**< Lane type. */
+  unsigned lanes; /**< Number of lanes. */
+
+  VectorType(Type* element, unsigned lanes)
+      : Type(TypeKind::Vector), element(element), lanes(lanes) {}
+};
+
+/**
+ * @brief Parameter or local bound to another variable's storage.
+ *
+ * `ref T` and `ptr T` are lowered to a pointer to the `T`. Reads and writes
+ * of the name go through it. A `ref` is never null and points at a whole
+ * `T`; a `ptr` promises neither, since C code may pass any pointer.
+ */
+struct ReferenceType : Type {
+  Type* referent; /**< Type of the bound storage. */
+  bool nullable;  /**< Declared `ptr` rather than `ref`. */
+
+  ReferenceType(Type* referent, bool nullable)
+      : Type(TypeKind::Reference), referent(referent), nullable(nullable) {}
+};
+
 }  // namespace types
 
 }  // namespace cinder
@@ -0,0 +1,83 @@
+#ifndef C_ABI_H_
+#define C_ABI_H_
+
+#include <vector>
+
+#include "llvm/IR/DataLayout.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Type.h"
+#include "llvm/TargetParser/Triple.h"
+
+/** @brief How one argument or return value crosses a C call boundary. */
+struct CAbiArg {
+  enum class Kind {
+    Direct,   /**< Passed as its own LLVM type. */
+    Coerce,   /**< Reinterpreted as `type` to land in registers. */
+    Indirect, /**< Passed through memory: a pointer argument or `sret`. */
+  };
+  Kind kind = Kind::Direct;
+  llvm::Type* type = nullptr; /**< Register type of a `Coerce` value. */
+  bool byval = false; /**< Indirect argument copied by the callee's frame. */
+};
+
+/** @brief C lowering of a whole function signature. */
+struct CAbiSignature {
+  CAbiArg ret;                 /**< Return value; `Indirect` means `sret`. */
+  std::vector<CAbiArg> params; /**< One entry per declared parameter. */
+};
+
+/**
+ * @brief Classifies aggregates under the C calling convention of a target.
+ *
+ * Implements the aggregate rules of SysV x86-64, AAPCS64 (including Apple
+ * arm64) and Windows x64, which is what clang emits for the same struct on
+ * those targets. Scalars are always direct; on other targets aggregates are
+ * left direct as well.
+ */
+class CAbi {
+  enum class Target { SysV, AArch64, Win64, Other };
+
+  Target target_;
+  const llvm::DataLayout& layout_;
+
+  /** @brief A scalar or vector leaf of an aggregate at a byte offset. */
+  struct Leaf {
+    uint64_t offset;
+    llvm::Type* type;
+  };
+
+  /** @brief Appends the scalar leaves of `type` placed at `offset`. */
+  void Flatten(llvm::Type* type, uint64_t offset, std::vector<Leaf>& leaves);
+
+  /**
+   * @brief Classifies an aggregate of at most 16 bytes into SysV eightbytes.
+   * @param ints Receives the number of integer registers it needs.
+   * @param sses Receives the number of vector registers it needs.
+   * @return The coerced register type, or null if it goes to memory.
+   */
+  llvm::Type* ClassifySysV(llvm::Type* type, unsigned& ints, unsigned& sses);
+  /** @brief Returns the element type of an AAPCS64 homogeneous aggregate. */
+  llvm::Type* HomogeneousBase(llvm::Type* type, unsigned& count);
+
+  /** @brief Classifies a SysV value, consuming the registers it takes. */
+  CAbiArg ClassifySysVArg(llvm::Type* type, bool is_return,
+                          unsigned& free_ints, unsigned& free_sses);
+  /** @brief Classifies an AAPCS64 argument or return value. */
+  CAbiArg ClassifyAArch64Arg(llvm::Type* type);
+  /** @brief Classifies a Windows x64 argument or return value. */
+  CAbiArg ClassifyWin64Arg(llvm::Type* type);
+
+ public:
+  CAbi(const llvm::Triple& triple, const llvm::DataLayout& layout);
+
+  /**
+   * @brief Classifies a C signature given its LLVM value types.
+   *
+   * Register use is tracked across parameters, so a SysV aggregate that no
+   * longer fits in the remaining registers is passed in memory as a whole.
+   */
+  CAbiSignature Classify(llvm::Type* ret,
+                         const std::vector<llvm::Type*>& params);
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define COMPILER_H_
 
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -52,6 +53,8 @@ struct Codegen : CodegenExprVisitor, StmtVisitor {
   BindingMap ir_bindings_; /**< Symbol-to-IR binding table. */
   std::unordered_map<std::string, llvm::StructType*> struct_types_;
   std::unordered_map<SymbolId, llvm::DILocalVariable*> di_locals_;
+  llvm::Value* return_slot_ = nullptr; /**< `sret` pointer of the function. */
+  std::string current_module_; /**< Module whose statements are lowered. */
   // std::unique_ptr<llvm::DIBuilder> di_builder_;
   // llvm::DICompileUnit* di_compile_unit_ = nullptr;
   // llvm::DIFile* di_file_ = nullptr;
@@ -88,6 +91,7 @@ struct Codegen : CodegenExprVisitor, StmtVisitor {
   llvm::Value* Visit(ForStmt& stmt) override;
   llvm::Value* Visit(WhileStmt& stmt) override;
   llvm::Value* Visit(IfStmt& stmt) override;
+  llvm::Value* Visit(MatchStmt& stmt) override;
   llvm::Value* Visit(ExpressionStmt& stmt) override;
   llvm::Value* Visit(FunctionStmt& stmt) override;
   llvm::Value* Visit(FunctionProto& stmt) override;
@@ -101,6 +105,9 @@ struct Codegen : CodegenExprVisitor, StmtVisitor {
   llvm::Value* Visit(Assign& expr) override;
   llvm::Value* Visit(MemberAssign& expr) override;
   llvm::Value* Visit(Conditional& expr) override;
+  llvm::Value* Visit(Logical& expr) override;
+  llvm::Value* Visit(Unary& expr) override;
+  llvm::Value* Visit(IfExpr& expr) override;
   llvm::Value* Visit(Binary& expr) override;
   llvm::Value* Visit(PreFixOp& expr) override;
   llvm::Value* Visit(CallExpr& expr) override;
@@ -108,6 +115,13 @@ struct Codegen : CodegenExprVisitor, StmtVisitor {
   llvm::Value* Visit(Grouping& expr) override;
   llvm::Value* Visit(Variable& expr) override;
   llvm::Value* Visit(Literal& expr) override;
+  llvm::Value* Visit(IndexAccess& expr) override;
+  llvm::Value* Visit(IndexAssign& expr) override;
+  llvm::Value* Visit(ArrayLiteral& expr) override;
+  llvm::Value* Visit(NewArray& expr) override;
+  llvm::Value* Visit(Cast& expr) override;
+  llvm::Value* Visit(IntrinsicCall& expr) override;
+  llvm::Value* Visit(SliceExpr& expr) override;
   ///@}
 
   /**
@@ -117,16 +131,230 @@ struct Codegen : CodegenExprVisitor, StmtVisitor {
    */
   bool SemanticPass(const std::vector<ModuleStmt*>& modules);
 
+  /**
+   * @brief Returns the PGO settings for the optimization pipeline.
+   * @return Instrumentation for `--profile-generate`, profile use for
+   * `--profile-use`, otherwise `std::nullopt`.
+   */
+  std::optional<llvm::PGOOptions> ProfileOptions() const;
+
   /** @brief Emits an integer constant literal value. */
   llvm::Value* EmitInteger(Literal& expr);
 
+  /** @brief Emits a value folded during semantic analysis as `type`. */
+  llvm::Constant* EmitConstant(const ConstValue& value,
+                               cinder::types::Type* type);
+
+  /**
+   * @brief Emits a module-level declaration as an internal global.
+   *
+   * `const` globals are marked constant and `unnamed_addr`, so lookup tables
+   * land in read-only data and identical ones may be merged.
+   *
+   * @param stmt Global declaration.
+   * @param mod Name of the declaring module, which prefixes the symbol.
+   */
+  void EmitGlobal(VarDeclarationStmt& stmt, const std::string& mod);
+
+  /**
+   * @brief Builds the static initializer of a global of `type`.
+   * @return The initializer, or null when `init` is not static data.
+   */
+  llvm::Constant* EmitStaticInitializer(Expr& init, cinder::types::Type* type);
+
+  /**
+   * @brief Applies C default argument promotions to a variadic argument.
+   * @param value Lowered argument value.
+   * @param type Semantic type of the argument expression.
+   * @return `value` widened to `double` or `int32` when required.
+   */
+  llvm::Value* PromoteVariadicArg(llvm::Value* value,
+                                  cinder::types::Type* type);
+
+  /** @brief Builds a `{ptr, i64}` slice value from its parts. */
+  llvm::Value* EmitSlice(llvm::Value* data, llvm::Value* length);
+
+  /** @brief Emits a `str` constant viewing the pooled copy of `text`. */
+  llvm::Constant* EmitStringLiteral(const std::string& text);
+
+  /** @brief Returns the binding of the function `callee` names, if any. */
+  FuncBinding* CalleeBinding(Expr& callee);
+
+  /**
+   * @brief Returns a NUL-terminated `char*` for the `str` value `text`.
+   *
+   * Literals and strings from C are already terminated, and so is any
+   * substring that ends where its parent does. Other substrings are copied
+   * to the heap; the copy, or null, is appended to `copies`.
+   */
+  llvm::Value* EmitCString(llvm::Value* text,
+                           std::vector<llvm::Value*>& copies);
+
+  /** @brief Frees the buffers `EmitCString` made for one call. */
+  void FreeCStrings(const std::vector<llvm::Value*>& copies);
+
+  /**
+   * @brief Declares the C runtime function `name` that generated code calls.
+   *
+   * Reports an error when an `extern` already declared it differently.
+   */
+  llvm::FunctionCallee RuntimeFunc(llvm::StringRef name,
+                                   llvm::FunctionType* type);
+
+  /** @brief Wraps a `char*` from C as a `str`, measuring it once. */
+  llvm::Value* EmitStringFromC(llvm::Value* ptr);
+
+  /** @brief Emits the `int32` element count of an array, slice or vector. */
+  llvm::Value* EmitLength(Expr& expr);
+
+  /**
+   * @brief Returns the storage address of an array-typed expression.
+   *
+   * Variables and indexed elements are addressed in place; other array
+   * values are spilled to a temporary stack slot.
+   */
+  llvm::Value* EmitArrayAddress(Expr& expr);
+
+  /**
+   * @brief Returns the address of a variable, struct field or element.
+   * @return The storage address, or null when `expr` names none.
+   */
+  llvm::Value* EmitAddress(Expr& expr);
+
+  /**
+   * @brief Returns a pointer to the value of `expr` for an argument passed
+   * in memory.
+   *
+   * With `byval` the callee makes its own copy, so addressable values are
+   * passed in place. Otherwise, and for values without an address, the
+   * argument is copied to a temporary.
+   */
+  llvm::Value* EmitIndirectArg(Expr& expr, cinder::types::Type* type,
+                               bool byval);
+
+  /**
+   * @brief Reinterprets the bytes of `value` as `type` through a stack slot.
+   *
+   * Used to move structs into and out of the register types the C ABI
+   * passes them in.
+   */
+  llvm::Value* EmitMemoryCoercion(llvm::Value* value, llvm::Type* type);
+
+  /**
+   * @brief Emits an inbounds GEP to the element selected by `expr`.
+   *
+   * An unchecked address skips the bounds check and drops `inbounds`, for
+   * uses such as prefetches that may legitimately point past the end.
+   */
+  llvm::Value* EmitElementPtr(IndexAccess& expr, bool checked = true);
+
+  /**
+   * @brief Emits the `i64` lane selected by a vector access.
+   *
+   * Checks the index against the lane count unless it is proven in range.
+   */
+  llvm::Value* EmitLaneIndex(IndexAccess& expr);
+
+  /**
+   * @brief Lowers a vector member: `len`, the horizontal `sum`, `min` and
+   * `max` of a numeric vector, or `any` and `all` of a mask.
+   */
+  llvm::Value* EmitReduction(MemberAccess& expr);
+
+  /** @brief Returns whether `expr` needs a check at the access itself. */
+  bool NeedsBoundsCheck(IndexAccess& expr);
+
+  /**
+   * @brief Branches to the bounds failure handler unless `in_range` holds.
+   * @param in_range `i1` condition that is true for valid accesses.
+   * @param index Offending `i64` index reported on failure.
+   * @param length `i64` length reported on failure.
+   * @param line Source line of the access.
+   */
+  void EmitBoundsCheck(llvm::Value* in_range, llvm::Value* index,
+                       llvm::Value* length, size_t line);
+
+  /**
+   * @brief Emits one range check covering every iteration of a counted loop.
+   *
+   * Runs after the loop initializer. For each hoisted access `x[i + e]` the
+   * first and last index, `start + e` and `bound - 1 + e`, must lie within
+   * `x`; the check is skipped when the loop runs zero times.
+   */
+  void EmitHoistedBoundsChecks(ForStmt& stmt);
+
+  /** @brief Returns the module's noreturn bounds failure handler. */
+  llvm::Function* BoundsFailHandler();
+
+  /**
+   * @brief Returns `branch_weights` metadata for a two-way branch whose
+   * condition carries `hint`, or null when there is no hint.
+   */
+  llvm::MDNode* BranchWeights(BranchHint hint);
+
+  /**
+   * @brief Lowers `value` for storage into a `target` slot.
+   * @return The value converted to `target`, or a slice view when an array is
+   * stored into a slice.
+   */
+  llvm::Value* EmitCoerced(Expr& value, cinder::types::Type* target);
+
+  /**
+   * @brief Converts a numeric `value` of type `from` to type `to`.
+   *
+   * Integers extend or truncate by the source signedness; conversions to and
+   * from floating point follow the signedness of the integer side. Vectors
+   * convert lane by lane, and a scalar converted to a vector is broadcast.
+   */
+  llvm::Value* EmitConversion(llvm::Value* value, cinder::types::Type* from,
+                              cinder::types::Type* to);
+
+  /**
+   * @brief Initializes a local array in place.
+   *
+   * Literals are stored element by element (zero filling any tail) and
+   * array copies become a `memcpy`, so large arrays never travel through
+   * first-class aggregate values.
+   */
+  void EmitArrayInit(llvm::AllocaInst* slot, cinder::types::ArrayType* type,
+                     Expr& init);
+
+  /** @brief Returns the LLVM `{ptr, i64}` type used for slices. */
+  llvm::StructType* SliceStructType();
+
   llvm::Type* ResolveType(cinder::types::Type* type, bool allow_void);
   /** @brief Maps semantic function-argument types to LLVM types. */
   llvm::Type* ResolveArgType(cinder::types::Type* type);
+  /**
+   * @brief Returns whether a by-value `type` is passed and returned in
+   * memory.
+   *
+   * Structs larger than two eightbytes travel as a `byval` pointer to a copy
+   * and come back through an `sret` slot the caller provides, instead of as
+   * first-class aggregates.
+   */
+  bool PassesIndirectly(cinder::types::Type* type);
+  /**
+   * @brief Decides how each value of a prototype is passed.
+   *
+   * `extern` functions follow the target's C ABI; cinder functions pass
+   * large structs in memory and everything else directly.
+   */
+  CAbiSignature LowerSignature(FunctionProto& stmt, llvm::Type* ret,
+                               const std::vector<llvm::Type*>& params);
+  /** @brief Maps types at an `extern` boundary, where `str` is `char*`. */
+  llvm::Type* ResolveCType(cinder::types::Type* type);
   /** @brief Maps semantic types to LLVM storage/value types. */
   llvm::Type* ResolveType(cinder::types::Type* type);
 
-  void InitAllTargets();
+  /**
+   * @brief Initializes the LLVM targets needed for `triple`.
+   *
+   * Only the native target is initialized for host compilation; every
+   * registered target is initialized when cross-compiling.
+   * @param triple Target triple requested for this compilation.
+   */
+  void InitTargets(const std::string& triple);
 };
 
 #endif
@@ -5,10 +5,12 @@
 #include <unordered_map>
 #include <vector>
 
+#include "cinder/codegen/c_abi.hpp"
 #include "cinder/semantic/symbol.hpp"
 #include "cinder/support/error_category.hpp"
 #include "llvm/IR/Argument.h"
 #include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/Type.h"
 #include "llvm/Support/ErrorOr.h"
@@ -51,19 +53,33 @@ struct Binding {
   }
 };
 
-/** @brief Binding for local/global variables represented by an alloca slot. */
+/**
+ * @brief Binding for variables stored in memory: a local alloca slot or a
+ * module-level global.
+ */
 struct VarBinding : Binding {
-  llvm::AllocaInst* alloca_ptr = nullptr; /**< Backing alloca instruction. */
+  llvm::Value* address = nullptr;   /**< Alloca, global or pointer argument. */
+  llvm::Type* value_type = nullptr; /**< Type of the value at `address`. */
   VarBinding() : Binding(BindType::Var) {}
 
+  /** @brief Returns the backing alloca, or null for a global. */
   llvm::AllocaInst* GetAlloca();
   void SetAlloca(llvm::AllocaInst* alloca);
+  void SetGlobal(llvm::GlobalVariable* global);
+  /** @brief Binds storage reached through a pointer, such as a reference. */
+  void SetAddress(llvm::Value* pointer, llvm::Type* type);
+  /** @brief Returns the storage address, whether local or global. */
+  llvm::Value* GetAddress();
+  /** @brief Returns the type loaded from and stored to `GetAddress()`. */
+  llvm::Type* GetValueType();
 };
 
 /** @brief Binding for function symbols represented by an LLVM function. */
 struct FuncBinding : Binding {
   llvm::Function* function = nullptr; /**< LLVM function handle. */
   std::vector<llvm::Argument*> args;  /**< Optional cached argument handles. */
+  bool is_extern = false; /**< C function; takes and returns `char*`. */
+  CAbiSignature abi;       /**< C lowering of an extern's aggregates. */
 
   FuncBinding() : Binding(BindType::Func) {}
 };
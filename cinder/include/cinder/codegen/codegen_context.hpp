@@ -2,6 +2,7 @@
 #define CODEGEN_CONTEXT_H_
 
 #include <memory>
+#include <optional>
 
 #include "cinder/ast/stmt/stmt.hpp"
 #include "cinder/ast/types.hpp"
@@ -9,6 +10,7 @@
 #include "cinder/codegen/debug_info_context.hpp"
 #include "cinder/frontend/tokens.hpp"
 #include "clang/AST/Type.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Analysis/CGSCCPassManager.h"
 #include "llvm/Analysis/LoopAnalysisManager.h"
@@ -27,6 +29,7 @@
 #include "llvm/IR/Verifier.h"
 #include "llvm/Linker/Linker.h"
 #include "llvm/MC/TargetRegistry.h"
+#include "llvm/Passes/PassBuilder.h"
 #include "llvm/Passes/StandardInstrumentations.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/TargetParser/Triple.h"
@@ -50,9 +53,9 @@ class CodegenContext {
   std::unique_ptr<llvm::PassInstrumentationCallbacks> ThePIC_;
   std::unique_ptr<llvm::StandardInstrumentations> TheSI_;
   BindingMap bindings; /**< Reserved binding storage for context-local use. */
-  llvm::Value* const_int;
-  llvm::Value* const_flt;
   DebugInfoContext debug_info_;
+  llvm::StringMap<llvm::GlobalVariable*>
+      strings_; /**< String literal pool, keyed by contents. */
 
  public:
   /**
@@ -73,19 +76,34 @@ class CodegenContext {
 
   llvm::Type* CreateTypeFromToken(cinder::Token& tok);
 
+  /**
+   * @brief Creates a stack slot.
+   *
+   * Fixed-size slots are hoisted to the function entry block so locals
+   * declared inside loops do not grow the stack and stay promotable by SROA.
+   */
   llvm::AllocaInst* CreateAlloca(llvm::Type* ty, llvm::Value* array_size,
                                  const llvm::Twine& name = "");
   llvm::StoreInst* CreateStore(llvm::Value* value, llvm::Value* ptr,
                                bool is_volatile = false);
 
+  /** @brief Emits an integer comparison, unsigned when `is_signed` is false. */
   llvm::Value* CreateIntCmp(cinder::Token::Type ty, llvm::Value* left,
-                            llvm::Value* right);
+                            llvm::Value* right, bool is_signed = true);
 
   llvm::Value* CreateFltCmp(cinder::Token::Type ty, llvm::Value* left,
                             llvm::Value* right);
 
+  /**
+   * @brief Emits an integer arithmetic instruction.
+   *
+   * Signed arithmetic carries `nsw`: overflow is undefined as in C, which
+   * lets induction variables be widened for 64-bit addressing. Division and
+   * remainder by a constant power of two become shifts and masks even at
+   * `-O0`, and shift amounts are taken modulo the operand width.
+   */
   llvm::Value* CreateIntBinop(cinder::Token::Type ty, llvm::Value* left,
-                              llvm::Value* right);
+                              llvm::Value* right, bool is_signed = true);
 
   llvm::Value* CreateFltBinop(cinder::Token::Type ty, llvm::Value* left,
                               llvm::Value* right);
@@ -94,7 +112,7 @@ class CodegenContext {
                           const llvm::Twine& name = "");
 
   llvm::Value* CreatePreOp(cinder::types::Type* ty, cinder::Token::Type op,
-                           llvm::Value* val, llvm::AllocaInst* alloca);
+                           llvm::Value* val, llvm::Value* ptr);
 
   llvm::BasicBlock* GetInsertBlock();
   llvm::Instruction* GetInsertBlockTerminator();
@@ -108,36 +126,90 @@ class CodegenContext {
 
   llvm::BranchInst* CreateBasicCondBr(llvm::Value* val,
                                       llvm::BasicBlock* true_block,
-                                      llvm::BasicBlock* false_block);
+                                      llvm::BasicBlock* false_block,
+                                      llvm::MDNode* weights = nullptr);
 
   llvm::FunctionType* GetFuncType(llvm::Type* res,
                                   llvm::ArrayRef<llvm::Type*> params,
                                   bool is_variadic);
 
+  /**
+   * @brief Declares an externally visible function.
+   *
+   * A runtime helper or another `extern` may already have declared the same
+   * C function. That declaration is reused when it has the same type.
+   * @return The function, or `nullptr` when an earlier declaration of `name`
+   * has a different type.
+   */
   llvm::Function* CreatePublicFunc(llvm::FunctionType* type,
                                    const llvm::Twine& name);
 
+  /**
+   * @brief Declares a function only cinder code calls.
+   *
+   * It is internal to the module and uses `fastcc`, which C callers could
+   * not follow. Callers qualify `name` with the cinder module, so it never
+   * takes a C symbol.
+   */
+  llvm::Function* CreateInternalFunc(llvm::FunctionType* type,
+                                     const llvm::Twine& name);
+
+  /**
+   * @brief Returns the pooled, NUL-terminated global holding `text`.
+   *
+   * Every occurrence of the same contents shares one private constant.
+   */
+  llvm::GlobalVariable* InternString(llvm::StringRef text);
+
   void SetInsertPoint(llvm::BasicBlock* block);
 
   llvm::ReturnInst* CreateVoidReturn();
 
   llvm::ReturnInst* CreateReturn(llvm::Value* val);
 
+  /** @name Calls use the calling convention of a known callee. */
+  ///@{
   llvm::CallInst* CreateVoidCall(llvm::FunctionCallee callee,
                                  llvm::ArrayRef<llvm::Value*> args = {});
 
   llvm::CallInst* CreateCall(llvm::FunctionCallee callee,
                              llvm::ArrayRef<llvm::Value*> args = {},
                              const llvm::Twine name = "");
+  ///@}
 
   void SetTargetTriple(llvm::Triple trip);
 
   const llvm::Target* LookupTarget();
 
   llvm::TargetMachine* CreateTargetMachine(const llvm::Target* target,
-                                           const std::string& trip);
+                                           const std::string& trip,
+                                           const std::string& cpu,
+                                           unsigned opt_level = 0);
 
   void SetModDataLayout(llvm::TargetMachine* tm);
+
+  /**
+   * @brief Marks every defined function `nounwind` and deduces memory
+   * effects, `willreturn` and `norecurse` over the call graph.
+   *
+   * Runs ahead of the pipeline at every optimization level, so the first
+   * simplification passes already see calls with known effects.
+   */
+  void InferAttributes();
+
+  /**
+   * @brief Infers function attributes, then runs the default
+   * new-pass-manager pipeline over the module.
+   *
+   * Passes report through the context's instrumentation callbacks, so they
+   * show up in `--time-trace` output.
+   *
+   * @param tm Target machine used for target-aware analyses.
+   * @param opt_level Optimization level, 0 through 3.
+   * @param pgo Profile instrumentation or profile use, if requested.
+   */
+  void Optimize(llvm::TargetMachine* tm, unsigned opt_level,
+                std::optional<llvm::PGOOptions> pgo = std::nullopt);
 };
 
 #endif
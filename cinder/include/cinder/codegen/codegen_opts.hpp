@@ -16,10 +16,22 @@ struct CodegenOpts {
     RUN,
     COMPILE,
   };
+  /** @brief Bounds checking applied to element accesses. */
+  enum class BoundsChecks {
+    ON,    /**< Check every access not proven in range. */
+    OFF,   /**< Emit no checks. */
+    HOIST, /**< Also replace loop-affine checks with one check per loop. */
+  };
   std::string out_path; /**< Destination path for emitted artifact. */
   Opt mode;             /**< Requested backend mode. */
   std::vector<std::string> linker_flags; /**< Additional linker flags. */
   bool debug_info; /**< Enables debug info generation (planned). */
+  std::string target_triple; /**< Target triple; empty selects the host. */
+  std::string cpu; /**< Target CPU; empty is generic, `native` the host's. */
+  unsigned opt_level = 0;    /**< Optimization level, 0 through 3. */
+  BoundsChecks bounds_checks = BoundsChecks::ON; /**< Bounds check mode. */
+  bool profile_generate = false; /**< Instruments the program for PGO. */
+  std::string profile_use; /**< Merged `.profdata` to optimize with. */
 
   /**
    * @brief Constructs codegen options.
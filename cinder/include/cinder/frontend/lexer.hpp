@@ -144,7 +144,12 @@ class Lexer {
   /** @brief Scans an identifier or reserved keyword token. */
   void TokenizeIdentifier();
 
-  /** @brief Scans an integer or floating-point literal token. */
+  /**
+   * @brief Scans an integer or floating-point literal token.
+   *
+   * An optional suffix (`i8`..`i64`, `u8`..`u64`, `f32`, `f64`) fixes the
+   * literal's type; the value must be representable in it.
+   */
   void TokenizeNumber();
 
   /** @brief Scans either `.` or `...` tokens. */
@@ -31,7 +31,7 @@ struct Parser {
   /** @brief Parses the top-level module declaration and contents. */
   std::unique_ptr<Stmt> ParseModule();
 
-  /** @brief Parses a function prototype signature. */
+  /** @brief Parses a function prototype signature and its annotations. */
   std::unique_ptr<Stmt> FunctionPrototype(bool is_extern = false);
 
   /** @brief Parses either an extern prototype or a full function definition. */
@@ -55,15 +55,31 @@ struct Parser {
   /** @brief Parses an `if` statement with optional `else` branch. */
   std::unique_ptr<Stmt> IfStatement();
 
+  /** @brief Parses a `match` statement with its `case` and `else` arms. */
+  std::unique_ptr<Stmt> MatchStatement();
+
+  /** @brief Consumes an optional `likely` or `unlikely` before a condition. */
+  BranchHint ParseBranchHint();
+
   /** @brief Parses a `return` statement. */
   std::unique_ptr<Stmt> ReturnStatement();
 
   /** @brief Parses a variable declaration statement. */
   std::unique_ptr<Stmt> VarDeclaration(cinder::Token type_token);
 
-  /** @brief Parses a primitive or qualified type token. */
+  /**
+   * @brief Parses a type token, including any array suffixes.
+   *
+   * Array suffixes are folded into the lexeme the same way qualified names
+   * are, so `int32[4][]` yields an `INT32_SPECIFIER` token spelled
+   * `int32[4][]`. A leading `ref` or `ptr` is kept as a prefix of the
+   * lexeme (`ref int32[4]`). Semantic analysis decodes both.
+   */
   cinder::Token ParseTypeToken(const std::string& context);
 
+  /** @brief Parses a primitive or qualified type token without suffixes. */
+  cinder::Token ParseBaseTypeToken(const std::string& context);
+
   /** @brief Checks if current position starts a type declaration. */
   bool IsTypeDeclarationStart();
 
@@ -79,24 +95,60 @@ struct Parser {
   /** @brief Parses assignment expressions. */
   std::unique_ptr<Expr> Assignment();
 
+  /** @brief Parses conditional expressions (`a if cond else b`). */
+  std::unique_ptr<Expr> IfExpression();
+
+  /** @brief Parses `||` expressions. */
+  std::unique_ptr<Expr> LogicalOr();
+
+  /** @brief Parses `&&` expressions. */
+  std::unique_ptr<Expr> LogicalAnd();
+
   /** @brief Parses comparison expressions. */
   std::unique_ptr<Expr> Comparison();
 
+  /** @brief Parses `|` expressions. */
+  std::unique_ptr<Expr> BitwiseOr();
+
+  /** @brief Parses `^` expressions. */
+  std::unique_ptr<Expr> BitwiseXor();
+
+  /** @brief Parses `&` expressions. */
+  std::unique_ptr<Expr> BitwiseAnd();
+
+  /** @brief Parses shift (`<<`, `>>`) expressions. */
+  std::unique_ptr<Expr> Shift();
+
   /** @brief Parses additive (`+`, `-`) expressions. */
   std::unique_ptr<Expr> Term();
 
-  /** @brief Parses multiplicative (`*`, `/`) expressions. */
+  /** @brief Parses multiplicative (`*`, `/`, `%`) expressions. */
   std::unique_ptr<Expr> Factor();
 
+  /** @brief Parses prefix operators on values (`!x`, `~x`). */
+  std::unique_ptr<Expr> UnaryExpression();
+
   /** @brief Parses prefix increment/decrement expressions. */
   std::unique_ptr<Expr> PreIncrement();
 
-  /** @brief Parses call expressions. */
+  /** @brief Parses call, member access and index expressions. */
   std::unique_ptr<Expr> Call();
 
   /** @brief Parses expression atoms (literals, identifiers, groupings). */
   std::unique_ptr<Expr> Atom();
 
+  /** @brief Parses an array literal after its opening `[`. */
+  std::unique_ptr<Expr> ArrayLiteralExpression();
+
+  /** @brief Parses a heap slice allocation after the `new` keyword. */
+  std::unique_ptr<Expr> NewArrayExpression();
+
+  /** @brief Parses an intrinsic call after the `@` sigil. */
+  std::unique_ptr<Expr> IntrinsicExpression();
+
+  /** @brief Parses a conversion such as `int64(x)` or `flt32x4(x)`. */
+  std::unique_ptr<Expr> ConversionExpression();
+
   /**
    * @brief Tests current token against any type in `types`.
    *
@@ -1,11 +1,13 @@
 #ifndef TOKENS_H
 #define TOKENS_H
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <variant>
 
 #include "cinder/ast/types.hpp"
+#include "cinder/semantic/symbol.hpp"
 
 namespace cinder {
 
@@ -16,8 +18,14 @@ struct SourceLocation {
   size_t column = 1;
 };
 
-/** @brief Literal payload type used by lexical tokens and literal AST nodes. */
-using TokenValue = std::variant<std::string, int, float, bool>;
+/**
+ * @brief Literal payload type used by lexical tokens and literal AST nodes.
+ *
+ * Integer literals hold their 64-bit pattern; a literal above `INT64_MAX` is
+ * stored wrapped and reads back as `uint64`. Floating-point literals are held
+ * in double precision whatever their eventual type.
+ */
+using TokenValue = std::variant<std::string, int64_t, double, bool>;
 
 /**
  * @brief Represents a lexical token produced by the lexer.
@@ -43,9 +51,21 @@ struct Token {
     LESSER,
     GREATER_EQ,
     LESSER_EQ,
+    AMPAMP,          /** "&&" */
+    PIPEPIPE,        /** "||" */
+    AMP,             /** "&" */
+    PIPE,            /** "|" */
+    CARET,           /** "^" */
+    TILDE,           /** "~" */
+    LESSER_LESSER,   /** "<<" */
+    GREATER_GREATER, /** ">>" */
 
     ARROW, /** "->" */
     EXTERN,
+    PURE,  /** `extern pure`: reads but does not write memory */
+    CONST, /** Compile-time constant declaration */
+    REF,   /** Non-null reference type prefix */
+    PTR,   /** Nullable pointer type prefix */
 
     // Control flow
     IF,     /** If statement */
@@ -53,6 +73,10 @@ struct Token {
     ELSE,   /** Else branch */
     FOR,    /** For loop */
     WHILE,
+    MATCH,    /** Multi-way branch on an integer */
+    CASE,     /** Arm of a match statement */
+    LIKELY,   /** Branch hint: the condition is usually true */
+    UNLIKELY, /** Branch hint: the condition is usually false */
     TRUE,
     FALSE,
     RETURN,
@@ -69,16 +93,30 @@ struct Token {
     COMMA, /**< "," */
     ELLIPSIS,
     DOT,
+    AT, /**< "@" */
     // Key words and identifiers
     IDENTIFER, /** Any series of characters */
     DEF,       /** "def" keyword */
     END,       /** "end" keyword */
+    NEW,       /** "new" keyword */
     // Types
     BOOL_SPECIFIER,
+    INT8_SPECIFIER,
+    INT16_SPECIFIER,
     INT32_SPECIFIER,
     INT64_SPECIFIER,
+    UINT8_SPECIFIER,
+    UINT16_SPECIFIER,
+    UINT32_SPECIFIER,
+    UINT64_SPECIFIER,
     FLT32_SPECIFIER,
     FLT64_SPECIFIER,
+    FLT32X4_SPECIFIER,
+    FLT32X8_SPECIFIER,
+    INT32X4_SPECIFIER,
+    INT32X8_SPECIFIER,
+    BOOLX4_SPECIFIER,
+    BOOLX8_SPECIFIER,
     STR_SPECIFIER,
     VOID_SPECIFIER,
     STRUCT_SPECIFIER,
@@ -98,6 +136,7 @@ struct Token {
   SourceLocation location;           /**< Source position of the token. */
   std::string lexeme;                /**< Source spelling for the token. */
   std::optional<TokenValue> literal; /**< Parsed literal value, if present. */
+  std::optional<Type> suffix; /**< Type named by a numeric suffix (`i64`). */
 
   Token() = default;
   /**
@@ -114,8 +153,12 @@ struct Token {
   bool IsLiteral();
   /** @brief Returns whether this token is an integer type specifier. */
   bool IsInt();
+  /** @brief Returns whether this token is an unsigned integer specifier. */
+  bool IsUnsigned();
   /** @brief Returns whether this token is a floating-point type specifier. */
   bool IsFloat();
+  /** @brief Returns whether this token is a SIMD vector or mask specifier. */
+  bool IsVector();
   /** @brief Returns whether this token is a string type specifier. */
   bool IsString();
   /** @brief Returns whether this token is a void type specifier. */
@@ -131,9 +174,10 @@ struct Token {
   /** @brief Returns whether this token is a term-level operator (`+` or `-`).
    */
   bool IsTerm();
-  /** @brief Returns whether this token is a factor-level operator (`*` or `/`).
-   */
+  /** @brief Returns whether this token is a factor-level operator (`* / %`). */
   bool IsFactor();
+  /** @brief Returns whether this token is a shift operator (`<<` or `>>`). */
+  bool IsShift();
   /** @brief Returns whether this token is a comparison operator. */
   bool IsComparison();
   /** @brief Returns whether this token exactly matches `type`. */
@@ -148,6 +192,8 @@ struct FuncArg {
   Token identifier; /**< Argument identifier token. */
   cinder::types::Type*
       resolved_type; /**< Resolved semantic type (if analyzed). */
+  std::optional<SymbolId> id; /**< Parameter symbol id (if analyzed). */
+  bool no_alias = false; /**< Reference proven unaliased during the call. */
 
   /**
    * @brief Constructs an unresolved function argument record.
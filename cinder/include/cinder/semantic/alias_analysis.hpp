@@ -0,0 +1,99 @@
+#ifndef ALIAS_ANALYSIS_H_
+#define ALIAS_ANALYSIS_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "cinder/ast/expr/expr.hpp"
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/semantic/symbol.hpp"
+
+/**
+ * @brief Proves `ref` parameters free of aliasing for the length of a call.
+ *
+ * Runs over analyzed modules and sets `FuncArg::no_alias` on each `ref`
+ * parameter whose storage no other pointer can touch while the function
+ * runs. Every access in a body is attributed to the storage it reaches:
+ * one of the `ref` parameters, the function's own locals, or shared storage,
+ * which covers globals, slice elements, `ptr` parameters and whatever a call
+ * may reach. A parameter qualifies when either nothing is written, or it is
+ * the only non-local storage the body touches.
+ */
+class AliasAnalysis : SemanticExprVisitor, SemanticStmtVisitor {
+  static constexpr int kLocal = -1;  /**< Storage private to the function. */
+  static constexpr int kShared = -2; /**< Storage others may also reach. */
+
+  /** @brief Reads and writes seen for one kind of storage. */
+  struct Access {
+    bool read = false;
+    bool written = false;
+  };
+
+  std::unordered_map<SymbolId, int> roots_; /**< Storage each name reaches. */
+  std::vector<Access> params_;              /**< Accesses per `ref` param. */
+  Access shared_;                           /**< Accesses to shared storage. */
+
+  using SemanticExprVisitor::Visit;
+  using SemanticStmtVisitor::Visit;
+
+  /** @name Statement visitor overrides */
+  ///@{
+  void Visit(ModuleStmt& stmt) override;
+  void Visit(ImportStmt& stmt) override;
+  void Visit(ForStmt& stmt) override;
+  void Visit(WhileStmt& stmt) override;
+  void Visit(IfStmt& stmt) override;
+  void Visit(MatchStmt& stmt) override;
+  void Visit(ExpressionStmt& stmt) override;
+  void Visit(FunctionStmt& stmt) override;
+  void Visit(FunctionProto& stmt) override;
+  void Visit(ReturnStmt& stmt) override;
+  void Visit(VarDeclarationStmt& stmt) override;
+  void Visit(StructStmt& stmt) override;
+  ///@}
+
+  /** @name Expression visitor overrides */
+  ///@{
+  void Visit(Variable& expr) override;
+  void Visit(MemberAccess& expr) override;
+  void Visit(Binary& expr) override;
+  void Visit(Assign& expr) override;
+  void Visit(MemberAssign& expr) override;
+  void Visit(Grouping& expr) override;
+  void Visit(Conditional& expr) override;
+  void Visit(Logical& expr) override;
+  void Visit(Unary& expr) override;
+  void Visit(IfExpr& expr) override;
+  void Visit(PreFixOp& expr) override;
+  void Visit(CallExpr& expr) override;
+  void Visit(Literal& expr) override;
+  void Visit(IndexAccess& expr) override;
+  void Visit(IndexAssign& expr) override;
+  void Visit(ArrayLiteral& expr) override;
+  void Visit(NewArray& expr) override;
+  void Visit(Cast& expr) override;
+  void Visit(IntrinsicCall& expr) override;
+  void Visit(SliceExpr& expr) override;
+  ///@}
+
+  /** @brief Dispatches on a statement node, if present. */
+  void Analyze(Stmt* stmt);
+  /** @brief Dispatches on an expression node, if present. */
+  void Analyze(Expr* expr);
+
+  /** @brief Returns the storage the symbol `id` names. */
+  int RootOf(SymbolId id);
+  /** @brief Returns the storage a variable, field or element lives in. */
+  int RootOf(Expr* expr);
+  /** @brief Records an access to `root`. */
+  void Touch(int root, bool write);
+
+ public:
+  /**
+   * @brief Annotates parameters across a dependency-ordered module set.
+   * @param modules Analyzed module nodes.
+   */
+  void Run(const std::vector<ModuleStmt*>& modules);
+};
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef BOUNDS_CHECK_H_
+#define BOUNDS_CHECK_H_
+
+#include <unordered_set>
+#include <vector>
+
+#include "cinder/ast/expr/expr.hpp"
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/semantic/symbol.hpp"
+
+/**
+ * @brief Classifies element accesses by the bounds checking they need.
+ *
+ * Runs over analyzed modules and annotates every `IndexAccess` with a
+ * `BoundsCheck` kind. Counted loops of the form
+ * `for T: i = lo; i < bound; ++i` provide the facts:
+ *
+ * - An access `x[i]` is `Proven` when `lo` is a non-negative constant and
+ *   `bound` is `x.len`, or a constant no larger than the fixed length of `x`
+ *   (an array or vector).
+ * - An access `x[i]` or `x[i + e]` directly in the body of the innermost
+ *   counted loop, with `x` and `e` loop-invariant, is `Hoisted`: codegen can
+ *   cover every iteration with one range check ahead of the loop.
+ * - Everything else stays `Required`.
+ *
+ * References are never loop-invariant, and a loop that assigns through one
+ * gets no facts at all, since it may change any variable.
+ */
+class BoundsCheckAnalysis : SemanticExprVisitor, SemanticStmtVisitor {
+  /** @brief Facts about one enclosing loop. */
+  struct LoopFacts {
+    ForStmt* stmt = nullptr;   /**< Counted loop, or null for other loops. */
+    SymbolId induction = 0;    /**< Induction variable symbol. */
+    bool non_negative = false; /**< Whether the start is a constant >= 0. */
+    bool has_return = false;   /**< Whether the body may exit the function. */
+    unsigned branch_depth = 0; /**< Nesting of `if` inside this body. */
+    std::unordered_set<SymbolId> written; /**< Symbols set in the body. */
+  };
+  std::vector<LoopFacts> loops_; /**< Enclosing loops, innermost last. */
+  /** Mutable globals; any call in a loop body may write them. */
+  std::unordered_set<SymbolId> globals_;
+  /** References in the current function; writes elsewhere may reach them. */
+  std::unordered_set<SymbolId> references_;
+
+  using SemanticExprVisitor::Visit;
+  using SemanticStmtVisitor::Visit;
+
+  /** @name Statement visitor overrides */
+  ///@{
+  void Visit(ModuleStmt& stmt) override;
+  void Visit(ImportStmt& stmt) override;
+  void Visit(ForStmt& stmt) override;
+  void Visit(WhileStmt& stmt) override;
+  void Visit(IfStmt& stmt) override;
+  void Visit(MatchStmt& stmt) override;
+  void Visit(ExpressionStmt& stmt) override;
+  void Visit(FunctionStmt& stmt) override;
+  void Visit(FunctionProto& stmt) override;
+  void Visit(ReturnStmt& stmt) override;
+  void Visit(VarDeclarationStmt& stmt) override;
+  void Visit(StructStmt& stmt) override;
+  ///@}
+
+  /** @name Expression visitor overrides */
+  ///@{
+  void Visit(Variable& expr) override;
+  void Visit(MemberAccess& expr) override;
+  void Visit(Binary& expr) override;
+  void Visit(Assign& expr) override;
+  void Visit(MemberAssign& expr) override;
+  void Visit(Grouping& expr) override;
+  void Visit(Conditional& expr) override;
+  void Visit(Logical& expr) override;
+  void Visit(Unary& expr) override;
+  void Visit(IfExpr& expr) override;
+  void Visit(PreFixOp& expr) override;
+  void Visit(CallExpr& expr) override;
+  void Visit(Literal& expr) override;
+  void Visit(IndexAccess& expr) override;
+  void Visit(IndexAssign& expr) override;
+  void Visit(ArrayLiteral& expr) override;
+  void Visit(NewArray& expr) override;
+  void Visit(Cast& expr) override;
+  void Visit(IntrinsicCall& expr) override;
+  void Visit(SliceExpr& expr) override;
+  ///@}
+
+  /** @brief Dispatches on a statement node, if present. */
+  void Analyze(Stmt* stmt);
+  /** @brief Dispatches on an expression node, if present. */
+  void Analyze(Expr* expr);
+
+  /**
+   * @brief Builds the facts for `stmt` when it is a counted loop.
+   * @return Facts with a null `stmt` when the loop shape is not recognized.
+   */
+  LoopFacts CountedLoopFacts(ForStmt& stmt);
+  /**
+   * @brief Returns whether `expr` is side-effect free and reads nothing in
+   * `written` or any mutable global.
+   */
+  bool IsInvariant(Expr* expr, const LoopFacts& loop);
+  /** @brief Returns whether `loop` proves `expr` in range. */
+  bool IsProven(IndexAccess& expr, const LoopFacts& loop);
+  /** @brief Records `expr` on the innermost loop when it can be hoisted. */
+  bool TryHoist(IndexAccess& expr);
+
+ public:
+  /**
+   * @brief Annotates accesses across a dependency-ordered module set.
+   * @param modules Analyzed module nodes.
+   */
+  void Run(const std::vector<ModuleStmt*>& modules);
+};
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef CONST_EVALUATOR_H_
+#define CONST_EVALUATOR_H_
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "cinder/ast/expr/expr.hpp"
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/semantic/symbol.hpp"
+#include "cinder/support/diagnostic.hpp"
+
+/**
+ * @brief Folds compile-time constant expressions.
+ *
+ * Runs over analyzed modules and records in `Expr::constant` the value of
+ * every scalar expression built from literals, `const` variables,
+ * arithmetic, comparisons, conversions, and calls whose arguments are all
+ * constant and whose callee is pure. Codegen emits folded expressions as
+ * LLVM constants. Module-level declarations must have static initializers,
+ * which are folded before any function body.
+ *
+ * A pure function is one the evaluator can interpret: its body only
+ * declares, assigns and returns scalars, branches and loops over them, and
+ * calls other pure functions. Integer arithmetic wraps to its type. Signed
+ * overflow, division by zero and out-of-range conversions are left to
+ * runtime, as is any call that runs out of the step budget.
+ */
+class ConstEvaluator : SemanticExprVisitor, SemanticStmtVisitor {
+  /** @brief Locals of one interpreted call. */
+  using Frame = std::unordered_map<SymbolId, ConstValue>;
+
+  /** @brief How an interpreted statement finished. */
+  enum class Flow { Next, Return, Abort };
+
+  DiagnosticEngine& diagnose_; /**< Receives non-constant `const` errors. */
+  std::unordered_map<SymbolId, FunctionStmt*>
+      functions_; /**< Function bodies by symbol. */
+  std::unordered_map<SymbolId, ConstValue>
+      consts_;       /**< Values of `const` variables. */
+  size_t steps_ = 0; /**< Interpreter steps left for the current fold. */
+  size_t depth_ = 0; /**< Nesting of interpreted calls. */
+
+  using SemanticExprVisitor::Visit;
+  using SemanticStmtVisitor::Visit;
+
+  /** @name Statement visitor overrides */
+  ///@{
+  void Visit(ModuleStmt& stmt) override;
+  void Visit(ImportStmt& stmt) override;
+  void Visit(ForStmt& stmt) override;
+  void Visit(WhileStmt& stmt) override;
+  void Visit(IfStmt& stmt) override;
+  void Visit(MatchStmt& stmt) override;
+  void Visit(ExpressionStmt& stmt) override;
+  void Visit(FunctionStmt& stmt) override;
+  void Visit(FunctionProto& stmt) override;
+  void Visit(ReturnStmt& stmt) override;
+  void Visit(VarDeclarationStmt& stmt) override;
+  void Visit(StructStmt& stmt) override;
+  ///@}
+
+  /** @name Expression visitor overrides */
+  ///@{
+  void Visit(Variable& expr) override;
+  void Visit(MemberAccess& expr) override;
+  void Visit(Binary& expr) override;
+  void Visit(Assign& expr) override;
+  void Visit(MemberAssign& expr) override;
+  void Visit(Grouping& expr) override;
+  void Visit(Conditional& expr) override;
+  void Visit(Logical& expr) override;
+  void Visit(Unary& expr) override;
+  void Visit(IfExpr& expr) override;
+  void Visit(PreFixOp& expr) override;
+  void Visit(CallExpr& expr) override;
+  void Visit(Literal& expr) override;
+  void Visit(IndexAccess& expr) override;
+  void Visit(IndexAssign& expr) override;
+  void Visit(ArrayLiteral& expr) override;
+  void Visit(NewArray& expr) override;
+  void Visit(Cast& expr) override;
+  void Visit(IntrinsicCall& expr) override;
+  void Visit(SliceExpr& expr) override;
+  ///@}
+
+  /** @brief Dispatches on a statement node, if present. */
+  void Fold(Stmt* stmt);
+  /** @brief Dispatches on an expression node, if present. */
+  void Fold(Expr* expr);
+  /** @brief Records `expr`'s value; its operands must already be folded. */
+  void Record(Expr& expr);
+
+  /**
+   * @brief Computes the value of `expr`.
+   * @param expr Analyzed expression.
+   * @param frame Locals of the call being interpreted, or null outside one.
+   * @return The value, or `std::nullopt` when it is not a constant.
+   */
+  std::optional<ConstValue> Evaluate(Expr& expr, Frame* frame);
+  /** @brief Evaluates `expr` and converts it to `type`. */
+  std::optional<ConstValue> EvaluateAs(Expr& expr, cinder::types::Type* type,
+                                       Frame* frame);
+  /** @brief Interprets `expr` when its callee is a pure function. */
+  std::optional<ConstValue> Call(CallExpr& expr, Frame* frame);
+  /**
+   * @brief Interprets one statement of a pure function body.
+   * @param result Receives the returned value on `Flow::Return`.
+   */
+  Flow Execute(Stmt& stmt, Frame& frame, std::optional<ConstValue>& result);
+  /** @brief Interprets statements in order until one does not continue. */
+  Flow ExecuteBlock(std::vector<std::unique_ptr<Stmt>>& body, Frame& frame,
+                    std::optional<ConstValue>& result);
+
+ public:
+  /** @param diagnose Diagnostics shared with semantic analysis. */
+  explicit ConstEvaluator(DiagnosticEngine& diagnose);
+
+  /**
+   * @brief Folds constants across a dependency-ordered module set.
+   * @param modules Analyzed module nodes.
+   */
+  void Run(const std::vector<ModuleStmt*>& modules);
+};
+
+#endif
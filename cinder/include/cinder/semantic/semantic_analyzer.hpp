@@ -4,6 +4,7 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "cinder/ast/expr/expr.hpp"
@@ -25,6 +26,13 @@ class SemanticAnalyzer : SemanticExprVisitor, SemanticStmtVisitor {
   ResolvedSymbols symbols_;            /**< Table of resolved symbols. */
   Environment env_;                    /**< Lexical scope stack. */
   cinder::types::Type* current_return; /**< Active function return type. */
+  cinder::types::FunctionType* current_function_ =
+      nullptr; /**< Signature of the function being analyzed. */
+  std::unordered_set<SymbolId> extern_functions_; /**< Declared `extern`. */
+  std::unordered_set<SymbolId> exported_functions_; /**< Called from C. */
+  bool current_exported_ = false; /**< Current function is called from C. */
+  std::unordered_set<SymbolId> frame_params_; /**< By-value parameters. */
+  std::unordered_set<SymbolId> frame_locals_; /**< Local variables. */
   DiagnosticEngine diagnose_;          /**< Collected diagnostics. */
   std::string current_mod_;
   using ImportedMods = std::vector<std::string>;
@@ -42,6 +50,7 @@ class SemanticAnalyzer : SemanticExprVisitor, SemanticStmtVisitor {
   void Visit(ForStmt& stmt) override;
   void Visit(WhileStmt& stmt) override;
   void Visit(IfStmt& stmt) override;
+  void Visit(MatchStmt& stmt) override;
   void Visit(ExpressionStmt& stmt) override;
   void Visit(FunctionStmt& stmt) override;
   void Visit(FunctionProto& stmt) override;
@@ -59,15 +68,111 @@ class SemanticAnalyzer : SemanticExprVisitor, SemanticStmtVisitor {
   void Visit(MemberAssign& expr) override;
   void Visit(Grouping& expr) override;
   void Visit(Conditional& expr) override;
+  void Visit(Logical& expr) override;
+  void Visit(Unary& expr) override;
+  void Visit(IfExpr& expr) override;
   void Visit(PreFixOp& expr) override;
   void Visit(CallExpr& expr) override;
   void Visit(Literal& expr) override;
+  void Visit(IndexAccess& expr) override;
+  void Visit(IndexAssign& expr) override;
+  void Visit(ArrayLiteral& expr) override;
+  void Visit(NewArray& expr) override;
+  void Visit(Cast& expr) override;
+  void Visit(IntrinsicCall& expr) override;
+  void Visit(SliceExpr& expr) override;
   ///@}
 
   /** @brief Resolves a function-argument type token. */
   cinder::types::Type* ResolveArgType(cinder::Token type);
+  /**
+   * @brief Checks that a `return tail` call may reuse the caller's frame.
+   *
+   * The callee must be a cinder function with exactly the caller's
+   * signature, and no argument may point into the caller's frame, which is
+   * gone by the time the callee runs.
+   */
+  void CheckTailCall(ReturnStmt& stmt);
+  /** @brief Returns whether the storage `lvalue` names may be in the frame. */
+  bool MayAddressFrame(Expr& lvalue);
+  /** @brief Returns whether a pointer-holding `value` may view the frame. */
+  bool MayViewFrame(Expr& value);
   /** @brief Resolves a general declared type token. */
   cinder::types::Type* ResolveType(cinder::Token type);
+  /** @brief Resolves a type token spelled `ref T` or `ptr T`. */
+  cinder::types::Type* ResolveReferenceType(cinder::Token type);
+  /**
+   * @brief Returns the constant whose storage `value` names, if any.
+   *
+   * Walks struct fields and array elements down to the owning variable.
+   * Slice elements live on the heap, so they have no owner.
+   */
+  SymbolInfo* ConstantOwner(Expr& value);
+  /**
+   * @brief Checks that a `target` reference may bind to `value`.
+   *
+   * `value` must name storage of exactly the referenced type: a variable, a
+   * struct field of one, or an array or slice element. Constants and vector
+   * lanes cannot be referenced.
+   */
+  bool CheckReferenceBinding(cinder::types::ReferenceType* target, Expr& value,
+                             SourceLoc loc);
+  /** @brief Resolves a type token carrying `[N]`/`[]` suffixes. */
+  cinder::types::Type* ResolveArrayType(cinder::Token type);
+  /** @brief Maps an integer specifier kind to its type, or `nullptr`. */
+  cinder::types::IntType* ResolveIntType(cinder::Token::Type kind);
+  /** @brief Maps a vector or mask specifier kind to its type, or `nullptr`. */
+  cinder::types::VectorType* ResolveVectorType(cinder::Token::Type kind);
+  /**
+   * @brief Returns the result type of comparing two `operand` values.
+   * @return `bool`, or the mask with one lane per vector lane.
+   */
+  cinder::types::Type* ComparisonType(cinder::types::Type* operand);
+  /** @brief Maps a numeric literal suffix kind to its type. */
+  cinder::types::Type* ResolveNumericSuffix(cinder::Token::Type kind);
+
+  /**
+   * @brief Retypes an unsuffixed numeric literal to `target` when it fits.
+   *
+   * Unsuffixed integer literals start out as the narrowest of `int32`,
+   * `int64` and `uint64` that holds them, and floating-point ones as
+   * `flt64`; both take the type their context expects, as does arithmetic
+   * on floating-point literals alone. Suffixed literals keep the type they
+   * name.
+   *
+   * @return Whether `value` is an unsuffixed literal representable in
+   * `target`.
+   */
+  bool AdaptLiteral(cinder::types::Type* target, Expr& value);
+
+  /**
+   * @brief Checks whether `value` converts implicitly to `target`.
+   *
+   * Accepts exact matches, literals that fit `target` and lossless
+   * widening.
+   */
+  bool IsConvertible(cinder::types::Type* target, Expr& value);
+
+  /**
+   * @brief Computes the type both operands of a binary operator convert to.
+   * @return Common type, or `nullptr` when neither side converts.
+   */
+  cinder::types::Type* CommonType(Expr& left, Expr& right);
+
+  /**
+   * @brief Checks whether `value` may be stored into a `target` slot.
+   *
+   * Besides `IsConvertible` values, an addressable array converts to a slice
+   * of the same element type. In declarations an array literal may also be
+   * shorter than the declared array; the remaining elements are zeroed, and
+   * its elements convert to the declared element type.
+   *
+   * @param target Declared or expected type.
+   * @param value Analyzed source expression.
+   * @param is_declaration Whether this initializes a new variable.
+   */
+  bool IsAssignable(cinder::types::Type* target, Expr& value,
+                    bool is_declaration = false);
 
   /** @brief Dispatches semantic analysis on a statement node. */
   void Resolve(Stmt& stmt);
@@ -96,12 +201,6 @@ class SemanticAnalyzer : SemanticExprVisitor, SemanticStmtVisitor {
   std::optional<SymbolId> Declare(std::string name, cinder::types::Type* type,
                                   bool is_function = false, SourceLoc loc = {});
 
-  /**
-   * @brief Applies default promotions for variadic call arguments.
-   * @param expr Argument expression to potentially promote.
-   */
-  void VariadicPromotion(Expr* expr);
-
  public:
   /**
    * @brief Constructs the semantic analyzer.
@@ -129,6 +228,9 @@ class SemanticAnalyzer : SemanticExprVisitor, SemanticStmtVisitor {
 
   /** @brief Emits debug diagnostics for the resolved symbol table. */
   void DebugSymbols();
+
+  /** @brief Returns the number of symbols resolved so far. */
+  size_t SymbolCount() const;
 };
 
 #endif
@@ -15,6 +15,7 @@ struct SymbolInfo {
   std::string name;          /**< Source-level symbol name. */
   cinder::types::Type* type; /**< Resolved symbol type. */
   bool is_function = false;  /**< True when symbol denotes a function. */
+  bool is_const = false;     /**< True when declared with `const`. */
 };
 
 /** @brief Symbol table storing all resolved symbols in declaration order. */
@@ -36,6 +37,8 @@ class ResolvedSymbols {
   const SymbolInfo* GetSymbolInfo(SymbolId id) const;
   /** @brief Returns a copy of the full symbol table. */
   std::vector<SymbolInfo> GetSymbolTable();
+  /** @brief Returns the number of declared symbols. */
+  size_t Size() const;
 
  private:
   std::vector<SymbolInfo> symbols_;
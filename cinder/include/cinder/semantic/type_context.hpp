@@ -1,8 +1,11 @@
 #ifndef TYPE_CONTEXT_H_
 #define TYPE_CONTEXT_H_
 
+#include <cstdint>
+#include <map>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 #include "cinder/ast/types.hpp"
 
@@ -11,14 +14,34 @@
  *
  * Primitive types are singletons stored directly in this context. Function
  * types are allocated into an internal pool and live for the lifetime of the
- * context.
+ * context. Array, slice, vector and reference types are interned per
+ * element type, so equal types share one instance.
  */
 class TypeContext {
  public:
+  /** @brief Returns canonical `int8` type. */
+  cinder::types::IntType* Int8();
+  /** @brief Returns canonical `int16` type. */
+  cinder::types::IntType* Int16();
   /** @brief Returns canonical `int32` type. */
   cinder::types::IntType* Int32();
   /** @brief Returns canonical `int64` type. */
   cinder::types::IntType* Int64();
+  /** @brief Returns canonical `uint8` type. */
+  cinder::types::IntType* UInt8();
+  /** @brief Returns canonical `uint16` type. */
+  cinder::types::IntType* UInt16();
+  /** @brief Returns canonical `uint32` type. */
+  cinder::types::IntType* UInt32();
+  /** @brief Returns canonical `uint64` type. */
+  cinder::types::IntType* UInt64();
+  /**
+   * @brief Returns the canonical integer type with the given shape.
+   * @param bits Bit width; one of 8, 16, 32 or 64.
+   * @param is_signed Signedness.
+   * @return Canonical type, or `nullptr` for an unsupported width.
+   */
+  cinder::types::IntType* Int(unsigned bits, bool is_signed);
   /** @brief Returns canonical `float32` type. */
   cinder::types::FloatType* Float32();
   /** @brief Returns canonical `float64` type. */
@@ -49,9 +72,35 @@ class TypeContext {
   /** @brief Looks up a struct type by name. */
   cinder::types::StructType* LookupStruct(const std::string& name);
 
+  /** @brief Interns a fixed-length array type `element[length]`. */
+  cinder::types::ArrayType* Array(cinder::types::Type* element,
+                                  uint64_t length);
+
+  /** @brief Interns a slice type `element[]`. */
+  cinder::types::SliceType* Slice(cinder::types::Type* element);
+
+  /** @brief Interns a SIMD vector type of `lanes` x `element`. */
+  cinder::types::VectorType* Vector(cinder::types::Type* element,
+                                    unsigned lanes);
+
+  /** @brief Interns `ref referent`, or `ptr referent` when `nullable`. */
+  cinder::types::ReferenceType* Reference(cinder::types::Type* referent,
+                                          bool nullable);
+
+  /** @brief Returns the number of pooled function types. */
+  size_t FunctionTypeCount() const;
+  /** @brief Returns the number of declared struct types. */
+  size_t StructTypeCount() const;
+
  private:
+  cinder::types::IntType int8_{8, true};
+  cinder::types::IntType int16_{16, true};
   cinder::types::IntType int32_{32, true};
   cinder::types::IntType int64_{64, true};
+  cinder::types::IntType uint8_{8, false};
+  cinder::types::IntType uint16_{16, false};
+  cinder::types::IntType uint32_{32, false};
+  cinder::types::IntType uint64_{64, false};
   cinder::types::FloatType flt32_{32};
   cinder::types::FloatType flt64_{64};
   cinder::types::BoolType bool_{1};
@@ -63,6 +112,18 @@ class TypeContext {
                        */
   std::unordered_map<std::string, std::unique_ptr<cinder::types::StructType>>
       struct_types_;
+  std::map<std::pair<cinder::types::Type*, uint64_t>,
+           std::unique_ptr<cinder::types::ArrayType>>
+      array_types_;
+  std::unordered_map<cinder::types::Type*,
+                     std::unique_ptr<cinder::types::SliceType>>
+      slice_types_;
+  std::map<std::pair<cinder::types::Type*, unsigned>,
+           std::unique_ptr<cinder::types::VectorType>>
+      vector_types_;
+  std::map<std::pair<cinder::types::Type*, bool>,
+           std::unique_ptr<cinder::types::ReferenceType>>
+      reference_types_;
 };
 
 #endif
@@ -24,6 +24,16 @@ struct AstDumper : ExprDumperVisitor, StmtDumperVisitor {
   std::string Visit(Assign& expr) override;
   std::string Visit(MemberAssign& expr) override;
   std::string Visit(Conditional& expr) override;
+  std::string Visit(Logical& expr) override;
+  std::string Visit(Unary& expr) override;
+  std::string Visit(IfExpr& expr) override;
+  std::string Visit(IndexAccess& expr) override;
+  std::string Visit(IndexAssign& expr) override;
+  std::string Visit(ArrayLiteral& expr) override;
+  std::string Visit(NewArray& expr) override;
+  std::string Visit(Cast& expr) override;
+  std::string Visit(IntrinsicCall& expr) override;
+  std::string Visit(SliceExpr& expr) override;
 
   std::string Visit(ExpressionStmt& stmt) override;
   std::string Visit(FunctionStmt& stmt) override;
@@ -34,6 +44,7 @@ struct AstDumper : ExprDumperVisitor, StmtDumperVisitor {
   std::string Visit(IfStmt& stmt) override;
   std::string Visit(ForStmt& stmt) override;
   std::string Visit(WhileStmt& stmt) override;
+  std::string Visit(MatchStmt& stmt) override;
   std::string Visit(ImportStmt& stmt) override;
   std::string Visit(StructStmt& stmt) override;
 };
@@ -0,0 +1,81 @@
+#ifndef COMPILE_STATS_H_
+#define COMPILE_STATS_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+
+/**
+ * @brief Process-wide compilation statistics collected for `--stats`.
+ *
+ * Recording methods are no-ops until statistics are enabled, so phases can
+ * call them unconditionally.
+ */
+struct CompileStats {
+  /** @brief Size of an LLVM module at one point of the pipeline. */
+  struct IRCounts {
+    uint64_t functions = 0;    /**< Defined (non-declaration) functions. */
+    uint64_t basic_blocks = 0; /**< Basic blocks across all functions. */
+    uint64_t instructions = 0; /**< Instructions across all functions. */
+  };
+
+  /** @brief Peak resident set size observed at a phase boundary. */
+  struct PhaseMemory {
+    std::string phase;       /**< Phase that just finished. */
+    uint64_t peak_rss_bytes; /**< Process peak RSS in bytes. */
+  };
+
+  uint64_t tokens = 0;                         /**< Tokens over all modules. */
+  std::map<std::string, uint64_t> expr_counts; /**< Nodes by `ExprType`. */
+  std::map<std::string, uint64_t> stmt_counts; /**< Nodes by `StmtType`. */
+  uint64_t symbols = 0;        /**< Entries in the resolved symbol table. */
+  uint64_t function_types = 0; /**< Function types in the `TypeContext`. */
+  uint64_t struct_types = 0;   /**< Struct types in the `TypeContext`. */
+  IRCounts ir_before_opt;      /**< Module size before the pass pipeline. */
+  IRCounts ir_after_opt;       /**< Module size after the pass pipeline. */
+  std::vector<PhaseMemory> memory; /**< Peak RSS per phase, in order. */
+
+  /** @brief Enables or disables statistics collection for the process. */
+  static void Enable(bool enabled);
+  /** @brief Returns whether statistics collection is enabled. */
+  static bool Enabled();
+  /** @brief Returns the process-wide statistics instance. */
+  static CompileStats& Global();
+
+  /** @brief Clears all collected values. */
+  void Reset();
+
+  /** @brief Adds `count` lexed tokens. */
+  void AddTokens(uint64_t count);
+  /** @brief Counts every expression and statement node in `modules`. */
+  void CountAst(const std::vector<ModuleStmt*>& modules);
+  /**
+   * @brief Records symbol table and type context sizes after sema.
+   * @param symbol_count Number of resolved symbols.
+   * @param function_type_count Number of pooled function types.
+   * @param struct_type_count Number of declared struct types.
+   */
+  void RecordSemantic(uint64_t symbol_count, uint64_t function_type_count,
+                      uint64_t struct_type_count);
+  /**
+   * @brief Records instruction and block counts for `mod`.
+   * @param mod Module to measure.
+   * @param optimized Whether the optimization pipeline already ran.
+   */
+  void RecordIR(const llvm::Module& mod, bool optimized);
+  /** @brief Records the current peak RSS at the end of `phase`. */
+  void RecordPhase(llvm::StringRef phase);
+
+  /** @brief Prints a human-readable report. */
+  void Print(llvm::raw_ostream& os) const;
+  /** @brief Prints the report as a JSON object. */
+  void PrintJSON(llvm::raw_ostream& os) const;
+};
+
+#endif
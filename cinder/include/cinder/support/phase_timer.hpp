@@ -0,0 +1,37 @@
+#ifndef PHASE_TIMER_H_
+#define PHASE_TIMER_H_
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/Timer.h"
+
+/**
+ * @brief Scoped wall-clock timer for a single compiler phase.
+ *
+ * Timers are grouped under one `cinder` timer group and only record when
+ * phase timing was enabled from the CLI (`--time-phases`). Each phase is also
+ * recorded as a span when the time-trace profiler is running (`--time-trace`).
+ */
+class PhaseTimer {
+  llvm::TimeTraceScope trace_;   /**< Time-trace span, no-op when disabled. */
+  llvm::NamedRegionTimer timer_; /**< Underlying LLVM region timer. */
+
+ public:
+  /**
+   * @brief Starts timing a phase until this object goes out of scope.
+   * @param name Short phase identifier.
+   * @param description Human-readable phase name used in the report.
+   * @param detail Optional time-trace detail such as a file name.
+   */
+  PhaseTimer(llvm::StringRef name, llvm::StringRef description,
+             llvm::StringRef detail = "");
+
+  /** @brief Enables or disables phase timing for the whole process. */
+  static void Enable(bool enabled);
+  /** @brief Returns whether phase timing is enabled. */
+  static bool Enabled();
+  /** @brief Prints all recorded phase timers to stderr. */
+  static void Report();
+};
+
+#endif
@@ -42,6 +42,36 @@ bool Expr::IsMemberAssign() {
 bool Expr::IsConditional() {
   return expr_type == ExprType::Conditional;
 }
+bool Expr::IsLogical() {
+  return expr_type == ExprType::Logical;
+}
+bool Expr::IsUnary() {
+  return expr_type == ExprType::Unary;
+}
+bool Expr::IsIfExpr() {
+  return expr_type == ExprType::IfExpr;
+}
+bool Expr::IsIndexAccess() {
+  return expr_type == ExprType::Index;
+}
+bool Expr::IsIndexAssign() {
+  return expr_type == ExprType::IndexAssign;
+}
+bool Expr::IsArrayLiteral() {
+  return expr_type == ExprType::ArrayLiteral;
+}
+bool Expr::IsNewArray() {
+  return expr_type == ExprType::NewArray;
+}
+bool Expr::IsCast() {
+  return expr_type == ExprType::Cast;
+}
+bool Expr::IsIntrinsic() {
+  return expr_type == ExprType::Intrinsic;
+}
+bool Expr::IsSliceExpr() {
+  return expr_type == ExprType::Slice;
+}
 bool Expr::HasID() {
   return id.has_value();
 }
@@ -141,6 +171,60 @@ std::string Binary::Accept(ExprDumperVisitor& visitor) {
   return visitor.Visit(*this);
 }
 
+Logical::Logical(std::unique_ptr<Expr> left, std::unique_ptr<Expr> right,
+                 Token op)
+    : Expr(ExprType::Logical),
+      left(std::move(left)),
+      right(std::move(right)),
+      op(op) {}
+
+Value* Logical::Accept(CodegenExprVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+void Logical::Accept(SemanticExprVisitor& visitor) {
+  visitor.Visit(*this);
+}
+
+std::string Logical::Accept(ExprDumperVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+Unary::Unary(Token op, std::unique_ptr<Expr> operand)
+    : Expr(ExprType::Unary), op(op), operand(std::move(operand)) {}
+
+Value* Unary::Accept(CodegenExprVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+void Unary::Accept(SemanticExprVisitor& visitor) {
+  visitor.Visit(*this);
+}
+
+std::string Unary::Accept(ExprDumperVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+IfExpr::IfExpr(std::unique_ptr<Expr> then, std::unique_ptr<Expr> cond,
+               std::unique_ptr<Expr> otherwise, Token if_token)
+    : Expr(ExprType::IfExpr),
+      then(std::move(then)),
+      cond(std::move(cond)),
+      otherwise(std::move(otherwise)),
+      if_token(if_token) {}
+
+Value* IfExpr::Accept(CodegenExprVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+void IfExpr::Accept(SemanticExprVisitor& visitor) {
+  visitor.Visit(*this);
+}
+
+std::string IfExpr::Accept(ExprDumperVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
 Assign::Assign(Token name, std::unique_ptr<Expr> value)
     : Expr(ExprType::Assign), name(name), value(std::move(value)) {}
 
@@ -208,3 +292,128 @@ void CallExpr::Accept(SemanticExprVisitor& visitor) {
 std::string CallExpr::Accept(ExprDumperVisitor& visitor) {
   return visitor.Visit(*this);
 }
+
+IndexAccess::IndexAccess(std::unique_ptr<Expr> object,
+                         std::unique_ptr<Expr> index, Token bracket)
+    : Expr(ExprType::Index),
+      object(std::move(object)),
+      index(std::move(index)),
+      bracket(bracket) {}
+
+Value* IndexAccess::Accept(CodegenExprVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+void IndexAccess::Accept(SemanticExprVisitor& visitor) {
+  visitor.Visit(*this);
+}
+
+std::string IndexAccess::Accept(ExprDumperVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+IndexAssign::IndexAssign(std::unique_ptr<IndexAccess> target,
+                         std::unique_ptr<Expr> value)
+    : Expr(ExprType::IndexAssign),
+      target(std::move(target)),
+      value(std::move(value)) {}
+
+Value* IndexAssign::Accept(CodegenExprVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+void IndexAssign::Accept(SemanticExprVisitor& visitor) {
+  visitor.Visit(*this);
+}
+
+std::string IndexAssign::Accept(ExprDumperVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+ArrayLiteral::ArrayLiteral(Token bracket,
+                           std::vector<std::unique_ptr<Expr>> elements)
+    : Expr(ExprType::ArrayLiteral),
+      bracket(bracket),
+      elements(std::move(elements)) {}
+
+Value* ArrayLiteral::Accept(CodegenExprVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+void ArrayLiteral::Accept(SemanticExprVisitor& visitor) {
+  visitor.Visit(*this);
+}
+
+std::string ArrayLiteral::Accept(ExprDumperVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+NewArray::NewArray(Token keyword, Token element_type,
+                   std::unique_ptr<Expr> length)
+    : Expr(ExprType::NewArray),
+      keyword(keyword),
+      element_type(element_type),
+      length(std::move(length)) {}
+
+Value* NewArray::Accept(CodegenExprVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+void NewArray::Accept(SemanticExprVisitor& visitor) {
+  visitor.Visit(*this);
+}
+
+std::string NewArray::Accept(ExprDumperVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+Cast::Cast(Token target, std::unique_ptr<Expr> value)
+    : Expr(ExprType::Cast), target(target), value(std::move(value)) {}
+
+Value* Cast::Accept(CodegenExprVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+void Cast::Accept(SemanticExprVisitor& visitor) {
+  visitor.Visit(*this);
+}
+
+std::string Cast::Accept(ExprDumperVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+IntrinsicCall::IntrinsicCall(Token name,
+                             std::vector<std::unique_ptr<Expr>> args)
+    : Expr(ExprType::Intrinsic), name(name), args(std::move(args)) {}
+
+Value* IntrinsicCall::Accept(CodegenExprVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+void IntrinsicCall::Accept(SemanticExprVisitor& visitor) {
+  visitor.Visit(*this);
+}
+
+std::string IntrinsicCall::Accept(ExprDumperVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+SliceExpr::SliceExpr(std::unique_ptr<Expr> object, std::unique_ptr<Expr> start,
+                     std::unique_ptr<Expr> end, Token bracket)
+    : Expr(ExprType::Slice),
+      object(std::move(object)),
+      start(std::move(start)),
+      end(std::move(end)),
+      bracket(bracket) {}
+
+Value* SliceExpr::Accept(CodegenExprVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+void SliceExpr::Accept(SemanticExprVisitor& visitor) {
+  visitor.Visit(*this);
+}
+
+std::string SliceExpr::Accept(ExprDumperVisitor& visitor) {
+  return visitor.Visit(*this);
+}
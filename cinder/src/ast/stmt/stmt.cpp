@@ -38,6 +38,9 @@ bool Stmt::IsFor() {
 bool Stmt::IsWhile() {
   return stmt_type == StmtType::While;
 }
+bool Stmt::IsMatch() {
+  return stmt_type == StmtType::Match;
+}
 bool Stmt::IsImport() {
   return stmt_type == StmtType::Import;
 }
@@ -92,6 +95,10 @@ FunctionProto::FunctionProto(Token name, Token return_type,
       is_variadic(is_variadic),
       is_extern(is_extern) {}
 
+bool FunctionProto::IsExported() const {
+  return is_extern || name.lexeme == "main";
+}
+
 Value* FunctionProto::Accept(StmtVisitor& visitor) {
   return visitor.Visit(*this);
 }
@@ -214,6 +221,27 @@ std::string WhileStmt::Accept(StmtDumperVisitor& visitor) {
   return visitor.Visit(*this);
 }
 
+MatchStmt::MatchStmt(cinder::Token match_token, std::unique_ptr<Expr> subject,
+                     std::vector<MatchArm> arms,
+                     std::vector<std::unique_ptr<Stmt>> otherwise)
+    : Stmt(StmtType::Match),
+      match_token(match_token),
+      subject(std::move(subject)),
+      arms(std::move(arms)),
+      otherwise(std::move(otherwise)) {}
+
+Value* MatchStmt::Accept(StmtVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
+void MatchStmt::Accept(SemanticStmtVisitor& visitor) {
+  visitor.Visit(*this);
+}
+
+std::string MatchStmt::Accept(StmtDumperVisitor& visitor) {
+  return visitor.Visit(*this);
+}
+
 ImportStmt::ImportStmt(cinder::Token mod_name)
     : Stmt(StmtType::Import), mod_name(mod_name) {}
 
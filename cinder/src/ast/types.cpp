@@ -30,6 +30,32 @@ bool types::Type::Struct() {
   return kind == types::TypeKind::Struct;
 }
 
+bool types::Type::Array() {
+  return kind == types::TypeKind::Array;
+}
+
+bool types::Type::Slice() {
+  return kind == types::TypeKind::Slice;
+}
+
+bool types::Type::Vector() {
+  return kind == types::TypeKind::Vector;
+}
+
+bool types::Type::Reference() {
+  return kind == types::TypeKind::Reference;
+}
+
+uint64_t types::Type::FixedLength() {
+  if (auto* array = dynamic_cast<types::ArrayType*>(this)) {
+    return array->length;
+  }
+  if (auto* vector = dynamic_cast<types::VectorType*>(this)) {
+    return vector->lanes;
+  }
+  return 0;
+}
+
 bool types::Type::IsThisType(types::Type* type) {
   if (!type || kind != type->kind) {
     return false;
@@ -44,6 +70,64 @@ bool types::Type::IsThisType(types::Type* type) {
     return lhs.get()->name == rhs.get()->name;
   }
 
+  if (kind == types::TypeKind::Int) {
+    auto lhs = CastTo<types::IntType>();
+    auto rhs = type->CastTo<types::IntType>();
+    if (lhs.getError() || rhs.getError()) {
+      return false;
+    }
+    return lhs.get()->bits == rhs.get()->bits &&
+           lhs.get()->is_signed == rhs.get()->is_signed;
+  }
+
+  if (kind == types::TypeKind::Float) {
+    auto lhs = CastTo<types::FloatType>();
+    auto rhs = type->CastTo<types::FloatType>();
+    if (lhs.getError() || rhs.getError()) {
+      return false;
+    }
+    return lhs.get()->bits == rhs.get()->bits;
+  }
+
+  if (kind == types::TypeKind::Array) {
+    auto lhs = CastTo<types::ArrayType>();
+    auto rhs = type->CastTo<types::ArrayType>();
+    if (lhs.getError() || rhs.getError()) {
+      return false;
+    }
+    return lhs.get()->length == rhs.get()->length &&
+           lhs.get()->element->IsThisType(rhs.get()->element);
+  }
+
+  if (kind == types::TypeKind::Slice) {
+    auto lhs = CastTo<types::SliceType>();
+    auto rhs = type->CastTo<types::SliceType>();
+    if (lhs.getError() || rhs.getError()) {
+      return false;
+    }
+    return lhs.get()->element->IsThisType(rhs.get()->element);
+  }
+
+  if (kind == types::TypeKind::Vector) {
+    auto lhs = CastTo<types::VectorType>();
+    auto rhs = type->CastTo<types::VectorType>();
+    if (lhs.getError() || rhs.getError()) {
+      return false;
+    }
+    return lhs.get()->lanes == rhs.get()->lanes &&
+           lhs.get()->element->IsThisType(rhs.get()->element);
+  }
+
+  if (kind == types::TypeKind::Reference) {
+    auto lhs = CastTo<types::ReferenceType>();
+    auto rhs = type->CastTo<types::ReferenceType>();
+    if (lhs.getError() || rhs.getError()) {
+      return false;
+    }
+    return lhs.get()->nullable == rhs.get()->nullable &&
+           lhs.get()->referent->IsThisType(rhs.get()->referent);
+  }
+
   return true;
 }
 
@@ -1,6 +1,7 @@
 #include <cstdlib>
 #include <fstream>
 #include <memory>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -12,6 +13,12 @@
 #include "cinder/frontend/module_loader.hpp"
 #include "cinder/frontend/parser.hpp"
 #include "cinder/support/ast_dumper.hpp"
+#include "cinder/support/compile_stats.hpp"
+#include "cinder/support/phase_timer.hpp"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/raw_ostream.h"
 
 static std::string ReadEntireFile(std::string file_path) {
   std::fstream file{file_path};
@@ -28,8 +35,58 @@ static std::string ReadEntireFile(std::string file_path) {
   return content;
 }
 
+static void WriteTimeTrace(const std::string& trace_path) {
+  if (llvm::Error err = llvm::timeTraceProfilerWrite(trace_path, "cinder")) {
+    llvm::logAllUnhandledErrors(std::move(err), llvm::errs(),
+                                "cinder: time trace: ");
+  }
+  llvm::timeTraceProfilerCleanup();
+}
+
+static void ReportStats(cxxopts::ParseResult& result) {
+  if (!CompileStats::Enabled()) {
+    return;
+  }
+  if (result.contains("stats")) {
+    CompileStats::Global().Print(llvm::errs());
+  }
+  if (result.contains("stats-json")) {
+    std::error_code ec;
+    llvm::raw_fd_ostream out(result["stats-json"].as<std::string>(), ec);
+    if (ec) {
+      llvm::errs() << "cinder: stats: " << ec.message() << "\n";
+      return;
+    }
+    CompileStats::Global().PrintJSON(out);
+  }
+}
+
 static bool GenerateProgram(cxxopts::ParseResult& result,
                             CodegenOpts::Opt opt) {
+  unsigned opt_level = result["O"].as<unsigned>();
+  if (opt_level > 3) {
+    std::cout << "invalid optimization level -O" << opt_level << "\n";
+    return false;
+  }
+  CodegenOpts::BoundsChecks bounds_checks = CodegenOpts::BoundsChecks::ON;
+  std::string bounds_mode = result["bounds-checks"].as<std::string>();
+  if (bounds_mode == "off") {
+    bounds_checks = CodegenOpts::BoundsChecks::OFF;
+  } else if (bounds_mode == "hoist") {
+    bounds_checks = CodegenOpts::BoundsChecks::HOIST;
+  } else if (bounds_mode != "on") {
+    std::cout << "invalid bounds check mode --bounds-checks=" << bounds_mode
+              << "\n";
+    return false;
+  }
+  std::string trace_path;
+  if (result.contains("time-trace")) {
+    trace_path = result["time-trace"].as<std::string>();
+    // Must start before Codegen builds its pass instrumentation so that LLVM
+    // passes are recorded too.
+    llvm::timeTraceProfilerInitialize(
+        result["time-trace-granularity"].as<unsigned>(), "cinder");
+  }
   bool debug_info = false;
   std::vector<std::string> linker_flags;
   std::vector<std::string> file_paths =
@@ -45,9 +102,45 @@ static bool GenerateProgram(cxxopts::ParseResult& result,
     debug_info = true;
     linker_flags.push_back("-g");
   }
+  std::string target_triple;
+  if (result.contains("target")) {
+    target_triple = result["target"].as<std::string>();
+    linker_flags.push_back("--target=" + target_triple);
+  }
+  std::string cpu;
+  if (result.contains("mcpu")) {
+    cpu = result["mcpu"].as<std::string>();
+  }
+  bool profile_generate = result.contains("profile-generate");
+  if (profile_generate) {
+    // Makes clang link the profile runtime.
+    linker_flags.push_back("-fprofile-generate");
+  }
+  std::string profile_use;
+  if (result.contains("profile-use")) {
+    profile_use = result["profile-use"].as<std::string>();
+    if (profile_generate) {
+      std::cout << "--profile-generate and --profile-use are exclusive\n";
+      return false;
+    }
+    if (!llvm::sys::fs::exists(profile_use)) {
+      std::cout << "profile not found < " << profile_use << " >\n";
+      return false;
+    }
+  }
+  bool ok = true;
   ModuleLoader loader({"."});
-  if (!loader.LoadEntrypoints(file_paths)) {
-    std::cout << loader.LastError() << "\n";
+  {
+    PhaseTimer timer("load", "Module loading");
+    if (!loader.LoadEntrypoints(file_paths)) {
+      std::cout << loader.LastError() << "\n";
+      ok = false;
+    }
+  }
+  if (!ok) {
+    if (!trace_path.empty()) {
+      WriteTimeTrace(trace_path);
+    }
     return false;
   }
 
@@ -56,10 +149,24 @@ static bool GenerateProgram(cxxopts::ParseResult& result,
   for (const auto& loaded : loader.OrderedModules()) {
     modules.push_back(loaded.ast.get());
   }
+  CompileStats::Global().CountAst(modules);
+  CompileStats::Global().RecordPhase("load");
 
   CodegenOpts opts{out_path, opt, debug_info, linker_flags};
+  opts.target_triple = target_triple;
+  opts.cpu = cpu;
+  opts.opt_level = opt_level;
+  opts.bounds_checks = bounds_checks;
+  opts.profile_generate = profile_generate;
+  opts.profile_use = profile_use;
   Codegen cg{std::move(modules), opts};
-  return cg.Generate();
+  ok = cg.Generate();
+  PhaseTimer::Report();
+  ReportStats(result);
+  if (!trace_path.empty()) {
+    WriteTimeTrace(trace_path);
+  }
+  return ok;
 }
 
 static void DumpUnknownArgs(cxxopts::ParseResult& result,
@@ -90,6 +197,30 @@ static bool ParseCLI(int argc, char** argv) {
   // options.add_options()("compile-run", "Compiles the program to llvm");
   options.add_options()("emit-llvm", "Emits llvm output");
   options.add_options()("g", "Emit debug information");
+  options.add_options()("target", "Target triple (defaults to the host)",
+                        value<std::string>());
+  options.add_options()("mcpu", "Target CPU, or 'native' for the host",
+                        value<std::string>());
+  options.add_options()("O,opt-level", "Optimization level (0-3)",
+                        value<unsigned>()->default_value("0"));
+  options.add_options()("bounds-checks",
+                        "Array bounds checks: on, off or hoist",
+                        value<std::string>()->default_value("on"));
+  options.add_options()("profile-generate",
+                        "Instrument the program to write a PGO profile");
+  options.add_options()("profile-use",
+                        "Optimize with a profile merged by llvm-profdata",
+                        value<std::string>());
+  options.add_options()("time-phases", "Report time spent in each phase");
+  options.add_options()("stats", "Report compilation statistics");
+  options.add_options()("stats-json", "Write compilation statistics to <file>",
+                        value<std::string>());
+  options.add_options()("time-trace",
+                        "Write a Chrome trace of the compilation to <file>",
+                        value<std::string>());
+  options.add_options()("time-trace-granularity",
+                        "Minimum span length in microseconds for --time-trace",
+                        value<unsigned>()->default_value("500"));
   options.add_options()("l,l-flags", "Linker option",
                         value<std::vector<std::string>>());
   options.add_options()("src", "The input files to be compiled",
@@ -106,6 +237,10 @@ static bool ParseCLI(int argc, char** argv) {
     return true;
   }
 
+  PhaseTimer::Enable(result.contains("time-phases"));
+  CompileStats::Enable(result.contains("stats") ||
+                       result.contains("stats-json"));
+
 #ifdef DEBUG_BUILD
   if (result.contains("emit-tokens")) {
     std::vector<std::string> file_paths =
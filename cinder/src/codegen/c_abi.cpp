@@ -0,0 +1,231 @@
+#include "cinder/codegen/c_abi.hpp"
+
+#include <algorithm>
+
+using namespace llvm;
+
+/** @brief Returns whether `type` is passed under the aggregate rules. */
+static bool IsAggregate(Type* type) {
+  return type && (type->isStructTy() || type->isArrayTy());
+}
+
+CAbi::CAbi(const Triple& triple, const DataLayout& layout) : layout_(layout) {
+  if (triple.getArch() == Triple::x86_64) {
+    target_ = triple.isOSWindows() ? Target::Win64 : Target::SysV;
+  } else if (triple.isAArch64()) {
+    target_ = Target::AArch64;
+  } else {
+    target_ = Target::Other;
+  }
+}
+
+void CAbi::Flatten(Type* type, uint64_t offset, std::vector<Leaf>& leaves) {
+  if (auto* s = dyn_cast<StructType>(type)) {
+    const StructLayout* fields = layout_.getStructLayout(s);
+    for (unsigned i = 0; i < s->getNumElements(); ++i) {
+      uint64_t field_offset = fields->getElementOffset(i);
+      Flatten(s->getElementType(i), offset + field_offset, leaves);
+    }
+    return;
+  }
+  if (auto* a = dyn_cast<ArrayType>(type)) {
+    uint64_t stride = layout_.getTypeAllocSize(a->getElementType());
+    for (uint64_t i = 0; i < a->getNumElements(); ++i) {
+      Flatten(a->getElementType(), offset + i * stride, leaves);
+    }
+    return;
+  }
+  leaves.push_back({offset, type});
+}
+
+Type* CAbi::ClassifySysV(Type* type, unsigned& ints, unsigned& sses) {
+  uint64_t size = layout_.getTypeAllocSize(type);
+  ints = 0;
+  sses = 0;
+  if (size == 0 || size > 16) {
+    return nullptr;
+  }
+  std::vector<Leaf> leaves;
+  Flatten(type, 0, leaves);
+  LLVMContext& ctx = type->getContext();
+
+  // A lone 16-byte vector fills one vector register.
+  if (leaves.size() == 1 && leaves[0].type->isVectorTy() && size == 16) {
+    sses = 1;
+    return leaves[0].type;
+  }
+
+  // Each eightbyte is SSE if it holds only floating point, else INTEGER.
+  bool is_integer[2] = {false, false};
+  for (const Leaf& leaf : leaves) {
+    uint64_t leaf_size = layout_.getTypeStoreSize(leaf.type);
+    uint64_t eightbyte = leaf.offset / 8;
+    if (leaf_size == 0) {
+      continue;
+    }
+    if (eightbyte != (leaf.offset + leaf_size - 1) / 8) {
+      return nullptr;
+    }
+    if (!leaf.type->getScalarType()->isFloatingPointTy()) {
+      is_integer[eightbyte] = true;
+    }
+  }
+
+  unsigned count = static_cast<unsigned>((size + 7) / 8);
+  Type* pieces[2] = {nullptr, nullptr};
+  for (unsigned i = 0; i < count; ++i) {
+    uint64_t bytes = std::min<uint64_t>(8, size - 8 * i);
+    if (is_integer[i]) {
+      ++ints;
+      pieces[i] = IntegerType::get(ctx, static_cast<unsigned>(bytes * 8));
+      continue;
+    }
+    ++sses;
+    std::vector<Leaf> in_eightbyte;
+    for (const Leaf& leaf : leaves) {
+      if (leaf.offset / 8 == i) {
+        in_eightbyte.push_back(leaf);
+      }
+    }
+    bool has_high = std::any_of(
+        in_eightbyte.begin(), in_eightbyte.end(),
+        [&](const Leaf& leaf) { return leaf.offset == 8 * i + 4; });
+    if (in_eightbyte.size() == 1 &&
+        layout_.getTypeAllocSize(in_eightbyte[0].type) == 8) {
+      pieces[i] = in_eightbyte[0].type;
+    } else if (has_high) {
+      pieces[i] = FixedVectorType::get(Type::getFloatTy(ctx), 2);
+    } else {
+      pieces[i] = Type::getFloatTy(ctx);
+    }
+  }
+  if (count == 1) {
+    return pieces[0];
+  }
+  return StructType::get(ctx, {pieces[0], pieces[1]});
+}
+
+Type* CAbi::HomogeneousBase(Type* type, unsigned& count) {
+  uint64_t size = layout_.getTypeAllocSize(type);
+  if (size == 0 || size > 64) {
+    return nullptr;
+  }
+  std::vector<Leaf> leaves;
+  Flatten(type, 0, leaves);
+  if (leaves.empty() || leaves.size() > 4) {
+    return nullptr;
+  }
+  Type* base = leaves[0].type;
+  bool is_float = base->isFloatTy() || base->isDoubleTy();
+  uint64_t base_size = layout_.getTypeAllocSize(base);
+  bool is_vector = base->isVectorTy() && (base_size == 8 || base_size == 16);
+  if (!is_float && !is_vector) {
+    return nullptr;
+  }
+  for (size_t i = 0; i < leaves.size(); ++i) {
+    if (leaves[i].type != base || leaves[i].offset != i * base_size) {
+      return nullptr;
+    }
+  }
+  if (size != leaves.size() * base_size) {
+    return nullptr;
+  }
+  count = static_cast<unsigned>(leaves.size());
+  return base;
+}
+
+CAbiArg CAbi::ClassifySysVArg(Type* type, bool is_return, unsigned& free_ints,
+                              unsigned& free_sses) {
+  if (!IsAggregate(type)) {
+    // Scalars use up registers that later aggregates can no longer have.
+    if (is_return || !type) {
+      return {};
+    }
+    if (type->isFPOrFPVectorTy() || type->isVectorTy()) {
+      free_sses -= free_sses ? 1 : 0;
+    } else if (type->isIntegerTy() || type->isPointerTy()) {
+      free_ints -= free_ints ? 1 : 0;
+    }
+    return {};
+  }
+
+  unsigned ints = 0;
+  unsigned sses = 0;
+  Type* coerced = ClassifySysV(type, ints, sses);
+  if (coerced && (is_return || (ints <= free_ints && sses <= free_sses))) {
+    if (!is_return) {
+      free_ints -= ints;
+      free_sses -= sses;
+    }
+    return {CAbiArg::Kind::Coerce, coerced, false};
+  }
+  // Arguments that do not fit in registers go to the stack as a whole.
+  return {CAbiArg::Kind::Indirect, nullptr, !is_return};
+}
+
+CAbiArg CAbi::ClassifyAArch64Arg(Type* type) {
+  if (!IsAggregate(type) || layout_.getTypeAllocSize(type) == 0) {
+    return {};
+  }
+  unsigned count = 0;
+  if (Type* base = HomogeneousBase(type, count)) {
+    return {CAbiArg::Kind::Coerce, ArrayType::get(base, count), false};
+  }
+  uint64_t size = layout_.getTypeAllocSize(type);
+  if (size > 16) {
+    // The callee receives a pointer to a copy the caller owns.
+    return {CAbiArg::Kind::Indirect, nullptr, false};
+  }
+  LLVMContext& ctx = type->getContext();
+  Type* i64 = Type::getInt64Ty(ctx);
+  if (size <= 8) {
+    return {CAbiArg::Kind::Coerce, i64, false};
+  }
+  if (layout_.getABITypeAlign(type).value() == 16) {
+    return {CAbiArg::Kind::Coerce, Type::getInt128Ty(ctx), false};
+  }
+  return {CAbiArg::Kind::Coerce, ArrayType::get(i64, 2), false};
+}
+
+CAbiArg CAbi::ClassifyWin64Arg(Type* type) {
+  if (!IsAggregate(type)) {
+    return {};
+  }
+  uint64_t size = layout_.getTypeAllocSize(type);
+  if (size == 1 || size == 2 || size == 4 || size == 8) {
+    Type* coerced =
+        IntegerType::get(type->getContext(), static_cast<unsigned>(size * 8));
+    return {CAbiArg::Kind::Coerce, coerced, false};
+  }
+  return {CAbiArg::Kind::Indirect, nullptr, false};
+}
+
+CAbiSignature CAbi::Classify(Type* ret, const std::vector<Type*>& params) {
+  CAbiSignature signature;
+  unsigned free_ints = 6;
+  unsigned free_sses = 8;
+  auto classify = [&](Type* type, bool is_return) -> CAbiArg {
+    switch (target_) {
+      case Target::SysV:
+        return ClassifySysVArg(type, is_return, free_ints, free_sses);
+      case Target::AArch64:
+        return ClassifyAArch64Arg(type);
+      case Target::Win64:
+        return ClassifyWin64Arg(type);
+      case Target::Other:
+        break;
+    }
+    return {};
+  };
+
+  signature.ret = classify(ret, true);
+  if (signature.ret.kind == CAbiArg::Kind::Indirect && free_ints) {
+    // The `sret` pointer takes the first integer register.
+    --free_ints;
+  }
+  signature.params.reserve(params.size());
+  for (Type* param : params) {
+    signature.params.push_back(classify(param, false));
+  }
+  return signature;
+}
@@ -1,5 +1,6 @@
 #include "cinder/codegen/codegen.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 #include <optional>
@@ -7,15 +8,24 @@
 #include <unordered_map>
 
 #include "cinder/ast/types.hpp"
+#include "cinder/codegen/c_abi.hpp"
 #include "cinder/codegen/codegen_bindings.hpp"
+#include "cinder/semantic/alias_analysis.hpp"
+#include "cinder/semantic/bounds_check.hpp"
+#include "cinder/support/compile_stats.hpp"
+#include "cinder/support/phase_timer.hpp"
 #include "cinder/support/utils.hpp"
 #include "llvm/ADT/APFloat.h"
+#include "llvm/IR/Attributes.h"
 #include "llvm/IR/Constants.h"
+#include "llvm/IR/DataLayout.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/IR/Intrinsics.h"
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
 #include "llvm/IR/Value.h"
@@ -23,8 +33,11 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetOptions.h"
 #include "llvm/TargetParser/Host.h"
@@ -42,6 +55,73 @@ static ostream::RawOutStream errors{2};
 
 namespace {
 
+/**
+ * Widest `match` range given one `switch` case per value. Wider ranges are
+ * tested with a subtract and compare, since a jump table over them would
+ * mostly repeat one target.
+ */
+constexpr uint64_t kMaxExpandedRange = 64;
+
+/** @brief Returns how many values past its first a match pattern covers. */
+uint64_t RangeSpan(const MatchPattern& pattern) {
+  return static_cast<uint64_t>(pattern.high_value) -
+         static_cast<uint64_t>(pattern.low_value);
+}
+
+/**
+ * @brief Returns whether `expr` may be evaluated even when the source would
+ * skip it: it cannot trap, write memory or call out.
+ *
+ * Such operands are lowered with `select` instead of a branch.
+ */
+bool IsSpeculatable(const Expr* expr) {
+  if (!expr || expr->constant) {
+    return expr != nullptr;
+  }
+  if (dynamic_cast<const Literal*>(expr) ||
+      dynamic_cast<const Variable*>(expr)) {
+    return true;
+  }
+  if (const auto* m = dynamic_cast<const MemberAccess*>(expr)) {
+    return IsSpeculatable(m->object.get());
+  }
+  if (const auto* g = dynamic_cast<const Grouping*>(expr)) {
+    return IsSpeculatable(g->expr.get());
+  }
+  if (const auto* u = dynamic_cast<const Unary*>(expr)) {
+    return IsSpeculatable(u->operand.get());
+  }
+  if (const auto* c = dynamic_cast<const Cast*>(expr)) {
+    return IsSpeculatable(c->value.get());
+  }
+  if (const auto* c = dynamic_cast<const Conditional*>(expr)) {
+    return IsSpeculatable(c->left.get()) && IsSpeculatable(c->right.get());
+  }
+  if (const auto* l = dynamic_cast<const Logical*>(expr)) {
+    return IsSpeculatable(l->left.get()) && IsSpeculatable(l->right.get());
+  }
+  if (const auto* i = dynamic_cast<const IfExpr*>(expr)) {
+    return IsSpeculatable(i->cond.get()) && IsSpeculatable(i->then.get()) &&
+           IsSpeculatable(i->otherwise.get());
+  }
+  if (const auto* b = dynamic_cast<const Binary*>(expr)) {
+    if (!IsSpeculatable(b->left.get()) || !IsSpeculatable(b->right.get())) {
+      return false;
+    }
+    bool divides =
+        b->op.kind == Token::Type::SLASH || b->op.kind == Token::Type::MODULO;
+    if (!divides || !b->type || b->type->Float()) {
+      return true;
+    }
+    // Integer division traps on zero and on `MIN / -1`.
+    const auto* divisor =
+        b->right->constant ? std::get_if<int64_t>(&*b->right->constant)
+                           : nullptr;
+    return divisor && *divisor != 0 && *divisor != -1;
+  }
+  return false;
+}
+
 std::optional<cinder::SourceLocation> ExprLocation(const Expr* expr) {
   if (!expr) {
     return std::nullopt;
@@ -62,6 +142,15 @@ std::optional<cinder::SourceLocation> ExprLocation(const Expr* expr) {
   if (const auto* c = dynamic_cast<const Conditional*>(expr)) {
     return c->op.location;
   }
+  if (const auto* l = dynamic_cast<const Logical*>(expr)) {
+    return l->op.location;
+  }
+  if (const auto* u = dynamic_cast<const Unary*>(expr)) {
+    return u->op.location;
+  }
+  if (const auto* i = dynamic_cast<const IfExpr*>(expr)) {
+    return i->if_token.location;
+  }
   if (const auto* a = dynamic_cast<const Assign*>(expr)) {
     return a->name.location;
   }
@@ -76,6 +165,29 @@ std::optional<cinder::SourceLocation> ExprLocation(const Expr* expr) {
   if (const auto* call = dynamic_cast<const CallExpr*>(expr)) {
     return ExprLocation(call->callee.get());
   }
+  if (const auto* index = dynamic_cast<const IndexAccess*>(expr)) {
+    return index->bracket.location;
+  }
+  if (const auto* ia = dynamic_cast<const IndexAssign*>(expr)) {
+    return ia->target ? std::optional<cinder::SourceLocation>(
+                            ia->target->bracket.location)
+                      : std::nullopt;
+  }
+  if (const auto* array = dynamic_cast<const ArrayLiteral*>(expr)) {
+    return array->bracket.location;
+  }
+  if (const auto* alloc = dynamic_cast<const NewArray*>(expr)) {
+    return alloc->keyword.location;
+  }
+  if (const auto* cast = dynamic_cast<const Cast*>(expr)) {
+    return cast->target.location;
+  }
+  if (const auto* intrinsic = dynamic_cast<const IntrinsicCall*>(expr)) {
+    return intrinsic->name.location;
+  }
+  if (const auto* slice = dynamic_cast<const SliceExpr*>(expr)) {
+    return slice->bracket.location;
+  }
 
   return std::nullopt;
 }
@@ -108,17 +220,15 @@ Codegen::Codegen(std::vector<ModuleStmt*> modules, CodegenOpts opts)
       pass_(types_) {}
 
 bool Codegen::Generate() {
-  InitAllTargets();
+  std::string target_trip = opts.target_triple.empty()
+                                ? sys::getDefaultTargetTriple()
+                                : Triple::normalize(opts.target_triple);
+  InitTargets(target_trip);
 
   if (!SemanticPass(modules_)) {
     return false;
   }
 
-  ctx_->DebugInfo().Init(opts.debug_info, ctx_->GetModule(), modules_);
-  GenerateIR();
-  ctx_->DebugInfo().Finalize();
-
-  std::string target_trip = sys::getDefaultTargetTriple();
   ctx_->SetTargetTriple(Triple(target_trip));
 
   std::string Error;
@@ -129,10 +239,43 @@ bool Codegen::Generate() {
     return false;
   }
 
+  // The CPU decides which vector widths the backend and vectorizer use.
+  std::string cpu = opts.cpu.empty() ? "generic" : opts.cpu;
+  if (cpu == "native") {
+    cpu = sys::getHostCPUName().str();
+  }
+
   TargetOptions gen_opt;
-  auto target_machine = ctx_->CreateTargetMachine(target, target_trip);
+  auto target_machine =
+      ctx_->CreateTargetMachine(target, target_trip, cpu, opts.opt_level);
+  if (!opts.profile_use.empty()) {
+    // With counts available, cold blocks move to a separate cold section.
+    target_machine->Options.EnableMachineFunctionSplitter = true;
+  }
 
+  // Lowering queries type sizes, so the layout has to be set before IR gen.
   ctx_->SetModDataLayout(target_machine);
+  if (ProfileOptions() && !modules_.empty() && modules_[0]) {
+    // Profiles key internal functions by source file name, which must not
+    // follow the `-o` path that differs between the two PGO builds.
+    ctx_->GetModule().setSourceFileName(modules_[0]->name.lexeme + ".ci");
+  }
+
+  {
+    PhaseTimer timer("irgen", "IR generation");
+    ctx_->DebugInfo().Init(opts.debug_info, ctx_->GetModule(), modules_);
+    GenerateIR();
+    ctx_->DebugInfo().Finalize();
+  }
+  CompileStats::Global().RecordPhase("irgen");
+
+  CompileStats::Global().RecordIR(ctx_->GetModule(), false);
+  {
+    PhaseTimer timer("opt", "Optimization");
+    ctx_->Optimize(target_machine, opts.opt_level, ProfileOptions());
+  }
+  CompileStats::Global().RecordIR(ctx_->GetModule(), true);
+  CompileStats::Global().RecordPhase("opt");
 
   switch (opts.mode) {
     case CodegenOpts::Opt::COMPILE:
@@ -149,7 +292,18 @@ bool Codegen::Generate() {
   }
 }
 
-void Codegen::InitAllTargets() {
+void Codegen::InitTargets(const std::string& triple) {
+  PhaseTimer timer("target-init", "Target initialization");
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  // Cross compilation needs the full registry, host builds only pay for the
+  // native backend.
+  Triple host(sys::getDefaultTargetTriple());
+  if (Triple(triple).getArch() == host.getArch()) {
+    return;
+  }
   InitializeAllTargetInfos();
   InitializeAllTargets();
   InitializeAllTargetMCs();
@@ -158,19 +312,47 @@ void Codegen::InitAllTargets() {
 }
 
 void Codegen::GenerateIR() {
+  // Globals come first so any function body can refer to them.
   for (ModuleStmt* mod : modules_) {
     if (!mod) {
       continue;
     }
+    for (auto& stmt : mod->stmts) {
+      if (auto* global = dynamic_cast<VarDeclarationStmt*>(stmt.get())) {
+        EmitGlobal(*global, mod->name.lexeme);
+      }
+    }
+  }
+  // Then every prototype, so bodies may call functions defined after them.
+  for (ModuleStmt* mod : modules_) {
+    if (!mod) {
+      continue;
+    }
+    current_module_ = mod->name.lexeme;
+    for (auto& stmt : mod->stmts) {
+      if (auto* fn = dynamic_cast<FunctionStmt*>(stmt.get())) {
+        fn->proto->Accept(*this);
+      } else if (auto* proto = dynamic_cast<FunctionProto*>(stmt.get())) {
+        proto->Accept(*this);
+      }
+    }
+  }
+  for (ModuleStmt* mod : modules_) {
+    if (!mod) {
+      continue;
+    }
+    current_module_ = mod->name.lexeme;
     mod->Accept(*this);
   }
 }
 
 void Codegen::EmitLLVM() {
+  PhaseTimer timer("emit", "LLVM IR emission");
   std::error_code EC;
   StringRef name{opts.out_path};
   raw_fd_ostream OS(name, EC, sys::fs::OF_None);
   ctx_->GetModule().print(OS, nullptr);
+  CompileStats::Global().RecordPhase("emit");
 }
 
 void Codegen::CompileRun() {
@@ -179,25 +361,38 @@ void Codegen::CompileRun() {
 
 void Codegen::CompileBinary(TargetMachine* target_machine) {
   std::error_code EC;
-  std::string temp = "." + opts.out_path + ".o";
+  // Hidden object file next to the output, e.g. `dir/.prog.o`.
+  SmallString<128> temp_path{sys::path::parent_path(opts.out_path)};
+  sys::path::append(temp_path,
+                    "." + sys::path::filename(opts.out_path).str() + ".o");
+  std::string temp = temp_path.str().str();
   StringRef name{temp};
   raw_fd_ostream object_file(name, EC, sys::fs::OF_None);
 
-  legacy::PassManager pass;
-  auto FileType = CodeGenFileType::ObjectFile;
+  {
+    PhaseTimer timer("emit", "Object emission");
+    legacy::PassManager pass;
+    auto FileType = CodeGenFileType::ObjectFile;
 
-  if (target_machine->addPassesToEmitFile(pass, object_file, nullptr,
-                                          FileType)) {
-    ostream::ErrorOutln(errors,
-                        "TheTargetMachine can't emit a file of this type");
-    return;
-  }
+    if (target_machine->addPassesToEmitFile(pass, object_file, nullptr,
+                                            FileType)) {
+      ostream::ErrorOutln(errors,
+                          "TheTargetMachine can't emit a file of this type");
+      return;
+    }
 
-  pass.run(ctx_->GetModule());
-  object_file.flush();
+    pass.run(ctx_->GetModule());
+    object_file.flush();
+  }
+  CompileStats::Global().RecordPhase("emit");
 
   bool keep_temp_object = false;
-  bool ok = ClangDriver::LinkObject(temp, opts.out_path, opts.linker_flags);
+  bool ok = false;
+  {
+    PhaseTimer timer("link", "Link");
+    ok = ClangDriver::LinkObject(temp, opts.out_path, opts.linker_flags);
+  }
+  CompileStats::Global().RecordPhase("link");
   if (!ok) {
     ostream::ErrorOutln(errors, "clang driver link step failed");
     keep_temp_object = true;
@@ -220,18 +415,42 @@ void Codegen::CompileBinary(TargetMachine* target_machine) {
   }
 }
 
+std::optional<PGOOptions> Codegen::ProfileOptions() const {
+  if (opts.profile_generate) {
+    // No path here: the profile runtime writes `default.profraw` unless
+    // LLVM_PROFILE_FILE says otherwise.
+    return PGOOptions("", "", "", /*MemoryProfile=*/"",
+                      vfs::getRealFileSystem(), PGOOptions::IRInstr);
+  }
+  if (!opts.profile_use.empty()) {
+    return PGOOptions(opts.profile_use, "", "", /*MemoryProfile=*/"",
+                      vfs::getRealFileSystem(), PGOOptions::IRUse);
+  }
+  return std::nullopt;
+}
+
 bool Codegen::SemanticPass(const std::vector<ModuleStmt*>& modules) {
   pass_.AnalyzeProgram(modules);
+  CompileStats::Global().RecordSemantic(
+      pass_.SymbolCount(), types_.FunctionTypeCount(), types_.StructTypeCount());
+  CompileStats::Global().RecordPhase("sema");
   if (pass_.HadError()) {
     pass_.DumpErrors();
     return false;
   }
+  if (opts.bounds_checks != CodegenOpts::BoundsChecks::OFF) {
+    BoundsCheckAnalysis bounds;
+    bounds.Run(modules);
+  }
+  AliasAnalysis aliases;
+  aliases.Run(modules);
   return true;
 }
 
 Value* Codegen::Visit(ModuleStmt& stmt) {
   for (auto& module_stmt : stmt.stmts) {
-    if (module_stmt->IsImport()) {
+    // Globals were emitted up front by `GenerateIR`.
+    if (module_stmt->IsImport() || module_stmt->IsVarDeclaration()) {
       continue;
     }
     module_stmt->Accept(*this);
@@ -273,7 +492,8 @@ Value* Codegen::Visit(WhileStmt& stmt) {
 
   Value* condition = stmt.condition->Accept(*this);
 
-  ctx_->CreateBasicCondBr(condition, loop_block, after_block);
+  ctx_->CreateBasicCondBr(condition, loop_block, after_block,
+                          BranchWeights(stmt.hint));
   ctx_->SetInsertPoint(loop_block);
 
   DIScope* previous_scope = ctx_->DebugInfo().GetScope();
@@ -294,6 +514,10 @@ Value* Codegen::Visit(ForStmt& stmt) {
   if (stmt.initializer) {
     stmt.initializer->Accept(*this);
   }
+  if (opts.bounds_checks == CodegenOpts::BoundsChecks::HOIST &&
+      !stmt.hoisted_checks.empty()) {
+    EmitHoistedBoundsChecks(stmt);
+  }
 
   if (stmt.condition && opts.debug_info) {
     if (auto loc = ExprLocation(stmt.condition.get())) {
@@ -312,7 +536,8 @@ Value* Codegen::Visit(ForStmt& stmt) {
 
   Value* condition = stmt.condition->Accept(*this);
 
-  ctx_->CreateBasicCondBr(condition, loop_block, after_block);
+  ctx_->CreateBasicCondBr(condition, loop_block, after_block,
+                          BranchWeights(stmt.hint));
   ctx_->SetInsertPoint(loop_block);
 
   DIScope* previous_scope = ctx_->DebugInfo().GetScope();
@@ -357,7 +582,8 @@ Value* Codegen::Visit(IfStmt& stmt) {
     else_block = BasicBlock::Create(ctx_->GetContext(), "if.else");
   }
 
-  ctx_->CreateBasicCondBr(condition, then_block, else_block);
+  ctx_->CreateBasicCondBr(condition, then_block, else_block,
+                          BranchWeights(stmt.hint));
   ctx_->SetInsertPoint(then_block);
 
   DIScope* previous_scope = ctx_->DebugInfo().GetScope();
@@ -399,43 +625,153 @@ Value* Codegen::Visit(IfStmt& stmt) {
   return nullptr;
 }
 
+Value* Codegen::Visit(MatchStmt& stmt) {
+  if (opts.debug_info) {
+    ctx_->DebugInfo().SetLocation(stmt.match_token.location);
+  }
+  Value* subject = stmt.subject->Accept(*this);
+  auto* type = cast<IntegerType>(subject->getType());
+  bool is_signed = true;
+  if (auto* int_type = dynamic_cast<types::IntType*>(stmt.subject->type)) {
+    is_signed = int_type->is_signed;
+  }
+  auto constant = [&](int64_t value) {
+    return ConstantInt::get(type, static_cast<uint64_t>(value), is_signed);
+  };
+
+  Function* func = ctx_->GetInsertBlockParent();
+  BasicBlock* merge = ctx_->CreateBasicBlock("match.end");
+  BasicBlock* otherwise = merge;
+  if (!stmt.otherwise.empty()) {
+    otherwise = ctx_->CreateBasicBlock("match.else");
+  }
+
+  // Single values and short ranges become `switch` cases, which the backend
+  // lowers to a jump table, bit tests or a search tree. Wide ranges are
+  // checked in the default block before falling through to `else`.
+  std::vector<BasicBlock*> arm_blocks;
+  std::vector<std::pair<const MatchPattern*, BasicBlock*>> wide_ranges;
+  for (size_t i = 0; i < stmt.arms.size(); ++i) {
+    arm_blocks.push_back(ctx_->CreateBasicBlock("match.arm"));
+    for (const MatchPattern& pattern : stmt.arms[i].patterns) {
+      if (RangeSpan(pattern) >= kMaxExpandedRange) {
+        wide_ranges.push_back({&pattern, arm_blocks.back()});
+      }
+    }
+  }
+  BasicBlock* default_block = otherwise;
+  if (!wide_ranges.empty()) {
+    default_block = ctx_->CreateBasicBlock("match.range", func);
+  }
+
+  SwitchInst* dispatch =
+      ctx_->GetBuilder().CreateSwitch(subject, default_block);
+  for (size_t i = 0; i < stmt.arms.size(); ++i) {
+    for (const MatchPattern& pattern : stmt.arms[i].patterns) {
+      uint64_t span = RangeSpan(pattern);
+      if (span >= kMaxExpandedRange) {
+        continue;
+      }
+      for (uint64_t k = 0; k <= span; ++k) {
+        int64_t value = static_cast<int64_t>(
+            static_cast<uint64_t>(pattern.low_value) + k);
+        dispatch->addCase(constant(value), arm_blocks[i]);
+      }
+    }
+  }
+
+  if (!wide_ranges.empty()) {
+    ctx_->SetInsertPoint(default_block);
+    for (size_t i = 0; i < wide_ranges.size(); ++i) {
+      const MatchPattern& pattern = *wide_ranges[i].first;
+      // `low <= x <= high` is one unsigned compare of `x - low`.
+      Value* offset = ctx_->GetBuilder().CreateSub(
+          subject, constant(pattern.low_value), "match.offset");
+      Value* in_range = ctx_->GetBuilder().CreateICmpULE(
+          offset, ConstantInt::get(type, RangeSpan(pattern)), "match.in");
+      BasicBlock* next = otherwise;
+      if (i + 1 < wide_ranges.size()) {
+        next = ctx_->CreateBasicBlock("match.range", func);
+      }
+      ctx_->CreateBasicCondBr(in_range, wide_ranges[i].second, next);
+      ctx_->SetInsertPoint(next);
+    }
+  }
+
+  DIScope* previous_scope = ctx_->DebugInfo().GetScope();
+  auto emit_arm = [&](BasicBlock* block,
+                      std::vector<std::unique_ptr<Stmt>>& body,
+                      const cinder::Token& token) {
+    func->insert(func->end(), block);
+    ctx_->SetInsertPoint(block);
+    if (opts.debug_info) {
+      ctx_->DebugInfo().CreateLexicalBlock(token.location);
+    }
+    for (auto& body_stmt : body) {
+      body_stmt->Accept(*this);
+    }
+    if (!ctx_->GetInsertBlockTerminator()) {
+      ctx_->CreateBr(merge);
+    }
+    ctx_->DebugInfo().SetScope(previous_scope);
+  };
+  for (size_t i = 0; i < stmt.arms.size(); ++i) {
+    emit_arm(arm_blocks[i], stmt.arms[i].body, stmt.arms[i].case_token);
+  }
+  if (!stmt.otherwise.empty()) {
+    emit_arm(otherwise, stmt.otherwise, stmt.match_token);
+  }
+
+  func->insert(func->end(), merge);
+  ctx_->SetInsertPoint(merge);
+  return nullptr;
+}
+
 Value* Codegen::Visit(FunctionStmt& stmt) {
   auto* proto_stmt = dynamic_cast<FunctionProto*>(stmt.proto.get());
+  TimeTraceScope trace("CodegenFunction", proto_stmt->name.lexeme);
   Function* func = dyn_cast<Function>(stmt.proto->Accept(*this));
   BasicBlock* entry = ctx_->CreateBasicBlock("entry", func);
   ctx_->SetInsertPoint(entry);
   di_locals_.clear();
 
+  // Parameters are bound like locals, so they can be assigned and passed by
+  // reference. References and large structs already arrive as an address;
+  // other parameters get a stack slot that mem2reg removes again.
+  return_slot_ = func->hasStructRetAttr() ? func->getArg(0) : nullptr;
+  unsigned first = return_slot_ ? 1 : 0;
+  std::vector<Value*> param_slots;
+  for (size_t i = 0; proto_stmt && i < proto_stmt->args.size(); ++i) {
+    FuncArg& param = proto_stmt->args[i];
+    Argument* arg = func->getArg(first + static_cast<unsigned>(i));
+    Value* slot = arg;
+    Type* value_type = nullptr;
+    if (auto* ref = dynamic_cast<types::ReferenceType*>(param.resolved_type)) {
+      value_type = ResolveType(ref->referent);
+    } else if (arg->hasByValAttr()) {
+      value_type = arg->getParamByValType();
+    } else {
+      value_type = arg->getType();
+      slot = ctx_->CreateAlloca(value_type, nullptr, arg->getName());
+      ctx_->CreateStore(arg, slot);
+    }
+    param_slots.push_back(slot);
+    if (!param.id) {
+      continue;
+    }
+    std::unique_ptr<Binding>& b = ir_bindings_[*param.id];
+    b = std::make_unique<VarBinding>();
+    static_cast<VarBinding&>(*b).SetAddress(slot, value_type);
+  }
+
   DIScope* previous_scope = ctx_->DebugInfo().GetScope();
   auto* di_builder = ctx_->DebugInfo().GetBuilder();
   auto* di_file = ctx_->DebugInfo().GetFile();
   if (opts.debug_info && di_builder && di_file) {
-    auto debug_type_from_token = [&](const Token& tok) -> DIType* {
-      switch (tok.kind) {
-        case Token::Type::BOOL_SPECIFIER:
-          return di_builder->createBasicType("bool", 1, dwarf::DW_ATE_boolean);
-        case Token::Type::INT32_SPECIFIER:
-          return di_builder->createBasicType("int", 32, dwarf::DW_ATE_signed);
-        case Token::Type::INT64_SPECIFIER:
-          return di_builder->createBasicType("int", 64, dwarf::DW_ATE_signed);
-        case Token::Type::FLT32_SPECIFIER:
-          return di_builder->createBasicType("float", 32, dwarf::DW_ATE_float);
-        case Token::Type::FLT64_SPECIFIER:
-          return di_builder->createBasicType("double", 64, dwarf::DW_ATE_float);
-        case Token::Type::STR_SPECIFIER: {
-          auto* char_ty =
-              di_builder->createBasicType("char", 8, dwarf::DW_ATE_signed_char);
-          return di_builder->createPointerType(char_ty, 64);
-        }
-        case Token::Type::VOID_SPECIFIER:
-        default:
-          return di_builder->createUnspecifiedType("void");
-      }
-    };
-
     SmallVector<Metadata*, 8> param_types;
-    if (proto_stmt) {
-      param_types.push_back(debug_type_from_token(proto_stmt->return_type));
+    if (proto_stmt && proto_stmt->resolved_type) {
+      param_types.push_back(ctx_->DebugInfo().ResolveType(
+          proto_stmt->resolved_type->return_type));
       for (const auto& arg : proto_stmt->args) {
         param_types.push_back(ctx_->DebugInfo().ResolveType(arg.resolved_type));
       }
@@ -452,20 +788,22 @@ Value* Codegen::Visit(FunctionStmt& stmt) {
                                        : proto_stmt->name.location.line);
     }
 
+    DISubprogram::DISPFlags sp_flags = DISubprogram::SPFlagDefinition;
+    if (func->hasLocalLinkage()) {
+      sp_flags |= DISubprogram::SPFlagLocalToUnit;
+    }
+    // Debuggers show the cinder name; the symbol may be module-qualified.
+    StringRef name = proto_stmt ? StringRef(proto_stmt->name.lexeme)
+                                : func->getName();
     auto* subprogram = di_builder->createFunction(
-        di_file, func->getName(), func->getName(), di_file, line, subroutine,
-        line, DINode::FlagPrototyped, DISubprogram::SPFlagDefinition);
+        di_file, name, func->getName(), di_file, line, subroutine, line,
+        DINode::FlagPrototyped, sp_flags);
     func->setSubprogram(subprogram);
     ctx_->DebugInfo().SetScope(subprogram);
     if (proto_stmt) {
       ctx_->DebugInfo().SetLocation(proto_stmt->name.location);
 
-      size_t arg_index = 0;
-      for (auto& arg : func->args()) {
-        if (arg_index >= proto_stmt->args.size()) {
-          break;
-        }
-
+      for (size_t arg_index = 0; arg_index < param_slots.size(); ++arg_index) {
         const FuncArg& arg_meta = proto_stmt->args[arg_index];
         unsigned line =
             static_cast<unsigned>(arg_meta.identifier.location.line == 0
@@ -482,9 +820,16 @@ Value* Codegen::Visit(FunctionStmt& stmt) {
             ctx_->DebugInfo().ResolveType(arg_meta.resolved_type), true);
         auto* dl = DILocation::get(ctx_->GetContext(), line, col,
                                    ctx_->DebugInfo().GetScope());
-        di_builder->insertDbgValueIntrinsic(
-            &arg, dbg_param, di_builder->createExpression(), dl, entry);
-        ++arg_index;
+        // A reference is described by the pointer it holds; everything else
+        // lives in its slot.
+        Value* slot = param_slots[arg_index];
+        if (arg_meta.resolved_type && arg_meta.resolved_type->Reference()) {
+          di_builder->insertDbgValueIntrinsic(
+              slot, dbg_param, di_builder->createExpression(), dl, entry);
+        } else {
+          di_builder->insertDeclare(slot, dbg_param,
+                                    di_builder->createExpression(), dl, entry);
+        }
       }
     }
   }
@@ -508,24 +853,163 @@ Value* Codegen::Visit(FunctionStmt& stmt) {
 }
 
 Value* Codegen::Visit(FunctionProto& stmt) {
+  if (stmt.id.has_value()) {
+    auto declared = ir_bindings_.find(stmt.GetID());
+    if (declared != ir_bindings_.end() && declared->second &&
+        declared->second->IsFunction()) {
+      // `GenerateIR` declared it ahead of the bodies.
+      return declared->second->CastTo<FuncBinding>().get()->function;
+    }
+  }
   ctx_->DebugInfo().SetLocation(stmt.name.location);
-  Type* ret_type = ctx_->CreateTypeFromToken(stmt.return_type);
+  // C functions take and return strings as `char*`.
+  auto resolve = [&](types::Type* type) {
+    return stmt.is_extern ? ResolveCType(type) : ResolveArgType(type);
+  };
+  Type* ret_type = nullptr;
+  if (!stmt.resolved_type) {
+    ret_type = ctx_->CreateTypeFromToken(stmt.return_type);
+  } else if (stmt.is_extern) {
+    ret_type = ResolveCType(stmt.resolved_type->return_type);
+  } else {
+    ret_type = ResolveType(stmt.resolved_type->return_type);
+  }
 
-  std::vector<Type*> arg_types;
-  arg_types.reserve(stmt.args.size());
+  std::vector<Type*> value_types;
+  value_types.reserve(stmt.args.size());
   for (auto& arg : stmt.args) {
-    arg_types.push_back(ResolveArgType(arg.resolved_type));
+    value_types.push_back(resolve(arg.resolved_type));
+  }
+  CAbiSignature abi = LowerSignature(stmt, ret_type, value_types);
+
+  // A struct result in memory is written to a slot passed as a hidden first
+  // argument.
+  Type* ptr = PointerType::getUnqual(ctx_->GetContext());
+  std::vector<Type*> arg_types;
+  arg_types.reserve(stmt.args.size() + 1);
+  Type* sret_type = nullptr;
+  if (abi.ret.kind == CAbiArg::Kind::Indirect) {
+    sret_type = ret_type;
+    ret_type = Type::getVoidTy(ctx_->GetContext());
+    arg_types.push_back(ptr);
+  } else if (abi.ret.kind == CAbiArg::Kind::Coerce) {
+    ret_type = abi.ret.type;
+  }
+  unsigned first = sret_type ? 1 : 0;
+  for (size_t i = 0; i < stmt.args.size(); ++i) {
+    switch (abi.params[i].kind) {
+      case CAbiArg::Kind::Indirect:
+        arg_types.push_back(ptr);
+        break;
+      case CAbiArg::Kind::Coerce:
+        arg_types.push_back(abi.params[i].type);
+        break;
+      case CAbiArg::Kind::Direct:
+        arg_types.push_back(value_types[i]);
+        break;
+    }
   }
 
   FunctionType* func_type =
       ctx_->GetFuncType(ret_type, arg_types, stmt.is_variadic);
 
-  Function* func = ctx_->CreatePublicFunc(func_type, stmt.name.lexeme);
+  // Functions C never enters use the faster convention; sema checks
+  // `musttail` calls against the same `IsExported` rule. Like globals they
+  // are named `mod.name`, which leaves C symbols to externs and the runtime.
+  Function* func = nullptr;
+  if (stmt.IsExported()) {
+    func = ctx_->CreatePublicFunc(func_type, stmt.name.lexeme);
+  } else {
+    std::string symbol = current_module_.empty()
+                             ? stmt.name.lexeme
+                             : current_module_ + "." + stmt.name.lexeme;
+    func = ctx_->CreateInternalFunc(func_type, symbol);
+  }
+  if (!func) {
+    ostream::ErrorOutln(errors, "Conflicting declarations of C function:",
+                        stmt.name.lexeme);
+  }
+
+  auto& llvm_ctx = ctx_->GetContext();
+  const DataLayout& layout = ctx_->GetModule().getDataLayout();
+  if (sret_type) {
+    func->getArg(0)->setName("ret.slot");
+    func->addParamAttr(0,
+                       Attribute::getWithStructRetType(llvm_ctx, sret_type));
+    func->addParamAttr(0, Attribute::NoAlias);
+    func->addParamAttr(0, Attribute::getWithAlignment(
+                              llvm_ctx, layout.getABITypeAlign(sret_type)));
+  }
+  for (size_t i = 0; i < stmt.args.size(); ++i) {
+    unsigned index = first + static_cast<unsigned>(i);
+    func->getArg(index)->setName(stmt.args[i].identifier.lexeme);
+    types::Type* type = stmt.args[i].resolved_type;
+    if (auto* ref = dynamic_cast<types::ReferenceType*>(type)) {
+      // A `ptr` may come from C, so only a `ref` promises a valid object.
+      func->addParamAttr(index, Attribute::NoUndef);
+      if (stmt.args[i].no_alias) {
+        func->addParamAttr(index, Attribute::NoAlias);
+      }
+      if (ref->nullable) {
+        continue;
+      }
+      Type* referent = ResolveType(ref->referent);
+      func->addParamAttr(index, Attribute::NonNull);
+      if (uint64_t size = layout.getTypeAllocSize(referent)) {
+        func->addDereferenceableParamAttr(index, size);
+      }
+      func->addParamAttr(index,
+                         Attribute::getWithAlignment(
+                             llvm_ctx, layout.getABITypeAlign(referent)));
+    } else if (abi.params[i].byval) {
+      Type* value_type = value_types[i];
+      func->addParamAttr(index,
+                         Attribute::getWithByValType(llvm_ctx, value_type));
+      func->addParamAttr(index,
+                         Attribute::getWithAlignment(
+                             llvm_ctx, layout.getABITypeAlign(value_type)));
+    }
+  }
+
+  switch (stmt.inline_policy) {
+    case InlinePolicy::Hint:
+      func->addFnAttr(Attribute::InlineHint);
+      break;
+    case InlinePolicy::Always:
+      func->addFnAttr(Attribute::AlwaysInline);
+      break;
+    case InlinePolicy::Never:
+      func->addFnAttr(Attribute::NoInline);
+      break;
+    case InlinePolicy::Default:
+      break;
+  }
+  if (stmt.frequency == CallFrequency::Cold) {
+    func->addFnAttr(Attribute::Cold);
+  } else if (stmt.frequency == CallFrequency::Hot) {
+    func->addFnAttr(Attribute::Hot);
+  }
 
-  size_t idx = 0;
-  for (auto& arg : func->args()) {
-    arg.setName(stmt.args[idx].identifier.lexeme);
-    ++idx;
+  if (stmt.effects != ExternEffects::None) {
+    // Effect-free calls can be hoisted, merged and dropped like arithmetic.
+    // Structs passed through memory are still read, and an `sret` result is
+    // written, so those signatures only promise to stay within arguments.
+    auto indirect = [](const CAbiArg& param) {
+      return param.kind == CAbiArg::Kind::Indirect;
+    };
+    bool in_memory = sret_type || std::any_of(abi.params.begin(),
+                                              abi.params.end(), indirect);
+    func->setDoesNotThrow();
+    func->setWillReturn();
+    if (!in_memory) {
+      if (stmt.effects == ExternEffects::Const) {
+        func->setDoesNotAccessMemory();
+      } else {
+        func->setOnlyReadsMemory();
+      }
+    } else if (stmt.effects == ExternEffects::Const) {
+      func->setOnlyAccessesArgMemory();
+    }
   }
 
   if (stmt.id.has_value()) {
@@ -538,26 +1022,93 @@ Value* Codegen::Visit(FunctionProto& stmt) {
       return nullptr;
     }
     f.get()->function = func;
+    f.get()->is_extern = stmt.is_extern;
+    f.get()->abi = std::move(abi);
   }
   return func;
 }
 
+CAbiSignature Codegen::LowerSignature(FunctionProto& stmt, Type* ret,
+                                      const std::vector<Type*>& params) {
+  if (stmt.is_extern) {
+    Module& module = ctx_->GetModule();
+    CAbi abi(Triple(module.getTargetTriple()), module.getDataLayout());
+    return abi.Classify(ret, params);
+  }
+  CAbiSignature signature;
+  if (stmt.resolved_type && PassesIndirectly(stmt.resolved_type->return_type)) {
+    signature.ret.kind = CAbiArg::Kind::Indirect;
+  }
+  for (auto& arg : stmt.args) {
+    CAbiArg& param = signature.params.emplace_back();
+    if (PassesIndirectly(arg.resolved_type)) {
+      param.kind = CAbiArg::Kind::Indirect;
+      param.byval = true;
+    }
+  }
+  return signature;
+}
+
 Value* Codegen::Visit(ReturnStmt& stmt) {
   ctx_->DebugInfo().SetLocation(stmt.ret_token.location);
+  if (!stmt.value) {
+    return ctx_->CreateVoidReturn();
+  }
+  if (stmt.is_tail) {
+    // A `musttail` call may only be followed by the `ret` of its result.
+    Value* call = stmt.value->Accept(*this);
+    if (!call || call->getType()->isVoidTy()) {
+      return ctx_->CreateVoidReturn();
+    }
+    return ctx_->CreateReturn(call);
+  }
   if (stmt.value->type->Void()) {
+    // `return f();` of a void call still makes the call.
+    stmt.value->Accept(*this);
+    return ctx_->CreateVoidReturn();
+  }
+  Value* ret = EmitCoerced(*stmt.value, stmt.resolved_type);
+  if (return_slot_) {
+    ctx_->CreateStore(ret, return_slot_);
     return ctx_->CreateVoidReturn();
   }
-  Value* ret = stmt.value->Accept(*this);
   return ctx_->CreateReturn(ret);
   return nullptr;
 }
 
 Value* Codegen::Visit(VarDeclarationStmt& stmt) {
+  if (stmt.is_const) {
+    // Every use of a constant is folded, so it needs no storage.
+    return nullptr;
+  }
   ctx_->DebugInfo().SetLocation(stmt.name.location);
-  Value* init = stmt.value->Accept(*this);
-  Type* ty = ResolveType(stmt.value->type);
-  AllocaInst* slot = ctx_->CreateAlloca(ty, nullptr, stmt.name.lexeme);
-  ctx_->CreateStore(init, slot);
+  types::Type* declared =
+      stmt.resolved_type ? stmt.resolved_type : stmt.value->type;
+
+  // A reference names the storage of its initializer and has none of its own.
+  Value* slot = nullptr;
+  Value* init = nullptr;
+  bool is_ref = false;
+  if (auto* ref = dynamic_cast<types::ReferenceType*>(declared)) {
+    slot = EmitAddress(*stmt.value);
+    declared = ref->referent;
+    is_ref = true;
+  } else {
+    slot = ctx_->CreateAlloca(ResolveType(declared), nullptr, stmt.name.lexeme);
+  }
+  if (!slot) {
+    return nullptr;
+  }
+  Type* ty = ResolveType(declared);
+
+  if (is_ref) {
+    // Nothing to initialize.
+  } else if (auto* array = dynamic_cast<types::ArrayType*>(declared)) {
+    EmitArrayInit(cast<AllocaInst>(slot), array, *stmt.value);
+  } else {
+    init = EmitCoerced(*stmt.value, declared);
+    ctx_->CreateStore(init, slot);
+  }
 
   auto* di_builder = ctx_->DebugInfo().GetBuilder();
   auto* di_file = ctx_->DebugInfo().GetFile();
@@ -568,16 +1119,22 @@ Value* Codegen::Visit(VarDeclarationStmt& stmt) {
         stmt.name.location.column == 0 ? 1 : stmt.name.location.column);
     auto* variable = di_builder->createAutoVariable(
         ctx_->DebugInfo().GetScope(), stmt.name.lexeme, di_file, line,
-        ctx_->DebugInfo().ResolveType(stmt.value->type));
-    di_builder->insertDeclare(slot, variable, di_builder->createExpression(),
-                              DILocation::get(ctx_->GetContext(), line, col,
-                                              ctx_->DebugInfo().GetScope()),
-                              ctx_->GetBuilder().GetInsertBlock());
-
-    if (stmt.HasID()) {
-      di_locals_[stmt.GetID()] = variable;
+        ctx_->DebugInfo().ResolveType(declared));
+    auto* dl = DILocation::get(ctx_->GetContext(), line, col,
+                               ctx_->DebugInfo().GetScope());
+    if (is_ref) {
+      di_builder->insertDbgValueIntrinsic(
+          slot, variable, di_builder->createExpression(
+                              ArrayRef<uint64_t>{dwarf::DW_OP_deref}),
+          dl, ctx_->GetBuilder().GetInsertBlock());
+    } else {
+      di_builder->insertDeclare(slot, variable, di_builder->createExpression(),
+                                dl, ctx_->GetBuilder().GetInsertBlock());
+      if (stmt.HasID()) {
+        di_locals_[stmt.GetID()] = variable;
+      }
+      ctx_->DebugInfo().EmitValue(init, variable, stmt.name.location);
     }
-    ctx_->DebugInfo().EmitValue(init, variable, stmt.name.location);
   }
 
   if (stmt.HasID()) {
@@ -589,19 +1146,37 @@ Value* Codegen::Visit(VarDeclarationStmt& stmt) {
     if (var.getError()) {
       return nullptr;
     }
-    var.get()->SetAlloca(slot);
+    var.get()->SetAddress(slot, ty);
   }
   return init;
 }
 
+/** @brief Returns the lane type of a vector, or `type` itself. */
+static types::Type* LaneType(types::Type* type) {
+  if (auto* vector = dynamic_cast<types::VectorType*>(type)) {
+    return vector->element;
+  }
+  return type;
+}
+
 Value* Codegen::Visit(Conditional& expr) {
+  if (expr.constant) {
+    return EmitConstant(*expr.constant, expr.type);
+  }
   ctx_->DebugInfo().SetLocation(expr.op.location);
-  Value* left = expr.left->Accept(*this);
-  Value* right = expr.right->Accept(*this);
-
-  switch (expr.left->type->kind) {
-    case types::TypeKind::Int:
-      return ctx_->CreateIntCmp(expr.op.kind, left, right);
+  Value* left = EmitCoerced(*expr.left, expr.operand_type);
+  Value* right = EmitCoerced(*expr.right, expr.operand_type);
+
+  // Vector compares lower lane-wise through the same builders to masks.
+  types::Type* lane = LaneType(expr.operand_type);
+  switch (lane->kind) {
+    case types::TypeKind::Int: {
+      auto* int_type = dynamic_cast<types::IntType*>(lane);
+      bool is_signed = !int_type || int_type->is_signed;
+      return ctx_->CreateIntCmp(expr.op.kind, left, right, is_signed);
+    }
+    case types::TypeKind::Bool:
+      return ctx_->CreateIntCmp(expr.op.kind, left, right, false);
     case types::TypeKind::Float:
       return ctx_->CreateFltCmp(expr.op.kind, left, right);
     default:
@@ -610,14 +1185,106 @@ Value* Codegen::Visit(Conditional& expr) {
   return nullptr;
 }
 
-Value* Codegen::Visit(Binary& expr) {
+Value* Codegen::Visit(Logical& expr) {
+  if (expr.constant) {
+    return EmitConstant(*expr.constant, expr.type);
+  }
+  auto& builder = ctx_->GetBuilder();
   ctx_->DebugInfo().SetLocation(expr.op.location);
   Value* left = expr.left->Accept(*this);
+  bool is_and = expr.op.kind == Token::Type::AMPAMP;
+
+  if (IsSpeculatable(expr.right.get())) {
+    Value* right = expr.right->Accept(*this);
+    // The select form is what LLVM canonicalizes `&&` and `||` to, and it
+    // stays poison-safe when `right` is not needed.
+    return is_and ? builder.CreateSelect(left, right, builder.getFalse())
+                  : builder.CreateSelect(left, builder.getTrue(), right);
+  }
+
+  Function* func = ctx_->GetInsertBlockParent();
+  BasicBlock* entry = builder.GetInsertBlock();
+  BasicBlock* rhs_block = ctx_->CreateBasicBlock("logic.rhs", func);
+  BasicBlock* end = ctx_->CreateBasicBlock("logic.end", func);
+  if (is_and) {
+    ctx_->CreateBasicCondBr(left, rhs_block, end);
+  } else {
+    ctx_->CreateBasicCondBr(left, end, rhs_block);
+  }
+
+  ctx_->SetInsertPoint(rhs_block);
   Value* right = expr.right->Accept(*this);
+  rhs_block = builder.GetInsertBlock();
+  ctx_->CreateBr(end);
 
-  switch (expr.type->kind) {
-    case types::TypeKind::Int:
-      return ctx_->CreateIntBinop(expr.op.kind, left, right);
+  ctx_->SetInsertPoint(end);
+  PHINode* result = builder.CreatePHI(builder.getInt1Ty(), 2, "logic");
+  result->addIncoming(builder.getInt1(!is_and), entry);
+  result->addIncoming(right, rhs_block);
+  return result;
+}
+
+Value* Codegen::Visit(Unary& expr) {
+  if (expr.constant) {
+    return EmitConstant(*expr.constant, expr.type);
+  }
+  ctx_->DebugInfo().SetLocation(expr.op.location);
+  Value* operand = expr.operand->Accept(*this);
+  return ctx_->GetBuilder().CreateNot(operand);
+}
+
+Value* Codegen::Visit(IfExpr& expr) {
+  if (expr.constant) {
+    return EmitConstant(*expr.constant, expr.type);
+  }
+  auto& builder = ctx_->GetBuilder();
+  ctx_->DebugInfo().SetLocation(expr.if_token.location);
+  Value* cond = expr.cond->Accept(*this);
+
+  if (IsSpeculatable(expr.then.get()) && IsSpeculatable(expr.otherwise.get())) {
+    Value* then = EmitCoerced(*expr.then, expr.type);
+    Value* otherwise = EmitCoerced(*expr.otherwise, expr.type);
+    return builder.CreateSelect(cond, then, otherwise);
+  }
+
+  Function* func = ctx_->GetInsertBlockParent();
+  BasicBlock* then_block = ctx_->CreateBasicBlock("ifexpr.then", func);
+  BasicBlock* else_block = ctx_->CreateBasicBlock("ifexpr.else", func);
+  BasicBlock* end = ctx_->CreateBasicBlock("ifexpr.end", func);
+  ctx_->CreateBasicCondBr(cond, then_block, else_block);
+
+  ctx_->SetInsertPoint(then_block);
+  Value* then = EmitCoerced(*expr.then, expr.type);
+  then_block = builder.GetInsertBlock();
+  ctx_->CreateBr(end);
+
+  ctx_->SetInsertPoint(else_block);
+  Value* otherwise = EmitCoerced(*expr.otherwise, expr.type);
+  else_block = builder.GetInsertBlock();
+  ctx_->CreateBr(end);
+
+  ctx_->SetInsertPoint(end);
+  PHINode* result = builder.CreatePHI(then->getType(), 2, "ifexpr");
+  result->addIncoming(then, then_block);
+  result->addIncoming(otherwise, else_block);
+  return result;
+}
+
+Value* Codegen::Visit(Binary& expr) {
+  if (expr.constant) {
+    return EmitConstant(*expr.constant, expr.type);
+  }
+  ctx_->DebugInfo().SetLocation(expr.op.location);
+  Value* left = EmitCoerced(*expr.left, expr.type);
+  Value* right = EmitCoerced(*expr.right, expr.type);
+
+  types::Type* lane = LaneType(expr.type);
+  switch (lane->kind) {
+    case types::TypeKind::Int: {
+      auto* int_type = dynamic_cast<types::IntType*>(lane);
+      bool is_signed = !int_type || int_type->is_signed;
+      return ctx_->CreateIntBinop(expr.op.kind, left, right, is_signed);
+    }
     case types::TypeKind::Float:
       return ctx_->CreateFltBinop(expr.op.kind, left, right);
     default:
@@ -639,16 +1306,16 @@ Value* Codegen::Visit(PreFixOp& expr) {
     return nullptr;
   }
 
-  if (!bind.get()->GetAlloca()) {
+  Value* address = bind.get()->GetAddress();
+  if (!address) {
     return nullptr;
   }
 
-  AllocaInst* a = bind.get()->GetAlloca();
-  Type* type = a->getAllocatedType();
+  Type* type = bind.get()->GetValueType();
   std::string name = expr.name.lexeme;
 
-  Value* var = ctx_->CreateLoad(type, a, name);
-  Value* result = ctx_->CreatePreOp(expr.type, expr.op.kind, var, a);
+  Value* var = ctx_->CreateLoad(type, address, name);
+  Value* result = ctx_->CreatePreOp(expr.type, expr.op.kind, var, address);
   if (expr.HasID()) {
     auto it = di_locals_.find(expr.GetID());
     if (it != di_locals_.end()) {
@@ -671,12 +1338,12 @@ Value* Codegen::Visit(Assign& expr) {
     return nullptr;
   }
 
-  if (!var.get()->GetAlloca()) {
+  if (!var.get()->GetAddress()) {
     return nullptr;
   }
 
-  Value* value = expr.value->Accept(*this);
-  ctx_->CreateStore(value, var.get()->GetAlloca());
+  Value* value = EmitCoerced(*expr.value, expr.type);
+  ctx_->CreateStore(value, var.get()->GetAddress());
   if (expr.HasID()) {
     auto it = di_locals_.find(expr.GetID());
     if (it != di_locals_.end()) {
@@ -703,32 +1370,37 @@ Value* Codegen::Visit(MemberAssign& expr) {
     return nullptr;
   }
 
-  AllocaInst* slot = var.get()->GetAlloca();
+  Value* slot = var.get()->GetAddress();
   if (!slot) {
     return nullptr;
   }
 
-  Value* rhs = expr.value->Accept(*this);
+  Value* rhs = EmitCoerced(*expr.value, expr.target->type);
   if (!rhs) {
     return nullptr;
   }
 
-  Value* current =
-      ctx_->CreateLoad(slot->getAllocatedType(), slot, "struct.assign.current");
-  Value* updated = ctx_->GetBuilder().CreateInsertValue(
-      current, rhs, {static_cast<unsigned>(expr.target->field_index.value())},
-      "struct.assign.updated");
-  ctx_->CreateStore(updated, slot);
+  // Storing the one field keeps a struct behind a reference from being
+  // copied through registers.
+  Value* field = ctx_->GetBuilder().CreateStructGEP(
+      var.get()->GetValueType(), slot,
+      static_cast<unsigned>(expr.target->field_index.value()),
+      "struct.assign.field");
+  ctx_->CreateStore(rhs, field);
   return rhs;
 }
 
 Value* Codegen::Visit(CallExpr& expr) {
+  if (expr.constant) {
+    return EmitConstant(*expr.constant, expr.type);
+  }
   if (auto loc = ExprLocation(expr.callee.get())) {
     ctx_->DebugInfo().SetLocation(*loc);
   }
-  if (expr.type->kind == types::TypeKind::Struct) {
+  // A struct constructor names the struct itself rather than a function.
+  if (expr.callee->type && expr.callee->type->Struct()) {
     std::error_code ec;
-    expr.type->CastTo<types::StructType>(ec);
+    auto* struct_type = expr.type->CastTo<types::StructType>(ec);
     if (ec) {
       return nullptr;
     }
@@ -740,7 +1412,7 @@ Value* Codegen::Visit(CallExpr& expr) {
 
     Value* aggregate = UndefValue::get(llvm_struct_ty);
     for (size_t i = 0; i < expr.args.size(); ++i) {
-      Value* arg_value = expr.args[i]->Accept(*this);
+      Value* arg_value = EmitCoerced(*expr.args[i], struct_type->fields[i]);
       aggregate = ctx_->GetBuilder().CreateInsertValue(
           aggregate, arg_value, {static_cast<unsigned>(i)});
     }
@@ -752,26 +1424,249 @@ Value* Codegen::Visit(CallExpr& expr) {
     return nullptr;
   }
 
+  auto* func_type = dynamic_cast<types::FunctionType*>(expr.callee->type);
+  FuncBinding* binding = CalleeBinding(*expr.callee);
+  bool is_extern = binding && binding->is_extern;
   std::vector<Value*> call_args;
-  for (auto& arg : expr.args) {
-    call_args.push_back(arg->Accept(*this));
+  std::vector<Value*> copies;
+
+  // A struct returned through memory lands in a slot of the caller; a tail
+  // call hands on the slot the caller itself was given.
+  AllocaInst* result_slot = nullptr;
+  if (callee->hasStructRetAttr() && expr.is_tail && return_slot_) {
+    call_args.push_back(return_slot_);
+  } else if (callee->hasStructRetAttr()) {
+    result_slot = ctx_->CreateAlloca(callee->getParamStructRetType(0), nullptr,
+                                     "call.result");
+    call_args.push_back(result_slot);
+  }
+  unsigned first = static_cast<unsigned>(call_args.size());
+  unsigned fixed_params = callee->getFunctionType()->getNumParams() - first;
+  for (size_t i = 0; i < expr.args.size(); ++i) {
+    Expr& arg = *expr.args[i];
+    bool is_variadic = i >= fixed_params;
+    types::Type* param =
+        func_type && !is_variadic ? func_type->params[i] : nullptr;
+    CAbiArg lowering;
+    if (binding && i < binding->abi.params.size()) {
+      lowering = binding->abi.params[i];
+    }
+    Value* value = nullptr;
+    if (is_variadic) {
+      value = arg.Accept(*this);
+    } else if (param && param->Reference()) {
+      value = EmitAddress(arg);
+    } else if (lowering.kind == CAbiArg::Kind::Indirect) {
+      // Sema keeps `byval` arguments out of `return tail` calls.
+      value = EmitIndirectArg(arg, param, lowering.byval);
+    } else {
+      value = EmitCoerced(arg, param);
+    }
+    if (is_extern && arg.type && arg.type->String()) {
+      value = EmitCString(value, copies);
+    }
+    if (value && lowering.kind == CAbiArg::Kind::Coerce) {
+      value = EmitMemoryCoercion(value, lowering.type);
+    }
+    call_args.push_back(is_variadic ? PromoteVariadicArg(value, arg.type)
+                                    : value);
+  }
+
+  if (expr.is_tail) {
+    // Sema only allows tail calls between cinder functions of one signature,
+    // so the result needs no conversion before the caller's `ret`.
+    // `musttail` also wants the `sret` slot marked on the call itself.
+    CallInst* call = ctx_->CreateVoidCall(callee, call_args);
+    call->setAttributes(callee->getAttributes());
+    call->setTailCallKind(CallInst::TCK_MustTail);
+    return call;
+  }
+
+  if (result_slot) {
+    ctx_->CreateVoidCall(callee, call_args);
+    FreeCStrings(copies);
+    return ctx_->CreateLoad(result_slot->getAllocatedType(), result_slot,
+                            "call.result.value");
   }
 
   if (expr.type->kind == types::TypeKind::Void) {
-    return ctx_->CreateVoidCall(callee, call_args);
+    CallInst* call = ctx_->CreateVoidCall(callee, call_args);
+    FreeCStrings(copies);
+    return call;
+  }
+
+  Value* result = ctx_->CreateCall(callee, call_args, callee->getName());
+  FreeCStrings(copies);
+  if (binding && binding->abi.ret.kind == CAbiArg::Kind::Coerce) {
+    result = EmitMemoryCoercion(result, ResolveType(expr.type));
+  }
+  if (is_extern && expr.type->String()) {
+    return EmitStringFromC(result);
+  }
+  return result;
+}
+
+FuncBinding* Codegen::CalleeBinding(Expr& callee) {
+  if (!callee.HasID()) {
+    return nullptr;
+  }
+  auto it = ir_bindings_.find(callee.GetID());
+  if (it == ir_bindings_.end() || !it->second || !it->second->IsFunction()) {
+    return nullptr;
+  }
+  ErrorOr<FuncBinding*> f = it->second->CastTo<FuncBinding>();
+  return f.getError() ? nullptr : f.get();
+}
+
+Value* Codegen::EmitMemoryCoercion(Value* value, Type* type) {
+  const DataLayout& layout = ctx_->GetModule().getDataLayout();
+  Type* from = value->getType();
+  // The slot must hold whichever of the two types is larger.
+  Type* slot_type =
+      layout.getTypeAllocSize(type) > layout.getTypeAllocSize(from) ? type
+                                                                     : from;
+  AllocaInst* slot = ctx_->CreateAlloca(slot_type, nullptr, "abi.coerce");
+  slot->setAlignment(
+      std::max(layout.getABITypeAlign(type), layout.getABITypeAlign(from)));
+  ctx_->CreateStore(value, slot);
+  return ctx_->CreateLoad(type, slot, "abi.coerced");
+}
+
+Value* Codegen::EmitCString(Value* text, std::vector<Value*>& copies) {
+  auto& builder = ctx_->GetBuilder();
+  Value* data = builder.CreateExtractValue(text, {0}, "str.data");
+  if (isa<Constant>(text)) {
+    // Pooled literals are stored with their terminator.
+    return data;
+  }
+  Value* length = builder.CreateExtractValue(text, {1}, "str.len");
+
+  // Every `str` lies within a buffer whose terminator follows its last
+  // byte, so the byte at `data[len]` is always readable.
+  Type* i8 = builder.getInt8Ty();
+  Type* ptr = PointerType::getUnqual(ctx_->GetContext());
+  Function* func = ctx_->GetInsertBlockParent();
+  BasicBlock* entry = builder.GetInsertBlock();
+  BasicBlock* check = ctx_->CreateBasicBlock("cstr.check", func);
+  BasicBlock* copy = ctx_->CreateBasicBlock("cstr.copy", func);
+  BasicBlock* done = ctx_->CreateBasicBlock("cstr.done", func);
+  ctx_->CreateBasicCondBr(builder.CreateIsNull(data), done, check);
+
+  ctx_->SetInsertPoint(check);
+  Value* last = builder.CreateGEP(i8, data, length, "str.end");
+  Value* terminated = builder.CreateICmpEQ(builder.CreateLoad(i8, last),
+                                           builder.getInt8(0), "terminated");
+  ctx_->CreateBasicCondBr(terminated, done, copy,
+                          BranchWeights(BranchHint::Likely));
+
+  ctx_->SetInsertPoint(copy);
+  FunctionCallee malloc = RuntimeFunc(
+      "malloc", FunctionType::get(ptr, {builder.getInt64Ty()}, false));
+  Value* size = builder.CreateAdd(length, builder.getInt64(1), "cstr.size");
+  Value* buffer = builder.CreateCall(malloc, {size}, "cstr.buf");
+  builder.CreateMemCpy(buffer, MaybeAlign(1), data, MaybeAlign(1), length);
+  builder.CreateStore(builder.getInt8(0),
+                      builder.CreateGEP(i8, buffer, length, "cstr.end"));
+  ctx_->CreateBr(done);
+
+  ctx_->SetInsertPoint(done);
+  PHINode* cstr = builder.CreatePHI(ptr, 3, "cstr");
+  cstr->addIncoming(data, entry);
+  cstr->addIncoming(data, check);
+  cstr->addIncoming(buffer, copy);
+  PHINode* owned = builder.CreatePHI(ptr, 3, "cstr.owned");
+  owned->addIncoming(ConstantPointerNull::get(cast<PointerType>(ptr)), entry);
+  owned->addIncoming(ConstantPointerNull::get(cast<PointerType>(ptr)), check);
+  owned->addIncoming(buffer, copy);
+  copies.push_back(owned);
+  return cstr;
+}
+
+void Codegen::FreeCStrings(const std::vector<Value*>& copies) {
+  auto& builder = ctx_->GetBuilder();
+  Type* ptr = PointerType::getUnqual(ctx_->GetContext());
+  for (Value* owned : copies) {
+    Function* func = ctx_->GetInsertBlockParent();
+    BasicBlock* release = ctx_->CreateBasicBlock("cstr.free", func);
+    BasicBlock* next = ctx_->CreateBasicBlock("cstr.next", func);
+    ctx_->CreateBasicCondBr(builder.CreateIsNotNull(owned), release, next,
+                            BranchWeights(BranchHint::Unlikely));
+    ctx_->SetInsertPoint(release);
+    FunctionCallee free = RuntimeFunc(
+        "free", FunctionType::get(builder.getVoidTy(), {ptr}, false));
+    builder.CreateCall(free, {owned});
+    ctx_->CreateBr(next);
+    ctx_->SetInsertPoint(next);
+  }
+}
+
+FunctionCallee Codegen::RuntimeFunc(StringRef name, FunctionType* type) {
+  Function* func = ctx_->CreatePublicFunc(type, name);
+  if (!func) {
+    ostream::ErrorOutln(errors,
+                        "Extern declaration conflicts with runtime use:",
+                        name.str());
   }
+  return func;
+}
+
+Value* Codegen::EmitStringFromC(Value* ptr) {
+  auto& builder = ctx_->GetBuilder();
+  Function* func = ctx_->GetInsertBlockParent();
+  BasicBlock* entry = builder.GetInsertBlock();
+  BasicBlock* measure = ctx_->CreateBasicBlock("cstr.measure", func);
+  BasicBlock* done = ctx_->CreateBasicBlock("cstr.measured", func);
+  // A null `char*` becomes the empty string.
+  ctx_->CreateBasicCondBr(builder.CreateIsNull(ptr), done, measure);
+
+  ctx_->SetInsertPoint(measure);
+  FunctionCallee strlen = RuntimeFunc(
+      "strlen",
+      FunctionType::get(builder.getInt64Ty(), {ptr->getType()}, false));
+  Value* measured = builder.CreateCall(strlen, {ptr}, "cstr.len");
+  ctx_->CreateBr(done);
+
+  ctx_->SetInsertPoint(done);
+  PHINode* length = builder.CreatePHI(builder.getInt64Ty(), 2, "str.len");
+  length->addIncoming(builder.getInt64(0), entry);
+  length->addIncoming(measured, measure);
+  return EmitSlice(ptr, length);
+}
 
-  return ctx_->CreateCall(callee, call_args, callee->getName());
+/// C default argument promotions for values passed through `...`.
+Value* Codegen::PromoteVariadicArg(Value* value, types::Type* type) {
+  if (!value) {
+    return nullptr;
+  }
+  auto& builder = ctx_->GetBuilder();
+  Type* ty = value->getType();
+  if (ty->isFloatTy()) {
+    return builder.CreateFPExt(value, builder.getDoubleTy(), "vararg.ext");
+  }
+  if (ty->isIntegerTy() && ty->getIntegerBitWidth() < 32) {
+    auto* int_type = dynamic_cast<types::IntType*>(type);
+    bool is_signed = int_type && int_type->is_signed;
+    return builder.CreateIntCast(value, builder.getInt32Ty(), is_signed,
+                                 "vararg.ext");
+  }
+  return value;
 }
 
 Value* Codegen::Visit(MemberAccess& expr) {
+  if (expr.constant) {
+    return EmitConstant(*expr.constant, expr.type);
+  }
   ctx_->DebugInfo().SetLocation(expr.member.location);
-  if (expr.field_index.has_value()) {
-    Value* object = expr.object->Accept(*this);
-    if (!object) {
-      return nullptr;
-    }
+  if (expr.object->type &&
+      (expr.object->type->Array() || expr.object->type->Slice() ||
+       expr.object->type->String())) {
+    return EmitLength(*expr.object);
+  }
+  if (expr.object->type && expr.object->type->Vector()) {
+    return EmitReduction(expr);
+  }
 
+  if (expr.field_index.has_value()) {
     std::error_code ec;
     auto* struct_ty = expr.object->type->CastTo<types::StructType>(ec);
     if (ec) {
@@ -783,9 +1678,19 @@ Value* Codegen::Visit(MemberAccess& expr) {
       return nullptr;
     }
 
+    // Fields of stored structs are loaded alone rather than through a copy
+    // of the whole struct.
+    const std::string& name = struct_ty->field_names[expr.field_index.value()];
+    if (Value* field = EmitAddress(expr)) {
+      return ctx_->CreateLoad(ResolveType(expr.type), field, name);
+    }
+
+    Value* object = expr.object->Accept(*this);
+    if (!object) {
+      return nullptr;
+    }
     return ctx_->GetBuilder().CreateExtractValue(
-        object, {static_cast<unsigned>(expr.field_index.value())},
-        struct_ty->field_names[expr.field_index.value()]);
+        object, {static_cast<unsigned>(expr.field_index.value())}, name);
   }
 
   if (!expr.HasID()) {
@@ -793,7 +1698,22 @@ Value* Codegen::Visit(MemberAccess& expr) {
   }
 
   auto it = ir_bindings_.find(expr.GetID());
-  if (it == ir_bindings_.end() || !it->second || !it->second->IsFunction()) {
+  if (it == ir_bindings_.end() || !it->second) {
+    return nullptr;
+  }
+
+  // A qualified global reads like a local variable.
+  if (it->second->IsVariable()) {
+    ErrorOr<VarBinding*> v = it->second->CastTo<VarBinding>();
+    if (v.getError() || !v.get()->GetAddress()) {
+      return nullptr;
+    }
+    return ctx_->GetBuilder().CreateLoad(v.get()->GetValueType(),
+                                         v.get()->GetAddress(),
+                                         expr.member.lexeme);
+  }
+
+  if (!it->second->IsFunction()) {
     return nullptr;
   }
 
@@ -806,6 +1726,9 @@ Value* Codegen::Visit(MemberAccess& expr) {
 }
 
 Value* Codegen::Visit(Grouping& expr) {
+  if (expr.constant) {
+    return EmitConstant(*expr.constant, expr.type);
+  }
   if (auto loc = ExprLocation(expr.expr.get())) {
     ctx_->DebugInfo().SetLocation(*loc);
   }
@@ -813,6 +1736,9 @@ Value* Codegen::Visit(Grouping& expr) {
 }
 
 Value* Codegen::Visit(Variable& expr) {
+  if (expr.constant) {
+    return EmitConstant(*expr.constant, expr.type);
+  }
   ctx_->DebugInfo().SetLocation(expr.name.location);
   if (expr.HasID()) {
     auto it = ir_bindings_.find(expr.id.value());
@@ -827,11 +1753,11 @@ Value* Codegen::Visit(Variable& expr) {
       }
       if (b->IsVariable()) {
         ErrorOr<VarBinding*> v = b->CastTo<VarBinding>();
-        if (!v.get()->GetAlloca()) {
+        if (!v.get()->GetAddress()) {
           return nullptr;
         }
-        AllocaInst* a = v.get()->GetAlloca();
-        return ctx_->GetBuilder().CreateLoad(a->getAllocatedType(), a,
+        return ctx_->GetBuilder().CreateLoad(v.get()->GetValueType(),
+                                             v.get()->GetAddress(),
                                              expr.name.lexeme);
       }
     }
@@ -858,13 +1784,12 @@ Value* Codegen::Visit(Literal& expr) {
       return ConstantInt::getBool(ctx_->GetContext(),
                                   std::get<bool>(expr.value));
     case types::TypeKind::Float:
-      return ConstantFP::get(ctx_->GetContext(),
-                             APFloat(std::get<float>(expr.value)));
+      return ConstantFP::get(ResolveType(expr.type),
+                             std::get<double>(expr.value));
     case types::TypeKind::Int:
       return EmitInteger(expr);
     case types::TypeKind::String:
-      return ctx_->GetBuilder().CreateGlobalString(
-          std::get<std::string>(expr.value), "", true);
+      return EmitStringLiteral(std::get<std::string>(expr.value));
     case types::TypeKind::Struct:
     case types::TypeKind::Void:
     default:
@@ -873,10 +1798,770 @@ Value* Codegen::Visit(Literal& expr) {
   return nullptr;
 }
 
+Value* Codegen::Visit(IndexAccess& expr) {
+  ctx_->DebugInfo().SetLocation(expr.bracket.location);
+  if (expr.object->type->Vector()) {
+    Value* vector = expr.object->Accept(*this);
+    Value* lane = EmitLaneIndex(expr);
+    if (!vector || !lane) {
+      return nullptr;
+    }
+    return ctx_->GetBuilder().CreateExtractElement(vector, lane, "lane");
+  }
+  Value* ptr = EmitElementPtr(expr);
+  if (!ptr) {
+    return nullptr;
+  }
+  return ctx_->CreateLoad(ResolveType(expr.type), ptr, "elem");
+}
+
+Value* Codegen::Visit(IndexAssign& expr) {
+  ctx_->DebugInfo().SetLocation(expr.target->bracket.location);
+  Value* value = EmitCoerced(*expr.value, expr.type);
+  if (expr.target->object->type->Vector()) {
+    // A lane store rewrites the whole vector in its slot.
+    Value* slot = EmitArrayAddress(*expr.target->object);
+    Value* lane = EmitLaneIndex(*expr.target);
+    if (!value || !slot || !lane) {
+      return nullptr;
+    }
+    Type* vector_ty = ResolveType(expr.target->object->type);
+    Value* vector = ctx_->CreateLoad(vector_ty, slot, "vec");
+    ctx_->CreateStore(
+        ctx_->GetBuilder().CreateInsertElement(vector, value, lane, "vec.ins"),
+        slot);
+    return value;
+  }
+  Value* ptr = EmitElementPtr(*expr.target);
+  if (!value || !ptr) {
+    return nullptr;
+  }
+  ctx_->CreateStore(value, ptr);
+  return value;
+}
+
+Value* Codegen::Visit(SliceExpr& expr) {
+  ctx_->DebugInfo().SetLocation(expr.bracket.location);
+  auto& builder = ctx_->GetBuilder();
+  Value* data = nullptr;
+  Value* length = nullptr;
+  Type* element_ty = builder.getInt8Ty();
+  if (auto* array = dynamic_cast<types::ArrayType*>(expr.object->type)) {
+    data = EmitArrayAddress(*expr.object);
+    length = builder.getInt64(array->length);
+    element_ty = ResolveType(array->element);
+  } else {
+    Value* view = expr.object->Accept(*this);
+    if (!view) {
+      return nullptr;
+    }
+    data = builder.CreateExtractValue(view, {0}, "view.data");
+    length = builder.CreateExtractValue(view, {1}, "view.len");
+    if (auto* slice = dynamic_cast<types::SliceType*>(expr.object->type)) {
+      element_ty = ResolveType(slice->element);
+    }
+  }
+  if (!data) {
+    return nullptr;
+  }
+
+  auto bound = [&](Expr* value, Value* omitted) -> Value* {
+    if (!value) {
+      return omitted;
+    }
+    Value* raw = value->Accept(*this);
+    if (!raw) {
+      return nullptr;
+    }
+    auto* int_type = dynamic_cast<types::IntType*>(value->type);
+    bool is_signed = !int_type || int_type->is_signed;
+    return builder.CreateIntCast(raw, builder.getInt64Ty(), is_signed,
+                                 "slice.bound");
+  };
+  Value* start = bound(expr.start.get(), builder.getInt64(0));
+  Value* end = bound(expr.end.get(), length);
+  if (!start || !end) {
+    return nullptr;
+  }
+
+  if (opts.bounds_checks != CodegenOpts::BoundsChecks::OFF) {
+    // Unsigned compares also reject negative bounds. The report names the
+    // end when it overruns, otherwise the start that passes it.
+    Value* end_ok = builder.CreateICmpULE(end, length, "end.ok");
+    Value* in_range = builder.CreateAnd(
+        end_ok, builder.CreateICmpULE(start, end, "start.ok"), "in.bounds");
+    EmitBoundsCheck(in_range, builder.CreateSelect(end_ok, start, end),
+                    length, expr.bracket.location.line);
+  }
+  Value* first =
+      builder.CreateInBoundsGEP(element_ty, data, start, "slice.data");
+  return EmitSlice(first, builder.CreateSub(end, start, "slice.len"));
+}
+
+Value* Codegen::Visit(ArrayLiteral& expr) {
+  ctx_->DebugInfo().SetLocation(expr.bracket.location);
+  if (auto* vector = dynamic_cast<types::VectorType*>(expr.type)) {
+    // Lanes past the end of a short literal stay zero.
+    Value* result = Constant::getNullValue(ResolveType(expr.type));
+    for (size_t i = 0; i < expr.elements.size(); ++i) {
+      Value* lane = EmitCoerced(*expr.elements[i], vector->element);
+      result = ctx_->GetBuilder().CreateInsertElement(
+          result, lane, ctx_->GetBuilder().getInt64(i));
+    }
+    return result;
+  }
+  auto* array = dynamic_cast<types::ArrayType*>(expr.type);
+  Value* aggregate = UndefValue::get(ResolveType(expr.type));
+  for (size_t i = 0; i < expr.elements.size(); ++i) {
+    Value* element = EmitCoerced(*expr.elements[i], array->element);
+    aggregate = ctx_->GetBuilder().CreateInsertValue(
+        aggregate, element, {static_cast<unsigned>(i)});
+  }
+  return aggregate;
+}
+
+Value* Codegen::Visit(Cast& expr) {
+  if (expr.constant) {
+    return EmitConstant(*expr.constant, expr.type);
+  }
+  ctx_->DebugInfo().SetLocation(expr.target.location);
+  return EmitConversion(expr.value->Accept(*this), expr.value->type,
+                        expr.type);
+}
+
+Value* Codegen::Visit(IntrinsicCall& expr) {
+  ctx_->DebugInfo().SetLocation(expr.name.location);
+  auto& builder = ctx_->GetBuilder();
+  if (expr.kind == IntrinsicKind::Prefetch) {
+    auto* access = dynamic_cast<IndexAccess*>(expr.args[0].get());
+    Value* ptr = EmitElementPtr(*access, /*checked=*/false);
+    if (!ptr) {
+      return nullptr;
+    }
+    // Read access, maximal temporal locality, data cache.
+    return builder.CreateIntrinsic(
+        Intrinsic::prefetch, {ptr->getType()},
+        {ptr, builder.getInt32(0), builder.getInt32(3), builder.getInt32(1)});
+  }
+
+  std::vector<Value*> args;
+  for (auto& arg : expr.args) {
+    Value* value = EmitCoerced(*arg, expr.type);
+    if (!value) {
+      return nullptr;
+    }
+    args.push_back(value);
+  }
+  auto* int_type = dynamic_cast<types::IntType*>(LaneType(expr.type));
+  bool is_signed = int_type && int_type->is_signed;
+  switch (*expr.kind) {
+    case IntrinsicKind::Sqrt:
+      return builder.CreateUnaryIntrinsic(Intrinsic::sqrt, args[0]);
+    case IntrinsicKind::Fma:
+      return builder.CreateIntrinsic(Intrinsic::fma, {args[0]->getType()},
+                                     args);
+    case IntrinsicKind::Floor:
+      return builder.CreateUnaryIntrinsic(Intrinsic::floor, args[0]);
+    case IntrinsicKind::Ceil:
+      return builder.CreateUnaryIntrinsic(Intrinsic::ceil, args[0]);
+    case IntrinsicKind::Abs:
+      if (!int_type) {
+        return builder.CreateUnaryIntrinsic(Intrinsic::fabs, args[0]);
+      }
+      // Unsigned values are their own magnitude; `abs(INT_MIN)` wraps.
+      return is_signed ? builder.CreateBinaryIntrinsic(
+                             Intrinsic::abs, args[0], builder.getFalse())
+                       : args[0];
+    case IntrinsicKind::Min:
+    case IntrinsicKind::Max: {
+      bool is_min = *expr.kind == IntrinsicKind::Min;
+      Intrinsic::ID id = is_min ? Intrinsic::minnum : Intrinsic::maxnum;
+      if (int_type) {
+        id = is_min ? (is_signed ? Intrinsic::smin : Intrinsic::umin)
+                    : (is_signed ? Intrinsic::smax : Intrinsic::umax);
+      }
+      return builder.CreateBinaryIntrinsic(id, args[0], args[1]);
+    }
+    case IntrinsicKind::Popcount:
+      return builder.CreateUnaryIntrinsic(Intrinsic::ctpop, args[0]);
+    // A zero operand yields the bit width rather than poison.
+    case IntrinsicKind::Ctz:
+      return builder.CreateBinaryIntrinsic(Intrinsic::cttz, args[0],
+                                           builder.getFalse());
+    case IntrinsicKind::Clz:
+      return builder.CreateBinaryIntrinsic(Intrinsic::ctlz, args[0],
+                                           builder.getFalse());
+    case IntrinsicKind::Expect:
+      return builder.CreateBinaryIntrinsic(Intrinsic::expect, args[0],
+                                           args[1]);
+    case IntrinsicKind::Prefetch:
+      break;
+  }
+  UNREACHABLE(Codegen, VisitIntrinsicCall);
+  return nullptr;
+}
+
+Value* Codegen::Visit(NewArray& expr) {
+  ctx_->DebugInfo().SetLocation(expr.keyword.location);
+  auto& builder = ctx_->GetBuilder();
+  auto* slice = dynamic_cast<types::SliceType*>(expr.type);
+  Type* element_ty = ResolveType(slice->element);
+
+  Value* length = expr.length->Accept(*this);
+  auto* length_type = dynamic_cast<types::IntType*>(expr.length->type);
+  bool is_signed = !length_type || length_type->is_signed;
+  Value* count = builder.CreateIntCast(length, builder.getInt64Ty(), is_signed,
+                                       "slice.len");
+  uint64_t element_size = ctx_->GetModule()
+                              .getDataLayout()
+                              .getTypeAllocSize(element_ty)
+                              .getFixedValue();
+
+  // calloc keeps fresh slices zeroed, matching array literal padding.
+  FunctionCallee calloc = RuntimeFunc(
+      "calloc", FunctionType::get(PointerType::getUnqual(ctx_->GetContext()),
+                                  {builder.getInt64Ty(), builder.getInt64Ty()},
+                                  false));
+  Value* data = builder.CreateCall(
+      calloc, {count, builder.getInt64(element_size)}, "slice.data");
+  return EmitSlice(data, count);
+}
+
+Value* Codegen::EmitSlice(Value* data, Value* length) {
+  auto& builder = ctx_->GetBuilder();
+  Value* slice = UndefValue::get(SliceStructType());
+  slice = builder.CreateInsertValue(slice, data, {0});
+  return builder.CreateInsertValue(slice, length, {1}, "slice");
+}
+
+Constant* Codegen::EmitStringLiteral(const std::string& text) {
+  Constant* fields[] = {
+      ctx_->InternString(text),
+      ConstantInt::get(Type::getInt64Ty(ctx_->GetContext()), text.size())};
+  return ConstantStruct::get(SliceStructType(), fields);
+}
+
+Value* Codegen::EmitLength(Expr& expr) {
+  auto& builder = ctx_->GetBuilder();
+  if (uint64_t length = expr.type->FixedLength()) {
+    return builder.getInt32(static_cast<uint32_t>(length));
+  }
+  Value* slice = expr.Accept(*this);
+  if (!slice) {
+    return nullptr;
+  }
+  Value* length = builder.CreateExtractValue(slice, {1}, "slice.len");
+  return builder.CreateTrunc(length, builder.getInt32Ty(), "len");
+}
+
+Value* Codegen::EmitAddress(Expr& expr) {
+  if (auto* group = dynamic_cast<Grouping*>(&expr)) {
+    return EmitAddress(*group->expr);
+  }
+  if (auto* index = dynamic_cast<IndexAccess*>(&expr)) {
+    if (index->object->type->Vector()) {
+      return nullptr;
+    }
+    return EmitElementPtr(*index);
+  }
+  if (auto* member = dynamic_cast<MemberAccess*>(&expr);
+      member && member->field_index.has_value()) {
+    Value* object = EmitAddress(*member->object);
+    if (!object) {
+      return nullptr;
+    }
+    return ctx_->GetBuilder().CreateStructGEP(
+        ResolveType(member->object->type), object,
+        static_cast<unsigned>(member->field_index.value()),
+        member->member.lexeme + ".addr");
+  }
+  // Qualified globals (`mod.TABLE`) carry their symbol on the access.
+  if ((expr.IsVariable() || expr.IsMemberAccess()) && expr.HasID()) {
+    auto it = ir_bindings_.find(expr.GetID());
+    if (it != ir_bindings_.end() && it->second && it->second->IsVariable()) {
+      ErrorOr<VarBinding*> var = it->second->CastTo<VarBinding>();
+      if (!var.getError()) {
+        return var.get()->GetAddress();
+      }
+    }
+  }
+  return nullptr;
+}
+
+Value* Codegen::EmitIndirectArg(Expr& expr, types::Type* type, bool byval) {
+  if (byval) {
+    if (Value* address = EmitAddress(expr)) {
+      return address;
+    }
+  }
+  Value* value = EmitCoerced(expr, type);
+  if (!value) {
+    return nullptr;
+  }
+  AllocaInst* temp = ctx_->CreateAlloca(value->getType(), nullptr, "arg.tmp");
+  ctx_->CreateStore(value, temp);
+  return temp;
+}
+
+bool Codegen::PassesIndirectly(types::Type* type) {
+  if (!type || !type->Struct()) {
+    return false;
+  }
+  Type* llvm_type = ResolveType(type);
+  return llvm_type &&
+         ctx_->GetModule().getDataLayout().getTypeAllocSize(llvm_type) > 16;
+}
+
+Value* Codegen::EmitArrayAddress(Expr& expr) {
+  if (Value* address = EmitAddress(expr)) {
+    return address;
+  }
+
+  // Rvalue arrays (literals, call results) get a temporary home.
+  Value* value = expr.Accept(*this);
+  if (!value) {
+    return nullptr;
+  }
+  AllocaInst* temp = ctx_->CreateAlloca(value->getType(), nullptr, "array.tmp");
+  ctx_->CreateStore(value, temp);
+  return temp;
+}
+
+Value* Codegen::EmitElementPtr(IndexAccess& expr, bool checked) {
+  auto& builder = ctx_->GetBuilder();
+  bool is_array = expr.object->type->Array();
+  Value* base = is_array ? EmitArrayAddress(*expr.object)
+                         : expr.object->Accept(*this);
+  Value* index = expr.index->Accept(*this);
+  if (!base || !index) {
+    return nullptr;
+  }
+
+  // 64-bit inbounds offsets let SCEV model the address as an affine
+  // recurrence of the induction variable, which the vectorizer relies on.
+  auto* int_type = dynamic_cast<types::IntType*>(expr.index->type);
+  bool is_signed = !int_type || int_type->is_signed;
+  Value* offset =
+      builder.CreateIntCast(index, builder.getInt64Ty(), is_signed, "idx");
+
+  if (checked && NeedsBoundsCheck(expr)) {
+    Value* length =
+        is_array
+            ? builder.getInt64(
+                  dynamic_cast<types::ArrayType*>(expr.object->type)->length)
+            : builder.CreateExtractValue(base, {1}, "slice.len");
+    // A single unsigned compare also rejects negative indices.
+    EmitBoundsCheck(builder.CreateICmpULT(offset, length, "in.bounds"),
+                    offset, length, expr.bracket.location.line);
+  }
+
+  if (is_array) {
+    std::vector<Value*> indices = {builder.getInt64(0), offset};
+    Type* array_ty = ResolveType(expr.object->type);
+    return checked ? builder.CreateInBoundsGEP(array_ty, base, indices,
+                                               "elem.ptr")
+                   : builder.CreateGEP(array_ty, base, indices, "elem.ptr");
+  }
+  Value* data = builder.CreateExtractValue(base, {0}, "slice.data");
+  Type* element_ty = ResolveType(expr.type);
+  return checked
+             ? builder.CreateInBoundsGEP(element_ty, data, offset, "elem.ptr")
+             : builder.CreateGEP(element_ty, data, offset, "elem.ptr");
+}
+
+Value* Codegen::EmitLaneIndex(IndexAccess& expr) {
+  auto& builder = ctx_->GetBuilder();
+  Value* index = expr.index->Accept(*this);
+  if (!index) {
+    return nullptr;
+  }
+  auto* int_type = dynamic_cast<types::IntType*>(expr.index->type);
+  bool is_signed = !int_type || int_type->is_signed;
+  Value* offset =
+      builder.CreateIntCast(index, builder.getInt64Ty(), is_signed, "lane.idx");
+
+  if (NeedsBoundsCheck(expr)) {
+    Value* lanes = builder.getInt64(expr.object->type->FixedLength());
+    EmitBoundsCheck(builder.CreateICmpULT(offset, lanes, "in.bounds"), offset,
+                    lanes, expr.bracket.location.line);
+  }
+  return offset;
+}
+
+Value* Codegen::EmitReduction(MemberAccess& expr) {
+  auto& builder = ctx_->GetBuilder();
+  const std::string& member = expr.member.lexeme;
+  if (member == "len") {
+    return EmitLength(*expr.object);
+  }
+  Value* vector = expr.object->Accept(*this);
+  if (!vector) {
+    return nullptr;
+  }
+
+  if (member == "any") {
+    return builder.CreateOrReduce(vector);
+  }
+  if (member == "all") {
+    return builder.CreateAndReduce(vector);
+  }
+  types::Type* lane = LaneType(expr.object->type);
+  if (auto* int_type = dynamic_cast<types::IntType*>(lane)) {
+    if (member == "sum") {
+      return builder.CreateAddReduce(vector);
+    }
+    return member == "max"
+               ? builder.CreateIntMaxReduce(vector, int_type->is_signed)
+               : builder.CreateIntMinReduce(vector, int_type->is_signed);
+  }
+  if (member == "sum") {
+    // Lanes are added pairwise, as a hand-written horizontal add would.
+    CallInst* sum = builder.CreateFAddReduce(
+        ConstantFP::getNegativeZero(ResolveType(lane)), vector);
+    sum->setHasAllowReassoc(true);
+    return sum;
+  }
+  return member == "max" ? builder.CreateFPMaxReduce(vector)
+                         : builder.CreateFPMinReduce(vector);
+}
+
+bool Codegen::NeedsBoundsCheck(IndexAccess& expr) {
+  switch (opts.bounds_checks) {
+    case CodegenOpts::BoundsChecks::OFF:
+      return false;
+    case CodegenOpts::BoundsChecks::ON:
+      return expr.bounds != BoundsCheck::Proven;
+    case CodegenOpts::BoundsChecks::HOIST:
+      return expr.bounds == BoundsCheck::Required;
+  }
+  return true;
+}
+
+void Codegen::EmitBoundsCheck(Value* in_range, Value* index, Value* length,
+                              size_t line) {
+  auto& builder = ctx_->GetBuilder();
+  Function* func = ctx_->GetInsertBlockParent();
+  BasicBlock* fail_block = ctx_->CreateBasicBlock("bounds.fail", func);
+  BasicBlock* ok_block = ctx_->CreateBasicBlock("bounds.ok", func);
+  ctx_->CreateBasicCondBr(in_range, ok_block, fail_block,
+                          BranchWeights(BranchHint::Likely));
+
+  ctx_->SetInsertPoint(fail_block);
+  builder.CreateCall(BoundsFailHandler(),
+                     {builder.getInt32(static_cast<uint32_t>(line)), index,
+                      length});
+  builder.CreateUnreachable();
+  ctx_->SetInsertPoint(ok_block);
+}
+
+void Codegen::EmitHoistedBoundsChecks(ForStmt& stmt) {
+  auto& builder = ctx_->GetBuilder();
+  auto* init = dynamic_cast<VarDeclarationStmt*>(stmt.initializer.get());
+  auto it = ir_bindings_.find(*init->id);
+  if (it == ir_bindings_.end() || !it->second || !it->second->IsVariable()) {
+    return;
+  }
+  ErrorOr<VarBinding*> var = it->second->CastTo<VarBinding>();
+  if (var.getError() || !var.get()->GetAlloca()) {
+    return;
+  }
+
+  auto widen = [&](Value* value, types::Type* type) {
+    auto* int_type = dynamic_cast<types::IntType*>(type);
+    bool is_signed = !int_type || int_type->is_signed;
+    return builder.CreateIntCast(value, builder.getInt64Ty(), is_signed);
+  };
+
+  AllocaInst* slot = var.get()->GetAlloca();
+  Value* start = widen(
+      ctx_->CreateLoad(slot->getAllocatedType(), slot, "range.start"),
+      init->resolved_type);
+  Value* bound = stmt.range_bound->Accept(*this);
+  if (!bound) {
+    return;
+  }
+  bound = widen(bound, stmt.range_bound->type);
+  Value* runs = builder.CreateICmpSLT(start, bound, "range.runs");
+  Value* last = builder.CreateSub(bound, builder.getInt64(1), "range.last");
+
+  for (IndexAccess* access : stmt.hoisted_checks) {
+    Value* low = start;
+    Value* high = last;
+    if (access->loop_offset) {
+      Value* offset = access->loop_offset->Accept(*this);
+      if (!offset) {
+        return;
+      }
+      offset = widen(offset, access->loop_offset->type);
+      low = builder.CreateAdd(low, offset, "range.low");
+      high = builder.CreateAdd(high, offset, "range.high");
+    }
+
+    Value* length = nullptr;
+    if (uint64_t fixed = access->object->type->FixedLength()) {
+      length = builder.getInt64(fixed);
+    } else {
+      Value* slice = access->object->Accept(*this);
+      if (!slice) {
+        return;
+      }
+      length = builder.CreateExtractValue(slice, {1}, "slice.len");
+    }
+
+    Value* low_ok = builder.CreateICmpSGE(low, builder.getInt64(0));
+    Value* high_ok = builder.CreateICmpSLT(high, length);
+    Value* in_range = builder.CreateSelect(
+        runs, builder.CreateAnd(low_ok, high_ok), builder.getTrue(),
+        "range.ok");
+    Value* reported = builder.CreateSelect(low_ok, high, low);
+    EmitBoundsCheck(in_range, reported, length,
+                    access->bracket.location.line);
+  }
+}
+
+MDNode* Codegen::BranchWeights(BranchHint hint) {
+  // The weights `__builtin_expect` lowers to.
+  constexpr uint32_t kLikely = 2000;
+  constexpr uint32_t kUnlikely = 1;
+  MDBuilder md(ctx_->GetContext());
+  switch (hint) {
+    case BranchHint::Likely:
+      return md.createBranchWeights(kLikely, kUnlikely);
+    case BranchHint::Unlikely:
+      return md.createBranchWeights(kUnlikely, kLikely);
+    case BranchHint::None:
+      break;
+  }
+  return nullptr;
+}
+
+Function* Codegen::BoundsFailHandler() {
+  Module& mod = ctx_->GetModule();
+  if (Function* handler = mod.getFunction("cinder.bounds_fail")) {
+    return handler;
+  }
+
+  LLVMContext& context = ctx_->GetContext();
+  IRBuilder<> builder(context);
+  Type* i32 = builder.getInt32Ty();
+  Type* i64 = builder.getInt64Ty();
+  FunctionType* type =
+      FunctionType::get(builder.getVoidTy(), {i32, i64, i64}, false);
+  Function* handler = Function::Create(type, GlobalValue::InternalLinkage,
+                                       "cinder.bounds_fail", mod);
+  handler->addFnAttr(Attribute::NoReturn);
+  handler->addFnAttr(Attribute::Cold);
+  handler->addFnAttr(Attribute::NoInline);
+  handler->addFnAttr(Attribute::NoUnwind);
+
+  builder.SetInsertPoint(BasicBlock::Create(context, "entry", handler));
+  FunctionCallee dprintf = RuntimeFunc(
+      "dprintf",
+      FunctionType::get(i32, {i32, PointerType::getUnqual(context)}, true));
+  FunctionCallee fflush = RuntimeFunc(
+      "fflush",
+      FunctionType::get(i32, {PointerType::getUnqual(context)}, false));
+  FunctionCallee abort =
+      RuntimeFunc("abort", FunctionType::get(builder.getVoidTy(), false));
+  Value* format = ctx_->InternString(
+      "cinder: line %d: index %lld out of bounds for length %lld\n");
+  auto args = handler->arg_begin();
+  Value* line = args++;
+  Value* index = args++;
+  Value* length = args;
+  // abort() skips stdio teardown; flush so earlier output is not lost.
+  builder.CreateCall(
+      fflush, {ConstantPointerNull::get(PointerType::getUnqual(context))});
+  builder.CreateCall(dprintf,
+                     {builder.getInt32(2), format, line, index, length});
+  builder.CreateCall(abort);
+  builder.CreateUnreachable();
+  return handler;
+}
+
+Value* Codegen::EmitCoerced(Expr& value, types::Type* target) {
+  auto* array = dynamic_cast<types::ArrayType*>(value.type);
+  if (!array || !target || !target->Slice()) {
+    return EmitConversion(value.Accept(*this), value.type, target);
+  }
+
+  Value* data = EmitArrayAddress(value);
+  if (!data) {
+    return nullptr;
+  }
+  return EmitSlice(data, ctx_->GetBuilder().getInt64(array->length));
+}
+
+void Codegen::EmitArrayInit(AllocaInst* slot, types::ArrayType* type,
+                            Expr& init) {
+  auto& builder = ctx_->GetBuilder();
+  Type* array_ty = slot->getAllocatedType();
+  uint64_t size = ctx_->GetModule()
+                      .getDataLayout()
+                      .getTypeAllocSize(array_ty)
+                      .getFixedValue();
+
+  if (auto* literal = dynamic_cast<ArrayLiteral*>(&init)) {
+    // Elements past the end of a short literal are zeroed.
+    if (literal->elements.size() < type->length) {
+      builder.CreateMemSet(slot, builder.getInt8(0), size, slot->getAlign());
+    }
+    for (size_t i = 0; i < literal->elements.size(); ++i) {
+      Value* element = EmitCoerced(*literal->elements[i], type->element);
+      Value* ptr =
+          builder.CreateConstInBoundsGEP2_64(array_ty, slot, 0, i, "init.ptr");
+      ctx_->CreateStore(element, ptr);
+    }
+    return;
+  }
+
+  if (init.IsVariable() || init.IsIndexAccess() || init.IsGrouping()) {
+    Value* source = EmitArrayAddress(init);
+    if (source) {
+      builder.CreateMemCpy(slot, slot->getAlign(), source, MaybeAlign(), size);
+    }
+    return;
+  }
+
+  ctx_->CreateStore(init.Accept(*this), slot);
+}
+
+Value* Codegen::EmitConversion(Value* value, types::Type* from,
+                               types::Type* to) {
+  auto& builder = ctx_->GetBuilder();
+  auto* to_vector = dynamic_cast<types::VectorType*>(to);
+  if (value && to_vector && from && !from->Vector()) {
+    Value* lane = EmitConversion(value, from, to_vector->element);
+    return builder.CreateVectorSplat(to_vector->lanes, lane, "splat");
+  }
+
+  // Vectors convert lane by lane, following their element types.
+  types::Type* result = to;
+  from = LaneType(from);
+  to = LaneType(to);
+  bool from_numeric = from && (from->Int() || from->Bool() || from->Float());
+  if (!value || !to || !from_numeric || (!to->Int() && !to->Float())) {
+    return value;
+  }
+  Type* target = ResolveType(result);
+  if (value->getType() == target) {
+    return value;
+  }
+
+  auto* from_int = dynamic_cast<types::IntType*>(from);
+  bool from_signed = from_int && from_int->is_signed;
+  if (to->Int()) {
+    auto* to_int = dynamic_cast<types::IntType*>(to);
+    if (from->Float()) {
+      return to_int->is_signed ? builder.CreateFPToSI(value, target, "conv")
+                               : builder.CreateFPToUI(value, target, "conv");
+    }
+    return builder.CreateIntCast(value, target, from_signed, "conv");
+  }
+  if (from->Float()) {
+    return builder.CreateFPCast(value, target, "conv");
+  }
+  return from_signed ? builder.CreateSIToFP(value, target, "conv")
+                     : builder.CreateUIToFP(value, target, "conv");
+}
+
 Value* Codegen::EmitInteger(Literal& expr) {
   types::IntType* int_type = dynamic_cast<types::IntType*>(expr.type);
-  int value = std::get<int>(expr.value);
-  return ConstantInt::get(ctx_->GetContext(), APInt(int_type->bits, value));
+  int64_t value = std::get<int64_t>(expr.value);
+  return ConstantInt::get(ctx_->GetContext(),
+                          APInt(int_type->bits, static_cast<uint64_t>(value),
+                                int_type->is_signed));
+}
+
+Constant* Codegen::EmitConstant(const ConstValue& value, types::Type* type) {
+  Type* ty = ResolveType(type);
+  if (const bool* flag = std::get_if<bool>(&value)) {
+    return ConstantInt::getBool(ctx_->GetContext(), *flag);
+  }
+  if (const double* real = std::get_if<double>(&value)) {
+    return ConstantFP::get(ty, *real);
+  }
+  auto* int_type = dynamic_cast<types::IntType*>(type);
+  return ConstantInt::get(ty, static_cast<uint64_t>(std::get<int64_t>(value)),
+                          int_type && int_type->is_signed);
+}
+
+void Codegen::EmitGlobal(VarDeclarationStmt& stmt, const std::string& mod) {
+  types::Type* declared =
+      stmt.resolved_type ? stmt.resolved_type : stmt.value->type;
+  Constant* init = EmitStaticInitializer(*stmt.value, declared);
+  if (!init || !stmt.HasID()) {
+    return;
+  }
+
+  // The whole program is one LLVM module, so nothing outside it links here.
+  auto* global = new GlobalVariable(
+      ctx_->GetModule(), init->getType(), stmt.is_const,
+      GlobalValue::InternalLinkage, init, mod + "." + stmt.name.lexeme);
+  // The language cannot observe addresses, so only constants may be merged.
+  global->setUnnamedAddr(stmt.is_const ? GlobalValue::UnnamedAddr::Global
+                                       : GlobalValue::UnnamedAddr::Local);
+
+  auto binding = std::make_unique<VarBinding>();
+  binding->SetGlobal(global);
+  ir_bindings_[stmt.GetID()] = std::move(binding);
+}
+
+Constant* Codegen::EmitStaticInitializer(Expr& init, types::Type* type) {
+  if (init.constant) {
+    // Conversions of constants fold in the builder without emitting code.
+    Constant* value = EmitConstant(*init.constant, init.type);
+    return dyn_cast_or_null<Constant>(
+        EmitConversion(value, init.type, type));
+  }
+  if (auto* group = dynamic_cast<Grouping*>(&init)) {
+    return EmitStaticInitializer(*group->expr, type);
+  }
+  if (auto* literal = dynamic_cast<Literal*>(&init)) {
+    const auto* text = std::get_if<std::string>(&literal->value);
+    return text ? EmitStringLiteral(*text) : nullptr;
+  }
+
+  Type* ty = ResolveType(type);
+  if (auto* literal = dynamic_cast<ArrayLiteral*>(&init)) {
+    types::Type* element = nullptr;
+    if (auto* array = dynamic_cast<types::ArrayType*>(type)) {
+      element = array->element;
+    } else if (auto* vector = dynamic_cast<types::VectorType*>(type)) {
+      element = vector->element;
+    }
+    if (!element) {
+      return nullptr;
+    }
+    // Elements past the end of a short literal stay zero.
+    uint64_t length = type->FixedLength();
+    Constant* zero = Constant::getNullValue(ResolveType(element));
+    std::vector<Constant*> elements(length, zero);
+    for (size_t i = 0; i < literal->elements.size() && i < length; ++i) {
+      elements[i] = EmitStaticInitializer(*literal->elements[i], element);
+      if (!elements[i]) {
+        return nullptr;
+      }
+    }
+    if (type->Vector()) {
+      return ConstantVector::get(elements);
+    }
+    return ConstantArray::get(cast<llvm::ArrayType>(ty), elements);
+  }
+
+  auto* call = dynamic_cast<CallExpr*>(&init);
+  auto* record = dynamic_cast<types::StructType*>(type);
+  if (!call || !record || call->args.size() != record->fields.size()) {
+    return nullptr;
+  }
+  std::vector<Constant*> fields;
+  for (size_t i = 0; i < call->args.size(); ++i) {
+    fields.push_back(EmitStaticInitializer(*call->args[i], record->fields[i]));
+    if (!fields.back()) {
+      return nullptr;
+    }
+  }
+  return ConstantStruct::get(cast<llvm::StructType>(ty), fields);
 }
 
 static Type* ResolveStructType() {
@@ -890,13 +2575,28 @@ Type* Codegen::ResolveType(types::Type* type, bool allow_void) {
     case types::TypeKind::Bool:
       return Type::getInt1Ty(ctx);
     case types::TypeKind::Int:
-      return Type::getInt32Ty(ctx);
+      return Type::getIntNTy(ctx, dynamic_cast<types::IntType*>(type)->bits);
     case types::TypeKind::Float:
-      return Type::getFloatTy(ctx);
-    case types::TypeKind::String:
-      return PointerType::getInt8Ty(ctx);
+      return dynamic_cast<types::FloatType*>(type)->bits == 64
+                 ? Type::getDoubleTy(ctx)
+                 : Type::getFloatTy(ctx);
     case types::TypeKind::Void:
       return allow_void ? Type::getVoidTy(ctx) : nullptr;
+    case types::TypeKind::Array: {
+      auto* array = dynamic_cast<types::ArrayType*>(type);
+      Type* element = ResolveType(array->element, false);
+      return element ? ArrayType::get(element, array->length) : nullptr;
+    }
+    case types::TypeKind::String:
+    case types::TypeKind::Slice:
+      return SliceStructType();
+    case types::TypeKind::Vector: {
+      auto* vector = dynamic_cast<types::VectorType*>(type);
+      Type* element = ResolveType(vector->element, false);
+      return element ? FixedVectorType::get(element, vector->lanes) : nullptr;
+    }
+    case types::TypeKind::Reference:
+      return PointerType::getUnqual(ctx);
     case types::TypeKind::Struct:
       break;
     default:
@@ -935,10 +2635,23 @@ Type* Codegen::ResolveType(types::Type* type, bool allow_void) {
   return llvm_struct;
 }
 
+llvm::StructType* Codegen::SliceStructType() {
+  auto& ctx = ctx_->GetContext();
+  return llvm::StructType::get(ctx, {PointerType::getUnqual(ctx),
+                                     Type::getInt64Ty(ctx)});
+}
+
 Type* Codegen::ResolveArgType(types::Type* type) {
   return ResolveType(type, false);
 }
 
+Type* Codegen::ResolveCType(types::Type* type) {
+  if (type && type->String()) {
+    return PointerType::getUnqual(ctx_->GetContext());
+  }
+  return ResolveType(type);
+}
+
 Type* Codegen::ResolveType(types::Type* type) {
   return ResolveType(type, true);
 }
@@ -9,9 +9,28 @@ bool Binding::IsVariable() const {
 }
 
 llvm::AllocaInst* VarBinding::GetAlloca() {
-  return alloca_ptr;
+  return llvm::dyn_cast_or_null<llvm::AllocaInst>(address);
 }
 
 void VarBinding::SetAlloca(llvm::AllocaInst* alloca) {
-  alloca_ptr = alloca;
+  address = alloca;
+  value_type = alloca ? alloca->getAllocatedType() : nullptr;
+}
+
+void VarBinding::SetGlobal(llvm::GlobalVariable* global) {
+  address = global;
+  value_type = global ? global->getValueType() : nullptr;
+}
+
+void VarBinding::SetAddress(llvm::Value* pointer, llvm::Type* type) {
+  address = pointer;
+  value_type = type;
+}
+
+llvm::Value* VarBinding::GetAddress() {
+  return address;
+}
+
+llvm::Type* VarBinding::GetValueType() {
+  return value_type;
 }
\ No newline at end of file
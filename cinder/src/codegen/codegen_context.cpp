@@ -8,8 +8,10 @@
 #include "cinder/frontend/tokens.hpp"
 #include "cinder/support/utils.hpp"
 #include "llvm/ADT/Twine.h"
+#include "llvm/Analysis/CGSCCPassManager.h"
 #include "llvm/CodeGen/MachineMemOperand.h"
 #include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/CallingConv.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/IRBuilder.h"
@@ -20,6 +22,7 @@
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/PassManager.h"
+#include "llvm/IR/PatternMatch.h"
 #include "llvm/IR/Type.h"
 #include "llvm/IR/Value.h"
 #include "llvm/IR/Verifier.h"
@@ -30,6 +33,8 @@
 #include "llvm/Support/CodeGen.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/TargetParser/Triple.h"
+#include "llvm/Transforms/IPO/FunctionAttrs.h"
+#include "llvm/Transforms/IPO/InferFunctionAttrs.h"
 #include "llvm/Transforms/InstCombine/InstCombine.h"
 #include "llvm/Transforms/Scalar/GVN.h"
 #include "llvm/Transforms/Scalar/Reassociate.h"
@@ -38,12 +43,41 @@
 using namespace llvm;
 using namespace cinder;
 
+/**
+ * @brief Lowers `l / 2^k` or `l % 2^k` to shifts and masks.
+ *
+ * Signed division rounds toward zero, so a negative dividend is biased by
+ * `2^k - 1` before the arithmetic shift.
+ */
+static Value* DividePowerOfTwo(IRBuilder<>& builder, Token::Type op, Value* l,
+                               unsigned k, bool is_signed) {
+  bool is_div = op == Token::Type::SLASH;
+  Type* ty = l->getType();
+  if (k == 0) {
+    return is_div ? l : Constant::getNullValue(ty);
+  }
+  unsigned bits = ty->getScalarSizeInBits();
+  if (!is_signed) {
+    return is_div ? builder.CreateLShr(l, k, "divtmp")
+                  : builder.CreateAnd(
+                        l, ConstantInt::get(ty, APInt::getLowBitsSet(bits, k)),
+                        "remtmp");
+  }
+  Value* sign = builder.CreateAShr(l, bits - 1, "sign");
+  Value* bias = builder.CreateLShr(sign, bits - k, "bias");
+  Value* biased = builder.CreateAdd(l, bias, "biased");
+  if (is_div) {
+    return builder.CreateAShr(biased, k, "divtmp");
+  }
+  Value* rounded = builder.CreateAnd(
+      biased, ConstantInt::get(ty, APInt::getHighBitsSet(bits, bits - k)));
+  return builder.CreateSub(l, rounded, "remtmp");
+}
+
 CodegenContext::CodegenContext(const std::string& module_name)
     : llvm_ctx_(std::make_unique<LLVMContext>()),
       module_(std::make_unique<Module>(module_name, *llvm_ctx_)),
       builder_(std::make_unique<IRBuilder<>>(*llvm_ctx_)),
-      const_int(ConstantInt::get(*llvm_ctx_, APInt(32, 1))),
-      const_flt(ConstantFP::get(*llvm_ctx_, APFloat(1.0f))),
       debug_info_(*llvm_ctx_, *builder_) {
   TheFPM_ = std::make_unique<FunctionPassManager>();
   TheLAM_ = std::make_unique<LoopAnalysisManager>();
@@ -52,18 +86,13 @@ CodegenContext::CodegenContext(const std::string& module_name)
   TheMAM_ = std::make_unique<ModuleAnalysisManager>();
   ThePIC_ = std::make_unique<PassInstrumentationCallbacks>();
 
-  TheSI_ = std::make_unique<StandardInstrumentations>(*llvm_ctx_, true);
+  TheSI_ = std::make_unique<StandardInstrumentations>(*llvm_ctx_, false);
   TheSI_->registerCallbacks(*ThePIC_, TheMAM_.get());
 
   TheFPM_->addPass(InstCombinePass());
   TheFPM_->addPass(ReassociatePass());
   TheFPM_->addPass(GVNPass());
   TheFPM_->addPass(SimplifyCFGPass());
-
-  PassBuilder PB;
-  PB.registerModuleAnalyses(*TheMAM_);
-  PB.registerFunctionAnalyses(*TheFAM_);
-  PB.crossRegisterProxies(*TheLAM_, *TheFAM_, *TheCGAM_, *TheMAM_);
 }
 
 DebugInfoContext& CodegenContext::DebugInfo() {
@@ -84,16 +113,39 @@ IRBuilder<>& CodegenContext::GetBuilder() {
 
 Type* CodegenContext::CreateTypeFromToken(Token& tok) {
   switch (tok.kind) {
+    case Token::Type::INT8_SPECIFIER:
+    case Token::Type::UINT8_SPECIFIER:
+      return Type::getInt8Ty(*llvm_ctx_);
+    case Token::Type::INT16_SPECIFIER:
+    case Token::Type::UINT16_SPECIFIER:
+      return Type::getInt16Ty(*llvm_ctx_);
     case Token::Type::INT32_SPECIFIER:
+    case Token::Type::UINT32_SPECIFIER:
       return Type::getInt32Ty(*llvm_ctx_);
+    case Token::Type::INT64_SPECIFIER:
+    case Token::Type::UINT64_SPECIFIER:
+      return Type::getInt64Ty(*llvm_ctx_);
     case Token::Type::FLT32_SPECIFIER:
       return Type::getFloatTy(*llvm_ctx_);
     case Token::Type::FLT64_SPECIFIER:
       return Type::getDoubleTy(*llvm_ctx_);
     case Token::Type::BOOL_SPECIFIER:
       return Type::getInt1Ty(*llvm_ctx_);
+    case Token::Type::FLT32X4_SPECIFIER:
+      return FixedVectorType::get(Type::getFloatTy(*llvm_ctx_), 4);
+    case Token::Type::FLT32X8_SPECIFIER:
+      return FixedVectorType::get(Type::getFloatTy(*llvm_ctx_), 8);
+    case Token::Type::INT32X4_SPECIFIER:
+      return FixedVectorType::get(Type::getInt32Ty(*llvm_ctx_), 4);
+    case Token::Type::INT32X8_SPECIFIER:
+      return FixedVectorType::get(Type::getInt32Ty(*llvm_ctx_), 8);
+    case Token::Type::BOOLX4_SPECIFIER:
+      return FixedVectorType::get(Type::getInt1Ty(*llvm_ctx_), 4);
+    case Token::Type::BOOLX8_SPECIFIER:
+      return FixedVectorType::get(Type::getInt1Ty(*llvm_ctx_), 8);
     case Token::Type::STR_SPECIFIER:
-      return PointerType::getInt8Ty(*llvm_ctx_);
+      return StructType::get(*llvm_ctx_, {PointerType::getUnqual(*llvm_ctx_),
+                                          Type::getInt64Ty(*llvm_ctx_)});
     case Token::Type::VOID_SPECIFIER:
       return Type::getVoidTy(*llvm_ctx_);
     default:
@@ -103,7 +155,13 @@ Type* CodegenContext::CreateTypeFromToken(Token& tok) {
 
 AllocaInst* CodegenContext::CreateAlloca(Type* ty, Value* array_size,
                                          const Twine& name) {
-  return builder_->CreateAlloca(ty, array_size, name);
+  BasicBlock* block = builder_->GetInsertBlock();
+  if (array_size || !block || !block->getParent()) {
+    return builder_->CreateAlloca(ty, array_size, name);
+  }
+  BasicBlock& entry = block->getParent()->getEntryBlock();
+  IRBuilder<> entry_builder(&entry, entry.getFirstInsertionPt());
+  return entry_builder.CreateAlloca(ty, nullptr, name);
 }
 
 StoreInst* CodegenContext::CreateStore(Value* value, Value* ptr,
@@ -111,20 +169,29 @@ StoreInst* CodegenContext::CreateStore(Value* value, Value* ptr,
   return builder_->CreateStore(value, ptr, is_volatile);
 }
 
-Value* CodegenContext::CreateIntCmp(Token::Type ty, Value* left, Value* right) {
+Value* CodegenContext::CreateIntCmp(Token::Type ty, Value* left, Value* right,
+                                    bool is_signed) {
   switch (ty) {
     case Token::Type::BANGEQ:
       return builder_->CreateCmp(CmpInst::ICMP_NE, left, right, "cmptmp");
     case Token::Type::EQEQ:
       return builder_->CreateCmp(CmpInst::ICMP_EQ, left, right, "cmptmp");
     case Token::Type::LESSER:
-      return builder_->CreateCmp(CmpInst::ICMP_SLT, left, right, "cmptmp");
+      return builder_->CreateCmp(
+          is_signed ? CmpInst::ICMP_SLT : CmpInst::ICMP_ULT, left, right,
+          "cmptmp");
     case Token::Type::LESSER_EQ:
-      return builder_->CreateCmp(CmpInst::ICMP_SLE, left, right, "cmptmp");
+      return builder_->CreateCmp(
+          is_signed ? CmpInst::ICMP_SLE : CmpInst::ICMP_ULE, left, right,
+          "cmptmp");
     case Token::Type::GREATER:
-      return builder_->CreateCmp(CmpInst::ICMP_SGT, left, right, "cmptmp");
+      return builder_->CreateCmp(
+          is_signed ? CmpInst::ICMP_SGT : CmpInst::ICMP_UGT, left, right,
+          "cmptmp");
     case Token::Type::GREATER_EQ:
-      return builder_->CreateCmp(CmpInst::ICMP_SGE, left, right, "cmptmp");
+      return builder_->CreateCmp(
+          is_signed ? CmpInst::ICMP_SGE : CmpInst::ICMP_UGE, left, right,
+          "cmptmp");
     default:
       UNREACHABLE(CodegenContext, CreateIntCmp);
       return nullptr;
@@ -151,16 +218,51 @@ Value* CodegenContext::CreateFltCmp(Token::Type ty, Value* left, Value* right) {
   }
 }
 
-Value* CodegenContext::CreateIntBinop(Token::Type op, Value* l, Value* r) {
+Value* CodegenContext::CreateIntBinop(Token::Type op, Value* l, Value* r,
+                                      bool is_signed) {
+  // Signed overflow is undefined (`nsw`), which lets SCEV reason about
+  // induction variables; unsigned arithmetic wraps.
   switch (op) {
     case Token::Type::Plus:
-      return builder_->CreateAdd(l, r, "addtmp");
+      return builder_->CreateAdd(l, r, "addtmp", false, is_signed);
     case Token::Type::Minus:
-      return builder_->CreateSub(l, r, "subtmp");
+      return builder_->CreateSub(l, r, "subtmp", false, is_signed);
     case Token::Type::STAR:
-      return builder_->CreateMul(l, r, "multmp");
+      return builder_->CreateMul(l, r, "multmp", false, is_signed);
     case Token::Type::SLASH:
-      return builder_->CreateSDiv(l, r, "divtmp");
+    case Token::Type::MODULO: {
+      const APInt* divisor = nullptr;
+      if (PatternMatch::match(r, PatternMatch::m_APInt(divisor)) &&
+          divisor->isPowerOf2() && !(is_signed && divisor->isNegative())) {
+        return DividePowerOfTwo(*builder_, op, l, divisor->logBase2(),
+                                is_signed);
+      }
+      if (op == Token::Type::MODULO) {
+        return is_signed ? builder_->CreateSRem(l, r, "remtmp")
+                         : builder_->CreateURem(l, r, "remtmp");
+      }
+      return is_signed ? builder_->CreateSDiv(l, r, "divtmp")
+                       : builder_->CreateUDiv(l, r, "divtmp");
+    }
+    case Token::Type::AMP:
+      return builder_->CreateAnd(l, r, "andtmp");
+    case Token::Type::PIPE:
+      return builder_->CreateOr(l, r, "ortmp");
+    case Token::Type::CARET:
+      return builder_->CreateXor(l, r, "xortmp");
+    case Token::Type::LESSER_LESSER:
+    case Token::Type::GREATER_GREATER: {
+      // Only the low bits of the amount count, so an oversized shift wraps
+      // around instead of producing poison; x86 shifts do this for free.
+      unsigned bits = l->getType()->getScalarSizeInBits();
+      Value* amount =
+          builder_->CreateAnd(r, ConstantInt::get(r->getType(), bits - 1));
+      if (op == Token::Type::LESSER_LESSER) {
+        return builder_->CreateShl(l, amount, "shltmp");
+      }
+      return is_signed ? builder_->CreateAShr(l, amount, "shrtmp")
+                       : builder_->CreateLShr(l, amount, "shrtmp");
+    }
     default:
       return nullptr;
   }
@@ -176,6 +278,8 @@ Value* CodegenContext::CreateFltBinop(Token::Type op, Value* l, Value* r) {
       return builder_->CreateFMul(l, r, "multmp");
     case Token::Type::SLASH:
       return builder_->CreateFDiv(l, r, "divtmp");
+    case Token::Type::MODULO:
+      return builder_->CreateFRem(l, r, "remtmp");
     default:
       return nullptr;
   }
@@ -186,20 +290,23 @@ Value* CodegenContext::CreateLoad(Type* ty, Value* val, const Twine& name) {
 }
 
 Value* CodegenContext::CreatePreOp(types::Type* ty, Token::Type op, Value* val,
-                                   AllocaInst* alloca) {
+                                   Value* ptr) {
   const bool isFloat = (ty->kind == types::TypeKind::Float);
   const bool isInt = (ty->kind == types::TypeKind::Int);
   if (!isFloat && !isInt) UNREACHABLE(CodegenContext, CreatePreOp);
 
-  Value* one = isFloat ? const_flt : const_int;
+  auto* int_type = dynamic_cast<types::IntType*>(ty);
+  const bool is_signed = int_type && int_type->is_signed;
+  Value* one = isFloat ? ConstantFP::get(val->getType(), 1.0)
+                       : ConstantInt::get(val->getType(), 1);
 
   auto add = [&](Value* a, Value* b) {
     return isFloat ? builder_->CreateFAdd(a, b, "inc")
-                   : builder_->CreateAdd(a, b, "inc");
+                   : builder_->CreateAdd(a, b, "inc", false, is_signed);
   };
   auto sub = [&](Value* a, Value* b) {
     return isFloat ? builder_->CreateFSub(a, b, "dec")
-                   : builder_->CreateSub(a, b, "dec");
+                   : builder_->CreateSub(a, b, "dec", false, is_signed);
   };
 
   Value* var = nullptr;
@@ -214,7 +321,7 @@ Value* CodegenContext::CreatePreOp(types::Type* ty, Token::Type op, Value* val,
       UNREACHABLE(CodegenContext, CreatePreOp);
   }
 
-  builder_->CreateStore(var, alloca);
+  builder_->CreateStore(var, ptr);
   return var;
 }
 
@@ -241,8 +348,9 @@ BranchInst* CodegenContext::CreateBr(BasicBlock* destination) {
 
 BranchInst* CodegenContext::CreateBasicCondBr(Value* val,
                                               BasicBlock* true_block,
-                                              BasicBlock* false_block) {
-  return builder_->CreateCondBr(val, true_block, false_block);
+                                              BasicBlock* false_block,
+                                              MDNode* weights) {
+  return builder_->CreateCondBr(val, true_block, false_block, weights);
 }
 
 FunctionType* CodegenContext::GetFuncType(Type* res, ArrayRef<Type*> params,
@@ -252,9 +360,34 @@ FunctionType* CodegenContext::GetFuncType(Type* res, ArrayRef<Type*> params,
 
 Function* CodegenContext::CreatePublicFunc(FunctionType* type,
                                            const Twine& name) {
+  // Calls already made through an earlier declaration use its type, so a
+  // different prototype cannot stand in for it.
+  if (Function* existing = module_->getFunction(name.str())) {
+    return existing->getFunctionType() == type ? existing : nullptr;
+  }
   return Function::Create(type, Function::ExternalLinkage, name, *module_);
 }
 
+Function* CodegenContext::CreateInternalFunc(FunctionType* type,
+                                             const Twine& name) {
+  Function* func =
+      Function::Create(type, Function::InternalLinkage, name, *module_);
+  func->setCallingConv(CallingConv::Fast);
+  return func;
+}
+
+GlobalVariable* CodegenContext::InternString(StringRef text) {
+  GlobalVariable*& global = strings_[text];
+  if (!global) {
+    Constant* bytes = ConstantDataArray::getString(*llvm_ctx_, text, true);
+    global = new GlobalVariable(*module_, bytes->getType(), true,
+                                GlobalValue::PrivateLinkage, bytes, ".str");
+    global->setUnnamedAddr(GlobalValue::UnnamedAddr::Global);
+    global->setAlignment(Align(1));
+  }
+  return global;
+}
+
 void CodegenContext::SetInsertPoint(BasicBlock* block) {
   builder_->SetInsertPoint(block);
 }
@@ -269,13 +402,21 @@ llvm::ReturnInst* CodegenContext::CreateReturn(llvm::Value* val) {
 
 llvm::CallInst* CodegenContext::CreateVoidCall(
     llvm::FunctionCallee callee, llvm::ArrayRef<llvm::Value*> args) {
-  return builder_->CreateCall(callee, args);
+  llvm::CallInst* call = builder_->CreateCall(callee, args);
+  if (auto* func = llvm::dyn_cast<llvm::Function>(callee.getCallee())) {
+    call->setCallingConv(func->getCallingConv());
+  }
+  return call;
 }
 
 llvm::CallInst* CodegenContext::CreateCall(llvm::FunctionCallee callee,
                                            llvm::ArrayRef<llvm::Value*> args,
                                            const llvm::Twine name) {
-  return builder_->CreateCall(callee, args, name);
+  llvm::CallInst* call = builder_->CreateCall(callee, args, name);
+  if (auto* func = llvm::dyn_cast<llvm::Function>(callee.getCallee())) {
+    call->setCallingConv(func->getCallingConv());
+  }
+  return call;
 }
 
 void CodegenContext::SetTargetTriple(llvm::Triple trip) {
@@ -287,12 +428,80 @@ const llvm::Target* CodegenContext::LookupTarget() {
   return TargetRegistry::lookupTarget(module_->getTargetTriple(), err);
 }
 
+static OptimizationLevel ToOptimizationLevel(unsigned opt_level) {
+  switch (opt_level) {
+    case 0:
+      return OptimizationLevel::O0;
+    case 1:
+      return OptimizationLevel::O1;
+    case 2:
+      return OptimizationLevel::O2;
+    default:
+      return OptimizationLevel::O3;
+  }
+}
+
+static CodeGenOptLevel ToCodeGenOptLevel(unsigned opt_level) {
+  switch (opt_level) {
+    case 0:
+      return CodeGenOptLevel::None;
+    case 1:
+      return CodeGenOptLevel::Less;
+    case 2:
+      return CodeGenOptLevel::Default;
+    default:
+      return CodeGenOptLevel::Aggressive;
+  }
+}
+
 TargetMachine* CodegenContext::CreateTargetMachine(const Target* target,
-                                                   const std::string& trip) {
-  return target->createTargetMachine(Triple(trip), "generic", "", {},
-                                     Reloc::PIC_);
+                                                   const std::string& trip,
+                                                   const std::string& cpu,
+                                                   unsigned opt_level) {
+  return target->createTargetMachine(Triple(trip), cpu, "", {},
+                                     Reloc::PIC_, std::nullopt,
+                                     ToCodeGenOptLevel(opt_level));
 }
 
 void CodegenContext::SetModDataLayout(TargetMachine* tm) {
   module_->setDataLayout(tm->createDataLayout());
 }
+
+void CodegenContext::InferAttributes() {
+  // Cinder has no exceptions, and every body in the module was generated
+  // from cinder source or is a runtime helper that aborts.
+  for (Function& func : *module_) {
+    if (!func.isDeclaration()) {
+      func.setDoesNotThrow();
+    }
+  }
+
+  // Library calls get their known effects first, then effects, `willreturn`
+  // and `norecurse` are deduced bottom-up over the call graph.
+  ModulePassManager MPM;
+  MPM.addPass(InferFunctionAttrsPass());
+  MPM.addPass(
+      createModuleToPostOrderCGSCCPassAdaptor(PostOrderFunctionAttrsPass()));
+  MPM.addPass(ReversePostOrderFunctionAttrsPass());
+  MPM.run(*module_, *TheMAM_);
+}
+
+void CodegenContext::Optimize(TargetMachine* tm, unsigned opt_level,
+                              std::optional<PGOOptions> pgo) {
+  // Analyses are registered here rather than in the constructor so that
+  // TargetIRAnalysis picks up the target machine's cost model.
+  PassBuilder PB(tm, PipelineTuningOptions(), pgo, ThePIC_.get());
+  PB.registerModuleAnalyses(*TheMAM_);
+  PB.registerCGSCCAnalyses(*TheCGAM_);
+  PB.registerFunctionAnalyses(*TheFAM_);
+  PB.registerLoopAnalyses(*TheLAM_);
+  PB.crossRegisterProxies(*TheLAM_, *TheFAM_, *TheCGAM_, *TheMAM_);
+
+  InferAttributes();
+
+  ModulePassManager MPM =
+      opt_level == 0
+          ? PB.buildO0DefaultPipeline(OptimizationLevel::O0)
+          : PB.buildPerModuleDefaultPipeline(ToOptimizationLevel(opt_level));
+  MPM.run(*module_, *TheMAM_);
+}
@@ -55,6 +55,10 @@ llvm::DIScope* DebugInfoContext::GetScope() {
 
 void DebugInfoContext::SetScope(llvm::DIScope* scope) {
   di_scope_ = scope;
+  if (!isa_and_nonnull<DILocalScope>(scope)) {
+    // Leaving a function; its last location must not reach the next one.
+    builder_.SetCurrentDebugLocation(DebugLoc());
+  }
 }
 
 llvm::DIType* DebugInfoContext::ResolveType(cinder::types::Type* type) {
@@ -72,24 +76,65 @@ llvm::DIType* DebugInfoContext::ResolveType(cinder::types::Type* type) {
     case types::TypeKind::Int: {
       auto* i = dynamic_cast<types::IntType*>(type);
       uint64_t bits = i ? i->bits : 32;
+      bool is_signed = !i || i->is_signed;
       unsigned encoding =
-          (i && !i->is_signed) ? dwarf::DW_ATE_unsigned : dwarf::DW_ATE_signed;
-      return di_builder_->createBasicType("int", bits, encoding);
+          is_signed ? dwarf::DW_ATE_signed : dwarf::DW_ATE_unsigned;
+      std::string name = (is_signed ? "int" : "uint") + std::to_string(bits);
+      return di_builder_->createBasicType(name, bits, encoding);
     }
     case types::TypeKind::Float: {
       auto* f = dynamic_cast<types::FloatType*>(type);
       uint64_t bits = f ? f->bits : 32;
-      return di_builder_->createBasicType("float", bits, dwarf::DW_ATE_float);
-    }
-    case types::TypeKind::String: {
-      DIType* char_ty =
-          di_builder_->createBasicType("char", 8, dwarf::DW_ATE_signed_char);
-      return di_builder_->createPointerType(char_ty, 64);
+      return di_builder_->createBasicType("flt" + std::to_string(bits), bits,
+                                          dwarf::DW_ATE_float);
     }
     case types::TypeKind::Struct: {
       auto* s = dynamic_cast<types::StructType*>(type);
       return di_builder_->createUnspecifiedType(s ? s->name : "struct");
     }
+    case types::TypeKind::Array: {
+      auto* a = dynamic_cast<types::ArrayType*>(type);
+      DIType* element = ResolveType(a->element);
+      uint64_t size = element->getSizeInBits() * a->length;
+      Metadata* range = di_builder_->getOrCreateSubrange(0, a->length);
+      return di_builder_->createArrayType(
+          size, 0, element, di_builder_->getOrCreateArray(range));
+    }
+    case types::TypeKind::Vector: {
+      auto* v = dynamic_cast<types::VectorType*>(type);
+      DIType* element = ResolveType(v->element);
+      Metadata* range = di_builder_->getOrCreateSubrange(0, v->lanes);
+      return di_builder_->createVectorType(
+          element->getSizeInBits() * v->lanes, 0, element,
+          di_builder_->getOrCreateArray(range));
+    }
+    case types::TypeKind::String:
+    case types::TypeKind::Slice: {
+      // Both lower to `{ptr, i64}`; string data is `char`.
+      auto* sl = dynamic_cast<types::SliceType*>(type);
+      DIType* element =
+          sl ? ResolveType(sl->element)
+             : di_builder_->createBasicType("char", 8,
+                                            dwarf::DW_ATE_signed_char);
+      DIType* data = di_builder_->createPointerType(element, 64);
+      DIType* len =
+          di_builder_->createBasicType("int64", 64, dwarf::DW_ATE_signed);
+      Metadata* fields[] = {
+          di_builder_->createMemberType(di_scope_, "data", di_file_, 0, 64, 0,
+                                        0, DINode::FlagZero, data),
+          di_builder_->createMemberType(di_scope_, "len", di_file_, 0, 64, 0,
+                                        64, DINode::FlagZero, len)};
+      return di_builder_->createStructType(
+          di_scope_, sl ? "slice" : "str", di_file_, 0, 128, 64,
+          DINode::FlagZero, nullptr, di_builder_->getOrCreateArray(fields));
+    }
+    case types::TypeKind::Reference: {
+      auto* r = dynamic_cast<types::ReferenceType*>(type);
+      DIType* referent = ResolveType(r->referent);
+      return r->nullable ? di_builder_->createPointerType(referent, 64)
+                         : di_builder_->createReferenceType(
+                               dwarf::DW_TAG_reference_type, referent, 64);
+    }
     case types::TypeKind::Void:
     case types::TypeKind::Function:
     default:
@@ -101,10 +146,16 @@ void DebugInfoContext::SetLocation(const cinder::SourceLocation& loc) {
   if (!di_scope_) {
     return;
   }
+  // Prototypes and globals are outside any function, so they get none.
+  auto* scope = dyn_cast<DILocalScope>(di_scope_);
+  if (!scope) {
+    builder_.SetCurrentDebugLocation(DebugLoc());
+    return;
+  }
 
   unsigned line = static_cast<unsigned>(loc.line == 0 ? 1 : loc.line);
   unsigned col = static_cast<unsigned>(loc.column == 0 ? 1 : loc.column);
-  auto* debug_loc = DILocation::get(llvm_ctx_, line, col, di_scope_);
+  auto* debug_loc = DILocation::get(llvm_ctx_, line, col, scope);
   builder_.SetCurrentDebugLocation(debug_loc);
 }
 
@@ -1,41 +1,104 @@
 #include "cinder/frontend/lexer.hpp"
 
 #include <cassert>
+#include <cfloat>
+#include <charconv>
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <unordered_map>
 
 #include "cinder/frontend/tokens.hpp"
+#include "cinder/support/phase_timer.hpp"
 
 using namespace cinder;
 
 /// TODO: Fix the typing system so it is more ergonomic to work with
 /// Handling the types at parse time and IR gen time is a bit awkward
 static const std::unordered_map<std::string, Token::Type> key_words = {
+    {"int8", Token::Type::INT8_SPECIFIER},
+    {"int16", Token::Type::INT16_SPECIFIER},
     {"int32", Token::Type::INT32_SPECIFIER},
     {"int64", Token::Type::INT64_SPECIFIER},
+    {"uint8", Token::Type::UINT8_SPECIFIER},
+    {"uint16", Token::Type::UINT16_SPECIFIER},
+    {"uint32", Token::Type::UINT32_SPECIFIER},
+    {"uint64", Token::Type::UINT64_SPECIFIER},
     {"flt32", Token::Type::FLT32_SPECIFIER},
     {"flt64", Token::Type::FLT64_SPECIFIER},
+    {"flt32x4", Token::Type::FLT32X4_SPECIFIER},
+    {"flt32x8", Token::Type::FLT32X8_SPECIFIER},
+    {"int32x4", Token::Type::INT32X4_SPECIFIER},
+    {"int32x8", Token::Type::INT32X8_SPECIFIER},
+    {"boolx4", Token::Type::BOOLX4_SPECIFIER},
+    {"boolx8", Token::Type::BOOLX8_SPECIFIER},
     {"str", Token::Type::STR_SPECIFIER},
     {"bool", Token::Type::BOOL_SPECIFIER},
     {"struct", Token::Type::STRUCT_SPECIFIER},
     {"def", Token::Type::DEF},
     {"end", Token::Type::END},
+    {"new", Token::Type::NEW},
     {"if", Token::Type::IF},
     {"elif", Token::Type::ELSEIF},
     {"else", Token::Type::ELSE},
     {"for", Token::Type::FOR},
     {"while", Token::Type::WHILE},
+    {"match", Token::Type::MATCH},
+    {"case", Token::Type::CASE},
+    {"likely", Token::Type::LIKELY},
+    {"unlikely", Token::Type::UNLIKELY},
     {"true", Token::Type::TRUE},
     {"false", Token::Type::FALSE},
     {"return", Token::Type::RETURN},
     {"void", Token::Type::VOID_SPECIFIER},
     {"extern", Token::Type::EXTERN},
+    {"pure", Token::Type::PURE},
+    {"const", Token::Type::CONST},
+    {"ref", Token::Type::REF},
+    {"ptr", Token::Type::PTR},
     {"mod", Token::Type::MOD},
     {"import", Token::Type::IMPORT},
     {"...", Token::Type::ELLIPSIS},
 };
 
+/// Numeric literal suffixes and the type specifier each one names.
+static const std::unordered_map<std::string, Token::Type> literal_suffixes = {
+    {"i8", Token::Type::INT8_SPECIFIER},
+    {"i16", Token::Type::INT16_SPECIFIER},
+    {"i32", Token::Type::INT32_SPECIFIER},
+    {"i64", Token::Type::INT64_SPECIFIER},
+    {"u8", Token::Type::UINT8_SPECIFIER},
+    {"u16", Token::Type::UINT16_SPECIFIER},
+    {"u32", Token::Type::UINT32_SPECIFIER},
+    {"u64", Token::Type::UINT64_SPECIFIER},
+    {"f32", Token::Type::FLT32_SPECIFIER},
+    {"f64", Token::Type::FLT64_SPECIFIER},
+};
+
+/** @brief Returns whether `value` is representable in the suffix's type. */
+static bool FitsIntSuffix(uint64_t value, Token::Type suffix) {
+  switch (suffix) {
+    case Token::Type::INT8_SPECIFIER:
+      return value <= INT8_MAX;
+    case Token::Type::INT16_SPECIFIER:
+      return value <= INT16_MAX;
+    case Token::Type::INT32_SPECIFIER:
+      return value <= INT32_MAX;
+    case Token::Type::INT64_SPECIFIER:
+      return value <= INT64_MAX;
+    case Token::Type::UINT8_SPECIFIER:
+      return value <= UINT8_MAX;
+    case Token::Type::UINT16_SPECIFIER:
+      return value <= UINT16_MAX;
+    case Token::Type::UINT32_SPECIFIER:
+      return value <= UINT32_MAX;
+    case Token::Type::UINT64_SPECIFIER:
+      return true;
+    default:
+      return false;
+  }
+}
+
 Lexer::Lexer(std::string source_str_)
     : start_pos_(0),
       current_pos_(0),
@@ -51,6 +114,7 @@ Lexer::Lexer(const char* source_str_)
       source_str_(source_str_) {}
 
 void Lexer::ScanTokens() {
+  PhaseTimer timer("lex", "Lexing");
   while (!IsEnd()) {
     start_pos_ = current_pos_;
     Scan();
@@ -99,6 +163,9 @@ void Lexer::Scan() {
     case ';':
       AddToken(Token::Type::SEMICOLON);
       break;
+    case '@':
+      AddToken(Token::Type::AT);
+      break;
     // BINOPS
     case '+':
       AddToken(Match('+') ? Token::Type::PlusPlus : Token::Type::Plus);
@@ -122,14 +189,34 @@ void Lexer::Scan() {
       AddToken(Token::Type::STAR);
       break;
     case '>':
+      if (Match('>')) {
+        AddToken(Token::Type::GREATER_GREATER);
+        break;
+      }
       AddToken(Match('=') ? Token::Type::GREATER_EQ : Token::Type::GREATER);
       break;
     case '<':
+      if (Match('<')) {
+        AddToken(Token::Type::LESSER_LESSER);
+        break;
+      }
       AddToken(Match('=') ? Token::Type::LESSER_EQ : Token::Type::LESSER);
       break;
     case '!':
       AddToken(Match('=') ? Token::Type::BANGEQ : Token::Type::BANG);
       break;
+    case '&':
+      AddToken(Match('&') ? Token::Type::AMPAMP : Token::Type::AMP);
+      break;
+    case '|':
+      AddToken(Match('|') ? Token::Type::PIPEPIPE : Token::Type::PIPE);
+      break;
+    case '^':
+      AddToken(Token::Type::CARET);
+      break;
+    case '~':
+      AddToken(Token::Type::TILDE);
+      break;
     case '=':
       AddToken(Match('=') ? Token::Type::EQEQ : Token::Type::EQ);
       break;
@@ -299,23 +386,57 @@ void Lexer::TokenizeNumber() {
   while (!IsEnd() && IsNumeric(PeekChar())) {
     Advance();
   }
+  bool is_float = false;
   if (PeekChar() == '.' && IsNumeric(PeekNextChar())) {
+    is_float = true;
     Advance();
     while (!IsEnd() && IsNumeric(PeekChar())) {
       Advance();
     }
-    size_t index = current_pos_ - start_pos_;
-    std::string temp = source_str_.substr(start_pos_, index);
-    std::optional<TokenValue> literal;
-    literal.emplace(std::in_place_type<float>, std::stof(temp));
+  }
+  size_t digits = current_pos_ - start_pos_;
+  while (!IsEnd() && IsAlphaNumeric(PeekChar())) {
+    Advance();
+  }
+
+  std::string temp = source_str_.substr(start_pos_, current_pos_ - start_pos_);
+  const char* first = temp.data();
+  const char* last = first + digits;
+
+  // Malformed literals are emitted without a value for the parser to report.
+  std::optional<Token::Type> suffix;
+  if (digits < temp.size()) {
+    auto match = literal_suffixes.find(temp.substr(digits));
+    if (match == literal_suffixes.end()) {
+      AddToken(is_float ? Token::Type::FLT_LITERAL : Token::Type::INT_LITERAL,
+               temp, std::nullopt);
+      return;
+    }
+    suffix = match->second;
+  }
+
+  bool float_suffix = suffix == Token::Type::FLT32_SPECIFIER ||
+                      suffix == Token::Type::FLT64_SPECIFIER;
+  std::optional<TokenValue> literal;
+  if (is_float || float_suffix) {
+    double value = 0;
+    auto [end, ec] = std::from_chars(first, last, value);
+    if (ec == std::errc() && (!suffix || float_suffix) &&
+        (suffix != Token::Type::FLT32_SPECIFIER || value <= FLT_MAX)) {
+      literal.emplace(std::in_place_type<double>, value);
+    }
     AddToken(Token::Type::FLT_LITERAL, temp, literal);
   } else {
-    size_t index = current_pos_ - start_pos_;
-    std::string temp = source_str_.substr(start_pos_, index);
-    std::optional<TokenValue> literal;
-    literal.emplace(std::in_place_type<int>, std::stoi(temp));
+    // Literals up to UINT64_MAX keep their bit pattern.
+    uint64_t value = 0;
+    auto [end, ec] = std::from_chars(first, last, value);
+    if (ec == std::errc() && (!suffix || FitsIntSuffix(value, *suffix))) {
+      literal.emplace(std::in_place_type<int64_t>,
+                      static_cast<int64_t>(value));
+    }
     AddToken(Token::Type::INT_LITERAL, temp, literal);
   }
+  tokens_.back().suffix = suffix;
 }
 
 void Lexer::TokenizeDot() {
@@ -354,6 +475,22 @@ std::string Lexer::TokenToString(Token tok) {
       return "!";
     case Token::Type::BANGEQ:
       return "!=";
+    case Token::Type::AMPAMP:
+      return "&&";
+    case Token::Type::PIPEPIPE:
+      return "||";
+    case Token::Type::AMP:
+      return "&";
+    case Token::Type::PIPE:
+      return "|";
+    case Token::Type::CARET:
+      return "^";
+    case Token::Type::TILDE:
+      return "~";
+    case Token::Type::LESSER_LESSER:
+      return "<<";
+    case Token::Type::GREATER_GREATER:
+      return ">>";
     case Token::Type::EQ:
       return "=";
     case Token::Type::EQEQ:
@@ -386,6 +523,8 @@ std::string Lexer::TokenToString(Token tok) {
       return ";";
     case Token::Type::COMMA:
       return ",";
+    case Token::Type::AT:
+      return "@";
     case Token::Type::MOD:
       return "MOD";
     case Token::Type::TRUE:
@@ -402,28 +541,70 @@ std::string Lexer::TokenToString(Token tok) {
       return "RETURN";
     case Token::Type::EXTERN:
       return "EXTERN";
+    case Token::Type::PURE:
+      return "PURE";
+    case Token::Type::CONST:
+      return "CONST";
+    case Token::Type::REF:
+      return "REF";
+    case Token::Type::PTR:
+      return "PTR";
     case Token::Type::FOR:
       return "FOR";
     case Token::Type::WHILE:
       return "WHILE";
+    case Token::Type::MATCH:
+      return "MATCH";
+    case Token::Type::CASE:
+      return "CASE";
+    case Token::Type::LIKELY:
+      return "LIKELY";
+    case Token::Type::UNLIKELY:
+      return "UNLIKELY";
     case Token::Type::IDENTIFER:
       return "IDENTIFIER: " + tok.lexeme;
     case Token::Type::DEF:
       return "DEF";
     case Token::Type::END:
       return "END";
+    case Token::Type::NEW:
+      return "NEW";
     case Token::Type::EOF_:
       return "EOF";
     case Token::Type::ELLIPSIS:
       return "ELIPSIS";
+    case Token::Type::INT8_SPECIFIER:
+      return "INT8 TYPE";
+    case Token::Type::INT16_SPECIFIER:
+      return "INT16 TYPE";
     case Token::Type::INT32_SPECIFIER:
       return "INT32 TYPE";
     case Token::Type::INT64_SPECIFIER:
       return "INT64 TYPE";
+    case Token::Type::UINT8_SPECIFIER:
+      return "UINT8 TYPE";
+    case Token::Type::UINT16_SPECIFIER:
+      return "UINT16 TYPE";
+    case Token::Type::UINT32_SPECIFIER:
+      return "UINT32 TYPE";
+    case Token::Type::UINT64_SPECIFIER:
+      return "UINT64 TYPE";
     case Token::Type::FLT32_SPECIFIER:
       return "FLOAT32 TYPE";
     case Token::Type::FLT64_SPECIFIER:
       return "FLOAT64 TYPE";
+    case Token::Type::FLT32X4_SPECIFIER:
+      return "FLOAT32X4 TYPE";
+    case Token::Type::FLT32X8_SPECIFIER:
+      return "FLOAT32X8 TYPE";
+    case Token::Type::INT32X4_SPECIFIER:
+      return "INT32X4 TYPE";
+    case Token::Type::INT32X8_SPECIFIER:
+      return "INT32X8 TYPE";
+    case Token::Type::BOOLX4_SPECIFIER:
+      return "BOOLX4 TYPE";
+    case Token::Type::BOOLX8_SPECIFIER:
+      return "BOOLX8 TYPE";
     case Token::Type::STR_SPECIFIER:
       return "STR TYPE";
     case Token::Type::BOOL_SPECIFIER:
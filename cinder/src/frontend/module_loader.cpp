@@ -8,8 +8,11 @@
 #include "cinder/ast/stmt/stmt.hpp"
 #include "cinder/frontend/lexer.hpp"
 #include "cinder/frontend/parser.hpp"
+#include "cinder/support/compile_stats.hpp"
+#include "llvm/Support/TimeProfiler.h"
 
 static std::string ReadEntireFile(std::string file_path) {
+  llvm::TimeTraceScope trace("ReadFile", file_path);
   std::fstream file{file_path};
 
   if (!file.is_open()) {
@@ -92,7 +95,9 @@ bool ModuleLoader::LoadFileRecursive(const std::string& file_path,
 
   Lexer lexer{source};
   lexer.ScanTokens();
-  Parser parser{lexer.GetTokens()};
+  std::vector<cinder::Token> tokens = lexer.GetTokens();
+  CompileStats::Global().AddTokens(tokens.size());
+  Parser parser{std::move(tokens)};
   std::unique_ptr<Stmt> root = parser.Parse();
 
   auto casted = root->CastTo<ModuleStmt>();
@@ -107,6 +112,7 @@ bool ModuleLoader::LoadFileRecursive(const std::string& file_path,
     return false;
   }
 
+  llvm::TimeTraceScope trace("ResolveImports", module->name.lexeme);
   for (auto& s : module->stmts) {
     auto* imp = dynamic_cast<ImportStmt*>(s.get());
     if (!imp) continue;
@@ -7,6 +7,7 @@
 
 #include "cinder/ast/expr/expr.hpp"
 #include "cinder/frontend/tokens.hpp"
+#include "cinder/support/phase_timer.hpp"
 #include "cinder/support/raw_outstream.hpp"
 
 using namespace cinder;
@@ -16,6 +17,7 @@ static ostream::RawOutStream errors{2};
 Parser::Parser(std::vector<Token> tokens) : tokens_(tokens), current_tok_(0) {}
 
 std::unique_ptr<Stmt> Parser::Parse() {
+  PhaseTimer timer("parse", "Parsing");
   return ParseModule();
 }
 
@@ -37,6 +39,31 @@ std::unique_ptr<Stmt> Parser::ParseModule() {
 }
 
 std::unique_ptr<Stmt> Parser::FunctionPrototype(bool is_extern) {
+  // Annotations precede the name: `def @noinline @cold report(...)`.
+  InlinePolicy inline_policy = InlinePolicy::Default;
+  CallFrequency frequency = CallFrequency::Default;
+  while (MatchType({Token::Type::AT})) {
+    Token annotation =
+        Consume(Token::Type::IDENTIFER, "expected annotation after '@'");
+    const std::string& kind = annotation.lexeme;
+    bool repeated = false;
+    if (kind == "inline" || kind == "always_inline" || kind == "noinline") {
+      repeated = inline_policy != InlinePolicy::Default;
+      inline_policy = kind == "inline"          ? InlinePolicy::Hint
+                      : kind == "always_inline" ? InlinePolicy::Always
+                                                : InlinePolicy::Never;
+    } else if (kind == "cold" || kind == "hot") {
+      repeated = frequency != CallFrequency::Default;
+      frequency = kind == "cold" ? CallFrequency::Cold : CallFrequency::Hot;
+    } else {
+      ostream::ErrorOutln(errors, "Unknown function annotation:", "@" + kind);
+    }
+    if (repeated) {
+      ostream::ErrorOutln(errors, "Conflicting function annotation:",
+                          "@" + kind);
+    }
+  }
+
   Token name =
       Consume(Token::Type::IDENTIFER, "expected identifier after 'def'");
   Consume(Token::Type::LPAREN, "expected '(' after function name");
@@ -62,13 +89,24 @@ std::unique_ptr<Stmt> Parser::FunctionPrototype(bool is_extern) {
           "expected ')' after end of function declaration");
   Consume(Token::Type::ARROW, "expected '->' prior to the return type");
   Token return_type = ParseTypeToken("expected return type");
-  return std::make_unique<FunctionProto>(name, return_type, args, is_variadic,
-                                         is_extern);
+  auto proto = std::make_unique<FunctionProto>(name, return_type, args,
+                                               is_variadic, is_extern);
+  proto->inline_policy = inline_policy;
+  proto->frequency = frequency;
+  return proto;
 }
 
 std::unique_ptr<Stmt> Parser::ExternFunction() {
   if (MatchType({Token::Type::EXTERN})) {
-    return FunctionPrototype(true);
+    ExternEffects effects = ExternEffects::None;
+    if (MatchType({Token::Type::PURE})) {
+      effects = ExternEffects::Pure;
+    } else if (MatchType({Token::Type::CONST})) {
+      effects = ExternEffects::Const;
+    }
+    std::unique_ptr<Stmt> proto = FunctionPrototype(true);
+    static_cast<FunctionProto&>(*proto).effects = effects;
+    return proto;
   }
   return Function();
 }
@@ -87,12 +125,19 @@ std::unique_ptr<Stmt> Parser::Function() {
 }
 
 std::unique_ptr<Stmt> Parser::Statement() {
-  if (Peek().IsPrimitive()) {
+  if (Peek().IsPrimitive() && !CheckNextType(Token::Type::LPAREN)) {
     return VarDeclaration(ParseTypeToken("expected type specifier"));
   }
-  if (IsTypeDeclarationStart()) {
+  if (IsTypeDeclarationStart() || CheckType(Token::Type::REF) ||
+      CheckType(Token::Type::PTR)) {
     return VarDeclaration(ParseTypeToken("expected type specifier"));
   }
+  if (MatchType({Token::Type::CONST})) {
+    std::unique_ptr<Stmt> decl =
+        VarDeclaration(ParseTypeToken("expected type specifier after 'const'"));
+    static_cast<VarDeclarationStmt&>(*decl).is_const = true;
+    return decl;
+  }
   if (MatchType({Token::Type::STRUCT_SPECIFIER})) {
     return StructDeclaration();
   }
@@ -108,6 +153,9 @@ std::unique_ptr<Stmt> Parser::Statement() {
   if (MatchType({Token::Type::WHILE})) {
     return WhileStatement();
   }
+  if (MatchType({Token::Type::MATCH})) {
+    return MatchStatement();
+  }
   return ExpressionStatement();
 }
 
@@ -119,17 +167,22 @@ std::unique_ptr<Stmt> Parser::ImportStatement() {
 }
 
 std::unique_ptr<Stmt> Parser::WhileStatement() {
+  BranchHint hint = ParseBranchHint();
   std::unique_ptr<Expr> condition = Expression();
   std::vector<std::unique_ptr<Stmt>> body;
   while (!CheckType(Token::Type::END)) {
     body.push_back(Statement());
   }
   Consume(Token::Type::END, "'end' expected after loop");
-  return std::make_unique<WhileStmt>(std::move(condition), std::move(body));
+  auto stmt =
+      std::make_unique<WhileStmt>(std::move(condition), std::move(body));
+  stmt->hint = hint;
+  return stmt;
 }
 
 std::unique_ptr<Stmt> Parser::ForStatement() {
   std::unique_ptr<Stmt> initializer = Statement();
+  BranchHint hint = ParseBranchHint();
   std::unique_ptr<Expr> condition = Expression();
   Consume(Token::Type::SEMICOLON, "';' expected after condition");
   std::unique_ptr<Expr> step = Expression();
@@ -138,18 +191,74 @@ std::unique_ptr<Stmt> Parser::ForStatement() {
     body.push_back(Statement());
   }
   Consume(Token::Type::END, "expected 'end' after the loop");
-  return std::make_unique<ForStmt>(std::move(initializer), std::move(condition),
-                                   std::move(step), std::move(body));
+  auto stmt =
+      std::make_unique<ForStmt>(std::move(initializer), std::move(condition),
+                                std::move(step), std::move(body));
+  stmt->hint = hint;
+  return stmt;
 }
 
 std::unique_ptr<Stmt> Parser::IfStatement() {
+  BranchHint hint = ParseBranchHint();
   std::unique_ptr<Expr> condition = Expression();
   std::unique_ptr<Stmt> then = Statement();
   std::unique_ptr<Stmt> otherwise =
       MatchType({Token::Type::ELSE}) ? Statement() : nullptr;
   Consume(Token::Type::END, "Expected 'end' after if statement");
-  return std::make_unique<IfStmt>(std::move(condition), std::move(then),
-                                  std::move(otherwise));
+  auto stmt = std::make_unique<IfStmt>(std::move(condition), std::move(then),
+                                       std::move(otherwise));
+  stmt->hint = hint;
+  return stmt;
+}
+
+std::unique_ptr<Stmt> Parser::MatchStatement() {
+  Token match_token = Previous();
+  std::unique_ptr<Expr> subject = Expression();
+  auto is_arm_end = [this]() {
+    return CheckType(Token::Type::CASE) || CheckType(Token::Type::ELSE) ||
+           CheckType(Token::Type::END) || IsEnd();
+  };
+
+  std::vector<MatchArm> arms;
+  while (MatchType({Token::Type::CASE})) {
+    MatchArm arm;
+    arm.case_token = Previous();
+    do {
+      MatchPattern pattern;
+      pattern.low = Expression();
+      if (MatchType({Token::Type::ELLIPSIS})) {
+        pattern.high = Expression();
+      }
+      arm.patterns.push_back(std::move(pattern));
+    } while (MatchType({Token::Type::COMMA}));
+    while (!is_arm_end()) {
+      arm.body.push_back(Statement());
+    }
+    arms.push_back(std::move(arm));
+  }
+  if (arms.empty()) {
+    ostream::ErrorOutln(errors, "Expected 'case' after:", "match");
+  }
+
+  std::vector<std::unique_ptr<Stmt>> otherwise;
+  if (MatchType({Token::Type::ELSE})) {
+    while (!CheckType(Token::Type::END) && !IsEnd()) {
+      otherwise.push_back(Statement());
+    }
+  }
+  Consume(Token::Type::END, "expected 'end' after match statement");
+  return std::make_unique<MatchStmt>(match_token, std::move(subject),
+                                     std::move(arms), std::move(otherwise));
+}
+
+BranchHint Parser::ParseBranchHint() {
+  if (MatchType({Token::Type::LIKELY})) {
+    return BranchHint::Likely;
+  }
+  if (MatchType({Token::Type::UNLIKELY})) {
+    return BranchHint::Unlikely;
+  }
+  return BranchHint::None;
 }
 
 std::unique_ptr<Stmt> Parser::ReturnStatement() {
@@ -158,9 +267,26 @@ std::unique_ptr<Stmt> Parser::ReturnStatement() {
     Advance();
     return std::make_unique<ReturnStmt>(tok, nullptr);
   }
+  // `tail` is only a keyword when a callee follows it, so it stays usable as
+  // a variable name.
+  bool is_tail = CheckType(Token::Type::IDENTIFER) && Peek().lexeme == "tail" &&
+                 CheckNextType(Token::Type::IDENTIFER);
+  if (is_tail) {
+    Advance();
+  }
   std::unique_ptr<Expr> expr = Expression();
   Consume(Token::Type::SEMICOLON, "expected ';' after return statement");
-  return std::make_unique<ReturnStmt>(tok, std::move(expr));
+  auto ret = std::make_unique<ReturnStmt>(tok, std::move(expr));
+  if (is_tail) {
+    auto* call = dynamic_cast<CallExpr*>(ret->value.get());
+    if (!call) {
+      ostream::ErrorOutln(errors, "Expected a call after:", "return tail");
+    } else {
+      call->is_tail = true;
+      ret->is_tail = true;
+    }
+  }
+  return ret;
 }
 
 std::unique_ptr<Stmt> Parser::VarDeclaration(Token specifier) {
@@ -208,7 +334,7 @@ std::unique_ptr<Expr> Parser::Expression() {
 }
 
 std::unique_ptr<Expr> Parser::Assignment() {
-  std::unique_ptr<Expr> expr = Comparison();
+  std::unique_ptr<Expr> expr = IfExpression();
   if (MatchType({Token::Type::EQ})) {
     std::unique_ptr<Expr> value = Assignment();
     if (auto* var = dynamic_cast<Variable*>(expr.get())) {
@@ -220,20 +346,107 @@ std::unique_ptr<Expr> Parser::Assignment() {
       return std::make_unique<MemberAssign>(std::move(target),
                                             std::move(value));
     }
+    if (dynamic_cast<IndexAccess*>(expr.get())) {
+      std::unique_ptr<IndexAccess> target(
+          static_cast<IndexAccess*>(expr.release()));
+      return std::make_unique<IndexAssign>(std::move(target),
+                                           std::move(value));
+    }
+  }
+  return expr;
+}
+
+std::unique_ptr<Expr> Parser::IfExpression() {
+  std::unique_ptr<Expr> expr = LogicalOr();
+  if (!CheckType(Token::Type::IF) || CheckNextType(Token::Type::LIKELY) ||
+      CheckNextType(Token::Type::UNLIKELY)) {
+    return expr;
+  }
+  // After a value, `if` only continues the expression when `else` follows
+  // its condition. Otherwise it starts an `if` statement, as in a loop body
+  // right after the loop condition.
+  size_t start = current_tok_;
+  Token if_token = Advance();
+  std::unique_ptr<Expr> cond = LogicalOr();
+  if (!MatchType({Token::Type::ELSE})) {
+    current_tok_ = start;
+    return expr;
+  }
+  std::unique_ptr<Expr> otherwise = IfExpression();
+  return std::make_unique<IfExpr>(std::move(expr), std::move(cond),
+                                  std::move(otherwise), if_token);
+}
+
+std::unique_ptr<Expr> Parser::LogicalOr() {
+  std::unique_ptr<Expr> expr = LogicalAnd();
+  while (MatchType({Token::Type::PIPEPIPE})) {
+    Token op = Previous();
+    std::unique_ptr<Expr> right = LogicalAnd();
+    expr = std::make_unique<Logical>(std::move(expr), std::move(right), op);
+  }
+  return expr;
+}
+
+std::unique_ptr<Expr> Parser::LogicalAnd() {
+  std::unique_ptr<Expr> expr = Comparison();
+  while (MatchType({Token::Type::AMPAMP})) {
+    Token op = Previous();
+    std::unique_ptr<Expr> right = Comparison();
+    expr = std::make_unique<Logical>(std::move(expr), std::move(right), op);
   }
   return expr;
 }
 
 std::unique_ptr<Expr> Parser::Comparison() {
-  std::unique_ptr<Expr> expr = Term();
+  std::unique_ptr<Expr> expr = BitwiseOr();
   while (MatchType(&Token::IsComparison)) {
     Token op = Previous();
-    std::unique_ptr<Expr> right = Term();
+    std::unique_ptr<Expr> right = BitwiseOr();
     expr = std::make_unique<Conditional>(std::move(expr), std::move(right), op);
   }
   return expr;
 }
 
+std::unique_ptr<Expr> Parser::BitwiseOr() {
+  std::unique_ptr<Expr> expr = BitwiseXor();
+  while (MatchType({Token::Type::PIPE})) {
+    Token op = Previous();
+    std::unique_ptr<Expr> right = BitwiseXor();
+    expr = std::make_unique<Binary>(std::move(expr), std::move(right), op);
+  }
+  return expr;
+}
+
+std::unique_ptr<Expr> Parser::BitwiseXor() {
+  std::unique_ptr<Expr> expr = BitwiseAnd();
+  while (MatchType({Token::Type::CARET})) {
+    Token op = Previous();
+    std::unique_ptr<Expr> right = BitwiseAnd();
+    expr = std::make_unique<Binary>(std::move(expr), std::move(right), op);
+  }
+  return expr;
+}
+
+std::unique_ptr<Expr> Parser::BitwiseAnd() {
+  std::unique_ptr<Expr> expr = Shift();
+  while (MatchType({Token::Type::AMP})) {
+    Token op = Previous();
+    std::unique_ptr<Expr> right = Shift();
+    expr = std::make_unique<Binary>(std::move(expr), std::move(right), op);
+  }
+  return expr;
+}
+
+std::unique_ptr<Expr> Parser::Shift() {
+  std::unique_ptr<Expr> expr = Term();
+  while (MatchType(&Token::IsShift)) {
+    Token op = Previous();
+    std::unique_ptr<Expr> right = Term();
+    expr = std::make_unique<Binary>(std::move(expr), std::move(right), op);
+  }
+  return expr;
+}
+
 std::unique_ptr<Expr> Parser::Term() {
   std::unique_ptr<Expr> expr = Factor();
   while (MatchType(&Token::IsTerm)) {
@@ -245,15 +458,23 @@ std::unique_ptr<Expr> Parser::Term() {
 }
 
 std::unique_ptr<Expr> Parser::Factor() {
-  std::unique_ptr<Expr> expr = PreIncrement();
+  std::unique_ptr<Expr> expr = UnaryExpression();
   while (MatchType(&Token::IsFactor)) {
     Token op = Previous();
-    std::unique_ptr<Expr> right = PreIncrement();
+    std::unique_ptr<Expr> right = UnaryExpression();
     expr = std::make_unique<Binary>(std::move(expr), std::move(right), op);
   }
   return expr;
 }
 
+std::unique_ptr<Expr> Parser::UnaryExpression() {
+  if (MatchType({Token::Type::BANG, Token::Type::TILDE})) {
+    Token op = Previous();
+    return std::make_unique<Unary>(op, UnaryExpression());
+  }
+  return PreIncrement();
+}
+
 std::unique_ptr<Expr> Parser::PreIncrement() {
   if (MatchType({Token::Type::PlusPlus, Token::Type::MinusMinus})) {
     Token op = Previous();
@@ -292,6 +513,30 @@ std::unique_ptr<Expr> Parser::Call() {
       continue;
     }
 
+    if (MatchType({Token::Type::LBRACKET})) {
+      std::unique_ptr<Expr> index;
+      if (!CheckType(Token::Type::COLON)) {
+        index = Expression();
+      }
+      // `x[a:b]`, `x[:b]`, `x[a:]` and `x[:]` take a subrange.
+      if (MatchType({Token::Type::COLON})) {
+        std::unique_ptr<Expr> end;
+        if (!CheckType(Token::Type::RBRACKET)) {
+          end = Expression();
+        }
+        Token bracket =
+            Consume(Token::Type::RBRACKET, "expected ']' after slice bounds");
+        expr = std::make_unique<SliceExpr>(std::move(expr), std::move(index),
+                                           std::move(end), bracket);
+        continue;
+      }
+      Token bracket =
+          Consume(Token::Type::RBRACKET, "expected ']' after index");
+      expr = std::make_unique<IndexAccess>(std::move(expr), std::move(index),
+                                           bracket);
+      continue;
+    }
+
     break;
   }
 
@@ -305,7 +550,14 @@ std::unique_ptr<Expr> Parser::Atom() {
   // }
 
   if (MatchType(&Token::IsLiteral)) {
-    return std::make_unique<Literal>(Previous().literal.value());
+    Token literal = Previous();
+    if (!literal.literal.has_value()) {
+      ostream::ErrorOutln(errors, "Invalid numeric literal:", literal.lexeme);
+      return nullptr;
+    }
+    auto expr = std::make_unique<Literal>(literal.literal.value());
+    expr->suffix = literal.suffix;
+    return expr;
   }
 
   if (MatchType({Token::Type::TRUE})) {
@@ -320,16 +572,94 @@ std::unique_ptr<Expr> Parser::Atom() {
     return std::make_unique<Variable>(Previous());
   }
 
+  if ((Peek().IsInt() || Peek().IsFloat() || Peek().IsVector()) &&
+      CheckNextType(Token::Type::LPAREN)) {
+    return ConversionExpression();
+  }
+
   if (MatchType({Token::Type::LPAREN})) {
     std::unique_ptr<Expr> expr = Expression();
     Consume(Token::Type::RPAREN, "Expected ')' after grouping");
     return std::make_unique<Grouping>(std::move(expr));
   }
+
+  if (MatchType({Token::Type::LBRACKET})) {
+    return ArrayLiteralExpression();
+  }
+
+  if (MatchType({Token::Type::NEW})) {
+    return NewArrayExpression();
+  }
+
+  if (MatchType({Token::Type::AT})) {
+    return IntrinsicExpression();
+  }
   ostream::ErrorOutln(errors, "Expected expression:", Peek().lexeme);
   return nullptr;
 }
 
+std::unique_ptr<Expr> Parser::ArrayLiteralExpression() {
+  Token bracket = Previous();
+  std::vector<std::unique_ptr<Expr>> elements;
+  if (!CheckType(Token::Type::RBRACKET)) {
+    do {
+      elements.push_back(Expression());
+    } while (MatchType({Token::Type::COMMA}));
+  }
+  Consume(Token::Type::RBRACKET, "expected ']' after array literal");
+  return std::make_unique<ArrayLiteral>(bracket, std::move(elements));
+}
+
+std::unique_ptr<Expr> Parser::NewArrayExpression() {
+  Token keyword = Previous();
+  Token element = ParseBaseTypeToken("expected element type after 'new'");
+  Consume(Token::Type::LBRACKET, "expected '[' after element type");
+  std::unique_ptr<Expr> length = Expression();
+  Consume(Token::Type::RBRACKET, "expected ']' after slice length");
+  return std::make_unique<NewArray>(keyword, element, std::move(length));
+}
+
+std::unique_ptr<Expr> Parser::IntrinsicExpression() {
+  Token name = Consume(Token::Type::IDENTIFER, "expected intrinsic after '@'");
+  Consume(Token::Type::LPAREN, "expected '(' after intrinsic name");
+  std::vector<std::unique_ptr<Expr>> args;
+  if (!CheckType(Token::Type::RPAREN)) {
+    do {
+      args.push_back(Expression());
+    } while (MatchType({Token::Type::COMMA}));
+  }
+  Consume(Token::Type::RPAREN, "expected ')' after intrinsic arguments");
+  return std::make_unique<IntrinsicCall>(name, std::move(args));
+}
+
+std::unique_ptr<Expr> Parser::ConversionExpression() {
+  Token target = Advance();
+  Consume(Token::Type::LPAREN, "expected '(' after conversion type");
+  std::unique_ptr<Expr> value = Expression();
+  Consume(Token::Type::RPAREN, "expected ')' after conversion operand");
+  return std::make_unique<Cast>(target, std::move(value));
+}
+
 Token Parser::ParseTypeToken(const std::string& context) {
+  if (MatchType({Token::Type::REF, Token::Type::PTR})) {
+    std::string prefix = Previous().lexeme;
+    Token type = ParseTypeToken(context);
+    type.lexeme = prefix + " " + type.lexeme;
+    return type;
+  }
+  Token type = ParseBaseTypeToken(context);
+  while (MatchType({Token::Type::LBRACKET})) {
+    if (MatchType({Token::Type::INT_LITERAL})) {
+      type.lexeme += "[" + Previous().lexeme + "]";
+    } else {
+      type.lexeme += "[]";
+    }
+    Consume(Token::Type::RBRACKET, "expected ']' in array type");
+  }
+  return type;
+}
+
+Token Parser::ParseBaseTypeToken(const std::string& context) {
   if (MatchType(&Token::IsPrimitive)) {
     return Previous();
   }
@@ -360,6 +690,19 @@ bool Parser::IsTypeDeclarationStart() {
     idx += 2;
   }
 
+  // Array suffixes: `[]` or `[N]`.
+  while (idx < tokens_.size() && tokens_[idx].kind == Token::Type::LBRACKET) {
+    ++idx;
+    if (idx < tokens_.size() &&
+        tokens_[idx].kind == Token::Type::INT_LITERAL) {
+      ++idx;
+    }
+    if (idx >= tokens_.size() || tokens_[idx].kind != Token::Type::RBRACKET) {
+      return false;
+    }
+    ++idx;
+  }
+
   if (idx >= tokens_.size()) {
     return false;
   }
@@ -12,13 +12,26 @@ bool Token::IsLiteral() {
 }
 
 bool Token::IsInt() {
-  return kind == Type::INT32_SPECIFIER || kind == Type::INT64_SPECIFIER;
+  return kind == Type::INT8_SPECIFIER || kind == Type::INT16_SPECIFIER ||
+         kind == Type::INT32_SPECIFIER || kind == Type::INT64_SPECIFIER ||
+         IsUnsigned();
+}
+
+bool Token::IsUnsigned() {
+  return kind == Type::UINT8_SPECIFIER || kind == Type::UINT16_SPECIFIER ||
+         kind == Type::UINT32_SPECIFIER || kind == Type::UINT64_SPECIFIER;
 }
 
 bool Token::IsFloat() {
   return kind == Type::FLT32_SPECIFIER || kind == Type::FLT64_SPECIFIER;
 }
 
+bool Token::IsVector() {
+  return kind == Type::FLT32X4_SPECIFIER || kind == Type::FLT32X8_SPECIFIER ||
+         kind == Type::INT32X4_SPECIFIER || kind == Type::INT32X8_SPECIFIER ||
+         kind == Type::BOOLX4_SPECIFIER || kind == Type::BOOLX8_SPECIFIER;
+}
+
 bool Token::IsString() {
   return kind == Type::STR_SPECIFIER;
 }
@@ -29,7 +42,7 @@ bool Token::IsVoid() {
 
 bool Token::IsPrimitive() {
   return IsFloat() || IsBool() || IsInt() || IsFloat() || IsString() ||
-         IsVoid();
+         IsVoid() || IsVector();
 }
 
 bool Token::IsStruct() {
@@ -45,7 +58,11 @@ bool Token::IsBool() {
 }
 
 bool Token::IsFactor() {
-  return kind == Type::STAR || kind == Type::SLASH;
+  return kind == Type::STAR || kind == Type::SLASH || kind == Type::MODULO;
+}
+
+bool Token::IsShift() {
+  return kind == Type::LESSER_LESSER || kind == Type::GREATER_GREATER;
 }
 
 bool Token::IsTerm() {
@@ -0,0 +1,293 @@
+#include "cinder/semantic/alias_analysis.hpp"
+
+using namespace cinder;
+
+void AliasAnalysis::Run(const std::vector<ModuleStmt*>& modules) {
+  for (ModuleStmt* mod : modules) {
+    Analyze(mod);
+  }
+}
+
+void AliasAnalysis::Analyze(Stmt* stmt) {
+  if (stmt) {
+    stmt->Accept(*this);
+  }
+}
+
+void AliasAnalysis::Analyze(Expr* expr) {
+  if (expr) {
+    expr->Accept(*this);
+  }
+}
+
+int AliasAnalysis::RootOf(SymbolId id) {
+  auto it = roots_.find(id);
+  return it == roots_.end() ? kShared : it->second;
+}
+
+int AliasAnalysis::RootOf(Expr* expr) {
+  while (expr) {
+    if (auto* index = dynamic_cast<IndexAccess*>(expr)) {
+      if (index->object->type && index->object->type->Slice()) {
+        return kShared;
+      }
+      expr = index->object.get();
+    } else if (auto* member = dynamic_cast<MemberAccess*>(expr);
+               member && member->field_index.has_value()) {
+      expr = member->object.get();
+    } else {
+      break;
+    }
+  }
+  if (expr && (expr->IsVariable() || expr->IsMemberAccess()) &&
+      expr->HasID()) {
+    return RootOf(expr->GetID());
+  }
+  return kShared;
+}
+
+void AliasAnalysis::Touch(int root, bool write) {
+  if (root == kLocal) {
+    return;
+  }
+  Access& access = root == kShared ? shared_ : params_[root];
+  (write ? access.written : access.read) = true;
+}
+
+void AliasAnalysis::Visit(ModuleStmt& stmt) {
+  for (auto& s : stmt.stmts) {
+    Analyze(s.get());
+  }
+}
+
+void AliasAnalysis::Visit(ImportStmt& stmt) {}
+
+void AliasAnalysis::Visit(StructStmt& stmt) {}
+
+void AliasAnalysis::Visit(FunctionProto& stmt) {}
+
+void AliasAnalysis::Visit(FunctionStmt& stmt) {
+  auto* proto = dynamic_cast<FunctionProto*>(stmt.proto.get());
+  if (!proto) {
+    return;
+  }
+  roots_.clear();
+  shared_ = {};
+
+  // By-value parameters are copies the function owns. A `ptr` may come from
+  // C, so it is counted as shared storage.
+  std::vector<FuncArg*> refs;
+  for (FuncArg& arg : proto->args) {
+    if (!arg.id) {
+      continue;
+    }
+    auto* ref = dynamic_cast<types::ReferenceType*>(arg.resolved_type);
+    if (!ref) {
+      roots_[*arg.id] = kLocal;
+    } else if (ref->nullable) {
+      roots_[*arg.id] = kShared;
+    } else {
+      roots_[*arg.id] = static_cast<int>(refs.size());
+      refs.push_back(&arg);
+    }
+  }
+  params_.assign(refs.size(), Access{});
+
+  for (auto& s : stmt.body) {
+    Analyze(s.get());
+  }
+
+  for (size_t i = 0; i < refs.size(); ++i) {
+    Access others = shared_;
+    for (size_t j = 0; j < params_.size(); ++j) {
+      if (j != i) {
+        others.read |= params_[j].read;
+        others.written |= params_[j].written;
+      }
+    }
+    const Access& self = params_[i];
+    bool conflict = (self.written && (others.read || others.written)) ||
+                    (others.written && (self.read || self.written));
+    refs[i]->no_alias = !conflict;
+  }
+}
+
+void AliasAnalysis::Visit(ForStmt& stmt) {
+  Analyze(stmt.initializer.get());
+  Analyze(stmt.condition.get());
+  Analyze(stmt.step.get());
+  for (auto& s : stmt.body) {
+    Analyze(s.get());
+  }
+}
+
+void AliasAnalysis::Visit(WhileStmt& stmt) {
+  Analyze(stmt.condition.get());
+  for (auto& s : stmt.body) {
+    Analyze(s.get());
+  }
+}
+
+void AliasAnalysis::Visit(IfStmt& stmt) {
+  Analyze(stmt.cond.get());
+  Analyze(stmt.then.get());
+  Analyze(stmt.otherwise.get());
+}
+
+void AliasAnalysis::Visit(MatchStmt& stmt) {
+  // Case values are constants, so only the subject and arms can touch memory.
+  Analyze(stmt.subject.get());
+  for (MatchArm& arm : stmt.arms) {
+    for (auto& s : arm.body) {
+      Analyze(s.get());
+    }
+  }
+  for (auto& s : stmt.otherwise) {
+    Analyze(s.get());
+  }
+}
+
+void AliasAnalysis::Visit(ExpressionStmt& stmt) {
+  Analyze(stmt.expr.get());
+}
+
+void AliasAnalysis::Visit(ReturnStmt& stmt) {
+  Analyze(stmt.value.get());
+}
+
+void AliasAnalysis::Visit(VarDeclarationStmt& stmt) {
+  if (stmt.is_global) {
+    return;
+  }
+  Analyze(stmt.value.get());
+  if (stmt.id) {
+    bool is_ref = stmt.resolved_type && stmt.resolved_type->Reference();
+    roots_[*stmt.id] = is_ref ? RootOf(stmt.value.get()) : kLocal;
+  }
+}
+
+void AliasAnalysis::Visit(Variable& expr) {
+  if (expr.HasID() && !expr.constant) {
+    Touch(RootOf(expr.GetID()), false);
+  }
+}
+
+void AliasAnalysis::Visit(MemberAccess& expr) {
+  if (expr.field_index.has_value() || !expr.HasID()) {
+    Analyze(expr.object.get());
+  } else if (!expr.constant) {
+    Touch(RootOf(expr.GetID()), false);
+  }
+}
+
+void AliasAnalysis::Visit(Literal& expr) {}
+
+void AliasAnalysis::Visit(Grouping& expr) {
+  Analyze(expr.expr.get());
+}
+
+void AliasAnalysis::Visit(Binary& expr) {
+  Analyze(expr.left.get());
+  Analyze(expr.right.get());
+}
+
+void AliasAnalysis::Visit(Conditional& expr) {
+  Analyze(expr.left.get());
+  Analyze(expr.right.get());
+}
+
+void AliasAnalysis::Visit(Logical& expr) {
+  Analyze(expr.left.get());
+  Analyze(expr.right.get());
+}
+
+void AliasAnalysis::Visit(Unary& expr) {
+  Analyze(expr.operand.get());
+}
+
+void AliasAnalysis::Visit(IfExpr& expr) {
+  Analyze(expr.cond.get());
+  Analyze(expr.then.get());
+  Analyze(expr.otherwise.get());
+}
+
+void AliasAnalysis::Visit(Assign& expr) {
+  Analyze(expr.value.get());
+  if (expr.HasID()) {
+    Touch(RootOf(expr.GetID()), true);
+  }
+}
+
+void AliasAnalysis::Visit(PreFixOp& expr) {
+  if (expr.HasID()) {
+    Touch(RootOf(expr.GetID()), false);
+    Touch(RootOf(expr.GetID()), true);
+  }
+}
+
+void AliasAnalysis::Visit(MemberAssign& expr) {
+  Analyze(expr.value.get());
+  if (expr.base_id) {
+    Touch(RootOf(*expr.base_id), true);
+  }
+}
+
+void AliasAnalysis::Visit(IndexAssign& expr) {
+  Analyze(expr.target.get());
+  Analyze(expr.value.get());
+  Touch(RootOf(expr.target.get()), true);
+}
+
+void AliasAnalysis::Visit(IndexAccess& expr) {
+  Analyze(expr.object.get());
+  Analyze(expr.index.get());
+  if (expr.object->type && expr.object->type->Slice()) {
+    Touch(kShared, false);
+  }
+}
+
+void AliasAnalysis::Visit(CallExpr& expr) {
+  auto* callee = dynamic_cast<types::FunctionType*>(expr.callee->type);
+  if (callee) {
+    // The callee may reach any global and anything passed to it.
+    Touch(kShared, false);
+    Touch(kShared, true);
+  }
+  for (size_t i = 0; i < expr.args.size(); ++i) {
+    Expr* arg = expr.args[i].get();
+    Analyze(arg);
+    if (!callee || i >= callee->params.size() || !arg->type) {
+      continue;
+    }
+    types::Type* param = callee->params[i];
+    if (param->Reference() || (param->Slice() && arg->type->Array())) {
+      Touch(RootOf(arg), true);
+    }
+  }
+}
+
+void AliasAnalysis::Visit(ArrayLiteral& expr) {
+  for (auto& element : expr.elements) {
+    Analyze(element.get());
+  }
+}
+
+void AliasAnalysis::Visit(NewArray& expr) {
+  Analyze(expr.length.get());
+}
+
+void AliasAnalysis::Visit(Cast& expr) {
+  Analyze(expr.value.get());
+}
+
+void AliasAnalysis::Visit(IntrinsicCall& expr) {
+  for (auto& arg : expr.args) {
+    Analyze(arg.get());
+  }
+}
+
+void AliasAnalysis::Visit(SliceExpr& expr) {
+  Analyze(expr.object.get());
+  Analyze(expr.start.get());
+  Analyze(expr.end.get());
+}
@@ -0,0 +1,611 @@
+#include "cinder/semantic/bounds_check.hpp"
+
+#include "cinder/frontend/tokens.hpp"
+
+using namespace cinder;
+
+namespace {
+
+/** @brief Collects the symbols a loop body may write, and early exits. */
+struct WriteCollector : SemanticExprVisitor, SemanticStmtVisitor {
+  std::unordered_set<SymbolId>& written;
+  std::unordered_set<SymbolId>& references;
+  bool has_return = false;
+  bool writes_aliased = false; /**< Assigns through a reference. */
+
+  WriteCollector(std::unordered_set<SymbolId>& written,
+                 std::unordered_set<SymbolId>& references)
+      : written(written), references(references) {}
+
+  /** @brief Records a write of the whole variable `id`. */
+  void Write(SymbolId id) {
+    written.insert(id);
+    if (references.count(id)) {
+      writes_aliased = true;
+    }
+  }
+
+  using SemanticExprVisitor::Visit;
+  using SemanticStmtVisitor::Visit;
+
+  void Collect(Expr* expr) {
+    if (expr) {
+      expr->Accept(*this);
+    }
+  }
+
+  void Collect(Stmt* stmt) {
+    if (stmt) {
+      stmt->Accept(*this);
+    }
+  }
+
+  void Collect(const std::vector<std::unique_ptr<Stmt>>& stmts) {
+    for (const auto& stmt : stmts) {
+      Collect(stmt.get());
+    }
+  }
+
+  void Visit(Literal& expr) override {}
+  void Visit(Variable& expr) override {}
+  void Visit(MemberAccess& expr) override { Collect(expr.object.get()); }
+  void Visit(Grouping& expr) override { Collect(expr.expr.get()); }
+  void Visit(PreFixOp& expr) override {
+    if (expr.HasID()) {
+      Write(expr.GetID());
+    }
+  }
+  void Visit(Binary& expr) override {
+    Collect(expr.left.get());
+    Collect(expr.right.get());
+  }
+  void Visit(CallExpr& expr) override {
+    Collect(expr.callee.get());
+    auto* callee = dynamic_cast<types::FunctionType*>(expr.callee->type);
+    for (size_t i = 0; i < expr.args.size(); ++i) {
+      // The callee may assign a variable passed by reference. Fields and
+      // elements passed that way never change a length or a variable.
+      Expr* arg = expr.args[i].get();
+      bool by_ref = callee && i < callee->params.size() &&
+                    callee->params[i]->Reference();
+      if (by_ref && (arg->IsVariable() || arg->IsMemberAccess()) &&
+          arg->HasID()) {
+        Write(arg->GetID());
+      }
+      Collect(arg);
+    }
+  }
+  void Visit(Assign& expr) override {
+    if (expr.HasID()) {
+      Write(expr.GetID());
+    }
+    Collect(expr.value.get());
+  }
+  void Visit(MemberAssign& expr) override {
+    Collect(expr.target.get());
+    Collect(expr.value.get());
+  }
+  void Visit(Conditional& expr) override {
+    Collect(expr.left.get());
+    Collect(expr.right.get());
+  }
+  void Visit(Logical& expr) override {
+    Collect(expr.left.get());
+    Collect(expr.right.get());
+  }
+  void Visit(Unary& expr) override { Collect(expr.operand.get()); }
+  void Visit(IfExpr& expr) override {
+    Collect(expr.cond.get());
+    Collect(expr.then.get());
+    Collect(expr.otherwise.get());
+  }
+  void Visit(IndexAccess& expr) override {
+    Collect(expr.object.get());
+    Collect(expr.index.get());
+  }
+  void Visit(IndexAssign& expr) override {
+    Collect(expr.target.get());
+    Collect(expr.value.get());
+  }
+  void Visit(ArrayLiteral& expr) override {
+    for (const auto& element : expr.elements) {
+      Collect(element.get());
+    }
+  }
+  void Visit(NewArray& expr) override { Collect(expr.length.get()); }
+  void Visit(Cast& expr) override { Collect(expr.value.get()); }
+  void Visit(IntrinsicCall& expr) override {
+    for (const auto& arg : expr.args) {
+      Collect(arg.get());
+    }
+  }
+  void Visit(SliceExpr& expr) override {
+    Collect(expr.object.get());
+    Collect(expr.start.get());
+    Collect(expr.end.get());
+  }
+
+  void Visit(ExpressionStmt& stmt) override { Collect(stmt.expr.get()); }
+  void Visit(FunctionStmt& stmt) override {}
+  void Visit(ReturnStmt& stmt) override {
+    has_return = true;
+    Collect(stmt.value.get());
+  }
+  void Visit(VarDeclarationStmt& stmt) override {
+    // Declarations in the body take a fresh value every iteration.
+    if (stmt.id.has_value()) {
+      written.insert(*stmt.id);
+      if (stmt.resolved_type && stmt.resolved_type->Reference()) {
+        references.insert(*stmt.id);
+      }
+    }
+    Collect(stmt.value.get());
+  }
+  void Visit(FunctionProto& stmt) override {}
+  void Visit(ModuleStmt& stmt) override {}
+  void Visit(IfStmt& stmt) override {
+    Collect(stmt.cond.get());
+    Collect(stmt.then.get());
+    Collect(stmt.otherwise.get());
+  }
+  void Visit(ForStmt& stmt) override {
+    Collect(stmt.initializer.get());
+    Collect(stmt.condition.get());
+    Collect(stmt.step.get());
+    Collect(stmt.body);
+  }
+  void Visit(WhileStmt& stmt) override {
+    Collect(stmt.condition.get());
+    Collect(stmt.body);
+  }
+  void Visit(MatchStmt& stmt) override {
+    Collect(stmt.subject.get());
+    for (MatchArm& arm : stmt.arms) {
+      Collect(arm.body);
+    }
+    Collect(stmt.otherwise);
+  }
+  void Visit(ImportStmt& stmt) override {}
+  void Visit(StructStmt& stmt) override {}
+};
+
+Expr* StripGrouping(Expr* expr) {
+  while (auto* group = dynamic_cast<Grouping*>(expr)) {
+    expr = group->expr.get();
+  }
+  return expr;
+}
+
+/** @brief Returns the symbol `expr` names when it is a plain variable. */
+std::optional<SymbolId> VariableId(Expr* expr) {
+  expr = StripGrouping(expr);
+  if (expr && expr->IsVariable() && expr->HasID()) {
+    return expr->GetID();
+  }
+  return std::nullopt;
+}
+
+/** @brief Returns the folded value of `expr` when it is an integer. */
+const int64_t* ConstantInt(Expr* expr) {
+  if (!expr || !expr->constant) {
+    return nullptr;
+  }
+  return std::get_if<int64_t>(&*expr->constant);
+}
+
+/** @brief Returns the value `expr` measures when it is `x.len`. */
+Expr* LengthOperand(Expr* expr) {
+  auto* access = dynamic_cast<MemberAccess*>(StripGrouping(expr));
+  if (!access || access->member.lexeme != "len" || !access->object->type) {
+    return nullptr;
+  }
+  types::Type* type = access->object->type;
+  if (!type->Array() && !type->Slice() && !type->Vector()) {
+    return nullptr;
+  }
+  return access->object.get();
+}
+
+}  // namespace
+
+void BoundsCheckAnalysis::Run(const std::vector<ModuleStmt*>& modules) {
+  for (ModuleStmt* mod : modules) {
+    for (auto& stmt : mod->stmts) {
+      auto* global = dynamic_cast<VarDeclarationStmt*>(stmt.get());
+      if (global && global->is_global && !global->is_const && global->HasID()) {
+        globals_.insert(global->GetID());
+      }
+    }
+  }
+  for (ModuleStmt* mod : modules) {
+    Analyze(mod);
+  }
+}
+
+void BoundsCheckAnalysis::Analyze(Stmt* stmt) {
+  if (stmt) {
+    stmt->Accept(*this);
+  }
+}
+
+void BoundsCheckAnalysis::Analyze(Expr* expr) {
+  if (expr) {
+    expr->Accept(*this);
+  }
+}
+
+void BoundsCheckAnalysis::Visit(ModuleStmt& stmt) {
+  for (auto& s : stmt.stmts) {
+    Analyze(s.get());
+  }
+}
+
+void BoundsCheckAnalysis::Visit(ImportStmt& stmt) {}
+
+void BoundsCheckAnalysis::Visit(StructStmt& stmt) {}
+
+void BoundsCheckAnalysis::Visit(FunctionProto& stmt) {}
+
+void BoundsCheckAnalysis::Visit(FunctionStmt& stmt) {
+  loops_.clear();
+  references_.clear();
+  if (auto* proto = dynamic_cast<FunctionProto*>(stmt.proto.get())) {
+    for (const FuncArg& arg : proto->args) {
+      if (arg.id && arg.resolved_type && arg.resolved_type->Reference()) {
+        references_.insert(*arg.id);
+      }
+    }
+  }
+  for (auto& s : stmt.body) {
+    Analyze(s.get());
+  }
+}
+
+void BoundsCheckAnalysis::Visit(ForStmt& stmt) {
+  Analyze(stmt.initializer.get());
+
+  LoopFacts facts = CountedLoopFacts(stmt);
+  if (facts.stmt) {
+    stmt.range_bound =
+        dynamic_cast<Conditional*>(stmt.condition.get())->right.get();
+  }
+
+  // The condition and step run once per iteration as well.
+  loops_.push_back(std::move(facts));
+  Analyze(stmt.condition.get());
+  Analyze(stmt.step.get());
+  for (auto& s : stmt.body) {
+    Analyze(s.get());
+  }
+  loops_.pop_back();
+}
+
+void BoundsCheckAnalysis::Visit(WhileStmt& stmt) {
+  LoopFacts facts;
+  WriteCollector collector{facts.written, references_};
+  collector.Collect(stmt.body);
+  facts.has_return = collector.has_return;
+
+  loops_.push_back(std::move(facts));
+  Analyze(stmt.condition.get());
+  for (auto& s : stmt.body) {
+    Analyze(s.get());
+  }
+  loops_.pop_back();
+}
+
+void BoundsCheckAnalysis::Visit(IfStmt& stmt) {
+  Analyze(stmt.cond.get());
+  if (!loops_.empty()) {
+    ++loops_.back().branch_depth;
+  }
+  Analyze(stmt.then.get());
+  Analyze(stmt.otherwise.get());
+  if (!loops_.empty()) {
+    --loops_.back().branch_depth;
+  }
+}
+
+void BoundsCheckAnalysis::Visit(MatchStmt& stmt) {
+  Analyze(stmt.subject.get());
+  if (!loops_.empty()) {
+    ++loops_.back().branch_depth;
+  }
+  for (MatchArm& arm : stmt.arms) {
+    for (auto& s : arm.body) {
+      Analyze(s.get());
+    }
+  }
+  for (auto& s : stmt.otherwise) {
+    Analyze(s.get());
+  }
+  if (!loops_.empty()) {
+    --loops_.back().branch_depth;
+  }
+}
+
+void BoundsCheckAnalysis::Visit(ExpressionStmt& stmt) {
+  Analyze(stmt.expr.get());
+}
+
+void BoundsCheckAnalysis::Visit(ReturnStmt& stmt) {
+  Analyze(stmt.value.get());
+}
+
+void BoundsCheckAnalysis::Visit(VarDeclarationStmt& stmt) {
+  Analyze(stmt.value.get());
+  if (stmt.id && stmt.resolved_type && stmt.resolved_type->Reference()) {
+    references_.insert(*stmt.id);
+  }
+}
+
+void BoundsCheckAnalysis::Visit(Variable& expr) {}
+
+void BoundsCheckAnalysis::Visit(Literal& expr) {}
+
+void BoundsCheckAnalysis::Visit(PreFixOp& expr) {}
+
+void BoundsCheckAnalysis::Visit(MemberAccess& expr) {
+  Analyze(expr.object.get());
+}
+
+void BoundsCheckAnalysis::Visit(Grouping& expr) {
+  Analyze(expr.expr.get());
+}
+
+void BoundsCheckAnalysis::Visit(Binary& expr) {
+  Analyze(expr.left.get());
+  Analyze(expr.right.get());
+}
+
+void BoundsCheckAnalysis::Visit(Conditional& expr) {
+  Analyze(expr.left.get());
+  Analyze(expr.right.get());
+}
+
+void BoundsCheckAnalysis::Visit(Logical& expr) {
+  Analyze(expr.left.get());
+  // The right side only runs when the left does not decide the result.
+  if (!loops_.empty()) {
+    ++loops_.back().branch_depth;
+  }
+  Analyze(expr.right.get());
+  if (!loops_.empty()) {
+    --loops_.back().branch_depth;
+  }
+}
+
+void BoundsCheckAnalysis::Visit(Unary& expr) {
+  Analyze(expr.operand.get());
+}
+
+void BoundsCheckAnalysis::Visit(IfExpr& expr) {
+  Analyze(expr.cond.get());
+  if (!loops_.empty()) {
+    ++loops_.back().branch_depth;
+  }
+  Analyze(expr.then.get());
+  Analyze(expr.otherwise.get());
+  if (!loops_.empty()) {
+    --loops_.back().branch_depth;
+  }
+}
+
+void BoundsCheckAnalysis::Visit(Assign& expr) {
+  Analyze(expr.value.get());
+}
+
+void BoundsCheckAnalysis::Visit(MemberAssign& expr) {
+  Analyze(expr.target.get());
+  Analyze(expr.value.get());
+}
+
+void BoundsCheckAnalysis::Visit(CallExpr& expr) {
+  Analyze(expr.callee.get());
+  for (auto& arg : expr.args) {
+    Analyze(arg.get());
+  }
+}
+
+void BoundsCheckAnalysis::Visit(IndexAssign& expr) {
+  Analyze(expr.target.get());
+  Analyze(expr.value.get());
+}
+
+void BoundsCheckAnalysis::Visit(ArrayLiteral& expr) {
+  for (auto& element : expr.elements) {
+    Analyze(element.get());
+  }
+}
+
+void BoundsCheckAnalysis::Visit(NewArray& expr) {
+  Analyze(expr.length.get());
+}
+
+void BoundsCheckAnalysis::Visit(Cast& expr) {
+  Analyze(expr.value.get());
+}
+
+void BoundsCheckAnalysis::Visit(IntrinsicCall& expr) {
+  auto* access = expr.args.empty()
+                     ? nullptr
+                     : dynamic_cast<IndexAccess*>(expr.args[0].get());
+  if (expr.kind == IntrinsicKind::Prefetch && access) {
+    // A prefetch never faults, so its address is not checked, let alone
+    // hoisted; only the operands are visited.
+    Analyze(access->object.get());
+    Analyze(access->index.get());
+    return;
+  }
+  for (auto& arg : expr.args) {
+    Analyze(arg.get());
+  }
+}
+
+void BoundsCheckAnalysis::Visit(SliceExpr& expr) {
+  Analyze(expr.object.get());
+  Analyze(expr.start.get());
+  Analyze(expr.end.get());
+}
+
+void BoundsCheckAnalysis::Visit(IndexAccess& expr) {
+  Analyze(expr.object.get());
+  Analyze(expr.index.get());
+  expr.bounds = BoundsCheck::Required;
+  expr.loop_offset = nullptr;
+  if (!expr.object->type || !expr.index->type) {
+    return;
+  }
+
+  for (auto it = loops_.rbegin(); it != loops_.rend(); ++it) {
+    if (it->stmt && IsProven(expr, *it)) {
+      expr.bounds = BoundsCheck::Proven;
+      return;
+    }
+  }
+  if (TryHoist(expr)) {
+    expr.bounds = BoundsCheck::Hoisted;
+  }
+}
+
+BoundsCheckAnalysis::LoopFacts BoundsCheckAnalysis::CountedLoopFacts(
+    ForStmt& stmt) {
+  LoopFacts facts;
+  WriteCollector collector{facts.written, references_};
+  collector.Collect(stmt.body);
+  facts.has_return = collector.has_return;
+  // Any variable, the induction variable included, may be behind the
+  // reference, so nothing is known about the loop.
+  if (collector.writes_aliased) {
+    return facts;
+  }
+
+  auto* init = dynamic_cast<VarDeclarationStmt*>(stmt.initializer.get());
+  auto* cond = dynamic_cast<Conditional*>(stmt.condition.get());
+  auto* step = dynamic_cast<PreFixOp*>(stmt.step.get());
+  if (!init || !init->id.has_value() || !init->resolved_type ||
+      !init->resolved_type->Int() || !cond || !step) {
+    return facts;
+  }
+
+  SymbolId induction = *init->id;
+  if (cond->op.kind != Token::Type::LESSER ||
+      VariableId(cond->left.get()) != induction ||
+      step->op.kind != Token::Type::PlusPlus || !step->HasID() ||
+      step->GetID() != induction || facts.written.count(induction)) {
+    return facts;
+  }
+
+  facts.induction = induction;
+  if (!IsInvariant(cond->right.get(), facts)) {
+    return facts;
+  }
+
+  if (const int64_t* start = ConstantInt(init->value.get())) {
+    facts.non_negative = *start >= 0;
+  }
+  facts.stmt = &stmt;
+  return facts;
+}
+
+bool BoundsCheckAnalysis::IsInvariant(Expr* expr, const LoopFacts& loop) {
+  expr = StripGrouping(expr);
+  if (!expr) {
+    return false;
+  }
+  if (expr->IsLiteral() || expr->constant) {
+    return expr->type && expr->type->Int();
+  }
+  if (expr->IsVariable()) {
+    return expr->HasID() && expr->GetID() != loop.induction &&
+           !loop.written.count(expr->GetID()) &&
+           !globals_.count(expr->GetID()) &&
+           !references_.count(expr->GetID());
+  }
+  if (Expr* measured = LengthOperand(expr)) {
+    return measured->type->FixedLength() || IsInvariant(measured, loop);
+  }
+  // Division is excluded: hoisted terms are evaluated even when the loop
+  // runs zero times, so they must not trap.
+  if (auto* binary = dynamic_cast<Binary*>(expr)) {
+    Token::Type op = binary->op.kind;
+    if (op != Token::Type::Plus && op != Token::Type::Minus &&
+        op != Token::Type::STAR) {
+      return false;
+    }
+    return IsInvariant(binary->left.get(), loop) &&
+           IsInvariant(binary->right.get(), loop);
+  }
+  return false;
+}
+
+bool BoundsCheckAnalysis::IsProven(IndexAccess& expr, const LoopFacts& loop) {
+  if (!loop.non_negative || VariableId(expr.index.get()) != loop.induction) {
+    return false;
+  }
+
+  Expr* bound = loop.stmt->range_bound;
+  if (uint64_t length = expr.object->type->FixedLength()) {
+    // Array and vector lengths are part of the type, so reassignment cannot
+    // shrink them.
+    if (Expr* measured = LengthOperand(bound)) {
+      uint64_t other = measured->type->FixedLength();
+      return other && other <= length;
+    }
+    const int64_t* value = ConstantInt(bound);
+    return value && static_cast<uint64_t>(*value) <= length;
+  }
+
+  std::optional<SymbolId> object = VariableId(expr.object.get());
+  Expr* measured = LengthOperand(bound);
+  return object && measured && VariableId(measured) == object &&
+         !loop.written.count(*object) && !references_.count(*object);
+}
+
+bool BoundsCheckAnalysis::TryHoist(IndexAccess& expr) {
+  if (loops_.empty()) {
+    return false;
+  }
+  LoopFacts& loop = loops_.back();
+  // Only accesses that run on every iteration may be checked up front.
+  if (!loop.stmt || loop.has_return || loop.branch_depth > 0) {
+    return false;
+  }
+  bool is_fixed = expr.object->type->FixedLength() != 0;
+  if (!is_fixed && !IsInvariant(expr.object.get(), loop)) {
+    return false;
+  }
+  if (!is_fixed && !VariableId(expr.object.get())) {
+    return false;
+  }
+
+  // The range check is computed in 64 bits without wrapping, which only
+  // matches signed index arithmetic.
+  auto* index_type = dynamic_cast<types::IntType*>(expr.index->type);
+  if (!index_type || !index_type->is_signed) {
+    return false;
+  }
+
+  Expr* index = StripGrouping(expr.index.get());
+  if (VariableId(index) == loop.induction) {
+    loop.stmt->hoisted_checks.push_back(&expr);
+    return true;
+  }
+
+  auto* sum = dynamic_cast<Binary*>(index);
+  if (!sum || sum->op.kind != Token::Type::Plus) {
+    return false;
+  }
+  Expr* offset = nullptr;
+  if (VariableId(sum->right.get()) == loop.induction) {
+    offset = sum->left.get();
+  } else if (VariableId(sum->left.get()) == loop.induction) {
+    offset = sum->right.get();
+  }
+  if (!offset || !IsInvariant(offset, loop)) {
+    return false;
+  }
+  expr.loop_offset = offset;
+  loop.stmt->hoisted_checks.push_back(&expr);
+  return true;
+}
@@ -0,0 +1,952 @@
+#include "cinder/semantic/const_evaluator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "cinder/frontend/tokens.hpp"
+#include "llvm/Support/MathExtras.h"
+
+using namespace cinder;
+
+namespace {
+
+/** Interpreter steps one top-level fold may spend, across nested calls. */
+constexpr size_t kStepBudget = 1 << 20;
+/** Deepest chain of interpreted calls, so runaway recursion gives up. */
+constexpr size_t kMaxCallDepth = 64;
+
+bool IsScalar(types::Type* type) {
+  return type && (type->Int() || type->Float() || type->Bool());
+}
+
+/** @brief Truncates `bits` to `type`'s width and extends it back to 64. */
+int64_t WrapInt(uint64_t bits, const types::IntType& type) {
+  if (type.bits >= 64) {
+    return static_cast<int64_t>(bits);
+  }
+  uint64_t mask = (uint64_t{1} << type.bits) - 1;
+  bits &= mask;
+  if (type.is_signed && (bits >> (type.bits - 1)) != 0) {
+    bits |= ~mask;
+  }
+  return static_cast<int64_t>(bits);
+}
+
+/** @brief Returns whether `a` orders before `b` as values of `type`. */
+bool IntLess(int64_t a, int64_t b, const types::IntType& type) {
+  return type.is_signed ? a < b
+                        : static_cast<uint64_t>(a) < static_cast<uint64_t>(b);
+}
+
+/** @brief Rounds `value` to the precision of the floating-point `type`. */
+double RoundFloat(double value, const types::FloatType& type) {
+  return type.bits == 32 ? static_cast<double>(static_cast<float>(value))
+                         : value;
+}
+
+/**
+ * @brief Converts `value` from `from` to `to` the way `EmitConversion` does.
+ * @return The converted value, or `std::nullopt` where codegen would produce
+ * poison.
+ */
+std::optional<ConstValue> Convert(const ConstValue& value, types::Type* from,
+                                  types::Type* to) {
+  auto* to_int = dynamic_cast<types::IntType*>(to);
+  auto* to_flt = dynamic_cast<types::FloatType*>(to);
+  if (const bool* flag = std::get_if<bool>(&value)) {
+    if (to->Bool()) {
+      return *flag;
+    }
+    if (to_int) {
+      return int64_t{*flag};
+    }
+    return *flag ? 1.0 : 0.0;
+  }
+  if (const int64_t* raw = std::get_if<int64_t>(&value)) {
+    auto* from_int = dynamic_cast<types::IntType*>(from);
+    bool is_signed = from_int && from_int->is_signed;
+    if (to_int) {
+      return WrapInt(static_cast<uint64_t>(*raw), *to_int);
+    }
+    if (!to_flt) {
+      return std::nullopt;
+    }
+    // Convert straight to the target precision; going through `double`
+    // first could round twice.
+    if (to_flt->bits == 32) {
+      return static_cast<double>(
+          is_signed ? static_cast<float>(*raw)
+                    : static_cast<float>(static_cast<uint64_t>(*raw)));
+    }
+    return is_signed ? static_cast<double>(*raw)
+                     : static_cast<double>(static_cast<uint64_t>(*raw));
+  }
+  double real = std::get<double>(value);
+  if (to_flt) {
+    return RoundFloat(real, *to_flt);
+  }
+  if (!to_int) {
+    return std::nullopt;
+  }
+  // fptosi and fptoui are poison when the truncated value does not fit.
+  double whole = std::trunc(real);
+  double low = to_int->is_signed ? -std::ldexp(1.0, to_int->bits - 1) : 0.0;
+  double high =
+      std::ldexp(1.0, to_int->is_signed ? to_int->bits - 1 : to_int->bits);
+  if (!(whole >= low && whole < high)) {
+    return std::nullopt;
+  }
+  if (to_int->is_signed) {
+    return static_cast<int64_t>(whole);
+  }
+  return WrapInt(static_cast<uint64_t>(whole), *to_int);
+}
+
+template <typename T>
+std::optional<T> FloatArithmetic(Token::Type op, T lhs, T rhs) {
+  switch (op) {
+    case Token::Type::Plus:
+      return lhs + rhs;
+    case Token::Type::Minus:
+      return lhs - rhs;
+    case Token::Type::STAR:
+      return lhs * rhs;
+    case Token::Type::SLASH:
+      return lhs / rhs;
+    case Token::Type::MODULO:
+      return std::fmod(lhs, rhs);
+    default:
+      return std::nullopt;
+  }
+}
+
+/**
+ * @brief Returns the shift amount `CreateIntBinop` uses: only the low bits
+ * that index into `type`'s width.
+ */
+unsigned ShiftAmount(int64_t amount, const types::IntType& type) {
+  return static_cast<unsigned>(static_cast<uint64_t>(amount) &
+                               (type.bits - 1));
+}
+
+/** @brief Applies a binary operator to two values of the scalar `type`. */
+std::optional<ConstValue> Arithmetic(Token::Type op, const ConstValue& lhs,
+                                     const ConstValue& rhs,
+                                     types::Type* type) {
+  if (auto* flt = dynamic_cast<types::FloatType*>(type)) {
+    double a = std::get<double>(lhs);
+    double b = std::get<double>(rhs);
+    if (flt->bits == 32) {
+      auto result = FloatArithmetic<float>(op, static_cast<float>(a),
+                                           static_cast<float>(b));
+      if (result) {
+        return static_cast<double>(*result);
+      }
+      return std::nullopt;
+    }
+    if (auto result = FloatArithmetic<double>(op, a, b)) {
+      return *result;
+    }
+    return std::nullopt;
+  }
+
+  auto* int_type = dynamic_cast<types::IntType*>(type);
+  if (!int_type) {
+    return std::nullopt;
+  }
+  int64_t a = std::get<int64_t>(lhs);
+  int64_t b = std::get<int64_t>(rhs);
+  if (!int_type->is_signed) {
+    // Unsigned values are zero-extended, so 64-bit arithmetic wraps the
+    // same way once truncated.
+    uint64_t x = static_cast<uint64_t>(a);
+    uint64_t y = static_cast<uint64_t>(b);
+    switch (op) {
+      case Token::Type::Plus:
+        return WrapInt(x + y, *int_type);
+      case Token::Type::Minus:
+        return WrapInt(x - y, *int_type);
+      case Token::Type::STAR:
+        return WrapInt(x * y, *int_type);
+      case Token::Type::SLASH:
+        if (y == 0) {
+          return std::nullopt;
+        }
+        return WrapInt(x / y, *int_type);
+      case Token::Type::MODULO:
+        if (y == 0) {
+          return std::nullopt;
+        }
+        return WrapInt(x % y, *int_type);
+      case Token::Type::AMP:
+        return WrapInt(x & y, *int_type);
+      case Token::Type::PIPE:
+        return WrapInt(x | y, *int_type);
+      case Token::Type::CARET:
+        return WrapInt(x ^ y, *int_type);
+      case Token::Type::LESSER_LESSER:
+        return WrapInt(x << ShiftAmount(b, *int_type), *int_type);
+      case Token::Type::GREATER_GREATER:
+        return WrapInt(x >> ShiftAmount(b, *int_type), *int_type);
+      default:
+        return std::nullopt;
+    }
+  }
+
+  // Bit operations cannot overflow; `<<` wraps like unsigned arithmetic.
+  switch (op) {
+    case Token::Type::AMP:
+      return a & b;
+    case Token::Type::PIPE:
+      return a | b;
+    case Token::Type::CARET:
+      return a ^ b;
+    case Token::Type::LESSER_LESSER:
+      return WrapInt(static_cast<uint64_t>(a) << ShiftAmount(b, *int_type),
+                     *int_type);
+    case Token::Type::GREATER_GREATER:
+      return a >> ShiftAmount(b, *int_type);
+    default:
+      break;
+  }
+
+  // Signed arithmetic is `nsw`, so an overflowing result stays unfolded.
+  int64_t result = 0;
+  bool overflow = false;
+  switch (op) {
+    case Token::Type::Plus:
+      overflow = llvm::AddOverflow(a, b, result);
+      break;
+    case Token::Type::Minus:
+      overflow = llvm::SubOverflow(a, b, result);
+      break;
+    case Token::Type::STAR:
+      overflow = llvm::MulOverflow(a, b, result);
+      break;
+    case Token::Type::SLASH:
+      if (b == 0 || (a == INT64_MIN && b == -1)) {
+        return std::nullopt;
+      }
+      result = a / b;
+      break;
+    case Token::Type::MODULO: {
+      // `srem` of the minimum by -1 overflows the quotient and is undefined.
+      int64_t min = WrapInt(uint64_t{1} << (int_type->bits - 1), *int_type);
+      if (b == 0 || (b == -1 && a == min)) {
+        return std::nullopt;
+      }
+      result = a % b;
+      break;
+    }
+    default:
+      return std::nullopt;
+  }
+  if (overflow || WrapInt(static_cast<uint64_t>(result), *int_type) != result) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+template <typename T>
+std::optional<bool> CompareAs(Token::Type op, T lhs, T rhs) {
+  switch (op) {
+    case Token::Type::EQEQ:
+      return lhs == rhs;
+    case Token::Type::BANGEQ:
+      // Ordered, like `fcmp one`: NaN is neither equal nor unequal.
+      return lhs < rhs || lhs > rhs;
+    case Token::Type::LESSER:
+      return lhs < rhs;
+    case Token::Type::LESSER_EQ:
+      return lhs <= rhs;
+    case Token::Type::GREATER:
+      return lhs > rhs;
+    case Token::Type::GREATER_EQ:
+      return lhs >= rhs;
+    default:
+      return std::nullopt;
+  }
+}
+
+/** @brief Compares two values already converted to `operand`. */
+std::optional<bool> Compare(Token::Type op, const ConstValue& lhs,
+                            const ConstValue& rhs, types::Type* operand) {
+  if (operand->Float()) {
+    return CompareAs(op, std::get<double>(lhs), std::get<double>(rhs));
+  }
+  if (operand->Bool()) {
+    return CompareAs(op, std::get<bool>(lhs), std::get<bool>(rhs));
+  }
+  auto* int_type = dynamic_cast<types::IntType*>(operand);
+  int64_t a = std::get<int64_t>(lhs);
+  int64_t b = std::get<int64_t>(rhs);
+  if (int_type && !int_type->is_signed) {
+    return CompareAs(op, static_cast<uint64_t>(a), static_cast<uint64_t>(b));
+  }
+  return CompareAs(op, a, b);
+}
+
+/**
+ * @brief Returns whether `init` can be emitted as static data of `type`.
+ *
+ * Accepts folded scalars, string literals, array literals of such
+ * elements, and struct constructors whose arguments are all such
+ * initializers.
+ */
+bool IsStaticInitializer(Expr& init, types::Type* type) {
+  if (init.constant) {
+    return IsScalar(type) && Convert(*init.constant, init.type, type);
+  }
+  if (init.IsLiteral() && init.type && init.type->String()) {
+    return type->String();
+  }
+  if (auto* group = dynamic_cast<Grouping*>(&init)) {
+    return IsStaticInitializer(*group->expr, type);
+  }
+  if (auto* literal = dynamic_cast<ArrayLiteral*>(&init)) {
+    types::Type* element = nullptr;
+    if (auto* array = dynamic_cast<types::ArrayType*>(type)) {
+      element = array->element;
+    } else if (auto* vector = dynamic_cast<types::VectorType*>(type)) {
+      element = vector->element;
+    }
+    return element && std::all_of(literal->elements.begin(),
+                                  literal->elements.end(), [&](auto& e) {
+                                    return IsStaticInitializer(*e, element);
+                                  });
+  }
+  auto* call = dynamic_cast<CallExpr*>(&init);
+  auto* record = dynamic_cast<types::StructType*>(type);
+  if (!call || !record || call->args.size() != record->fields.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < call->args.size(); ++i) {
+    if (!IsStaticInitializer(*call->args[i], record->fields[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+ConstEvaluator::ConstEvaluator(DiagnosticEngine& diagnose)
+    : diagnose_(diagnose) {}
+
+void ConstEvaluator::Run(const std::vector<ModuleStmt*>& modules) {
+  // Calls may precede their callee's definition, so index every body first.
+  for (ModuleStmt* mod : modules) {
+    for (auto& stmt : mod->stmts) {
+      auto* fn = dynamic_cast<FunctionStmt*>(stmt.get());
+      if (!fn) {
+        continue;
+      }
+      auto* proto = dynamic_cast<FunctionProto*>(fn->proto.get());
+      if (proto && proto->HasID()) {
+        functions_[proto->GetID()] = fn;
+      }
+    }
+  }
+  // Globals fold first so function bodies see their values.
+  for (ModuleStmt* mod : modules) {
+    for (auto& stmt : mod->stmts) {
+      if (stmt->IsVarDeclaration()) {
+        Fold(stmt.get());
+      }
+    }
+  }
+  for (ModuleStmt* mod : modules) {
+    for (auto& stmt : mod->stmts) {
+      if (!stmt->IsVarDeclaration()) {
+        Fold(stmt.get());
+      }
+    }
+  }
+}
+
+void ConstEvaluator::Fold(Stmt* stmt) {
+  if (stmt) {
+    stmt->Accept(*this);
+  }
+}
+
+void ConstEvaluator::Fold(Expr* expr) {
+  if (expr) {
+    expr->Accept(*this);
+  }
+}
+
+void ConstEvaluator::Record(Expr& expr) {
+  // Operands are already folded, so only calls spend more than a few steps.
+  steps_ = kStepBudget;
+  expr.constant = Evaluate(expr, nullptr);
+}
+
+void ConstEvaluator::Visit(ModuleStmt& stmt) {
+  for (auto& s : stmt.stmts) {
+    Fold(s.get());
+  }
+}
+
+void ConstEvaluator::Visit(ImportStmt& stmt) {}
+
+void ConstEvaluator::Visit(StructStmt& stmt) {}
+
+void ConstEvaluator::Visit(FunctionProto& stmt) {}
+
+void ConstEvaluator::Visit(FunctionStmt& stmt) {
+  for (auto& s : stmt.body) {
+    Fold(s.get());
+  }
+}
+
+void ConstEvaluator::Visit(ForStmt& stmt) {
+  Fold(stmt.initializer.get());
+  Fold(stmt.condition.get());
+  Fold(stmt.step.get());
+  for (auto& s : stmt.body) {
+    Fold(s.get());
+  }
+}
+
+void ConstEvaluator::Visit(WhileStmt& stmt) {
+  Fold(stmt.condition.get());
+  for (auto& s : stmt.body) {
+    Fold(s.get());
+  }
+}
+
+void ConstEvaluator::Visit(IfStmt& stmt) {
+  Fold(stmt.cond.get());
+  Fold(stmt.then.get());
+  Fold(stmt.otherwise.get());
+}
+
+void ConstEvaluator::Visit(MatchStmt& stmt) {
+  Fold(stmt.subject.get());
+  auto* subject = dynamic_cast<types::IntType*>(stmt.subject->type);
+
+  // Case values become `switch` labels, so each must fold, and no value may
+  // take two arms.
+  std::vector<const MatchPattern*> patterns;
+  for (MatchArm& arm : stmt.arms) {
+    for (MatchPattern& pattern : arm.patterns) {
+      bool is_constant = true;
+      int64_t* values[] = {&pattern.low_value, &pattern.high_value};
+      Expr* bounds[] = {pattern.low.get(),
+                        pattern.high ? pattern.high.get() : pattern.low.get()};
+      for (size_t i = 0; i < 2; ++i) {
+        Fold(bounds[i]);
+        std::optional<ConstValue> value;
+        if (subject && bounds[i]->constant) {
+          value = Convert(*bounds[i]->constant, bounds[i]->type, subject);
+        }
+        if (!value || !std::holds_alternative<int64_t>(*value)) {
+          is_constant = false;
+          continue;
+        }
+        *values[i] = std::get<int64_t>(*value);
+      }
+      if (!is_constant) {
+        diagnose_.Error({arm.case_token.location.line},
+                        "Match case is not a compile-time constant");
+        continue;
+      }
+      if (IntLess(pattern.high_value, pattern.low_value, *subject)) {
+        diagnose_.Error({arm.case_token.location.line},
+                        "Match case range is empty");
+        continue;
+      }
+      patterns.push_back(&pattern);
+    }
+    for (auto& s : arm.body) {
+      Fold(s.get());
+    }
+  }
+  for (auto& s : stmt.otherwise) {
+    Fold(s.get());
+  }
+
+  std::sort(patterns.begin(), patterns.end(),
+            [&](const MatchPattern* a, const MatchPattern* b) {
+              return IntLess(a->low_value, b->low_value, *subject);
+            });
+  for (size_t i = 1; i < patterns.size(); ++i) {
+    if (!IntLess(patterns[i - 1]->high_value, patterns[i]->low_value,
+                 *subject)) {
+      diagnose_.Error({stmt.match_token.location.line},
+                      "Duplicate match case");
+      break;
+    }
+  }
+}
+
+void ConstEvaluator::Visit(ExpressionStmt& stmt) {
+  Fold(stmt.expr.get());
+}
+
+void ConstEvaluator::Visit(ReturnStmt& stmt) {
+  Fold(stmt.value.get());
+}
+
+void ConstEvaluator::Visit(VarDeclarationStmt& stmt) {
+  Fold(stmt.value.get());
+  if (!stmt.HasID()) {
+    return;
+  }
+  // Globals are static data, so they need a value before the program runs.
+  if (stmt.is_global && !IsStaticInitializer(*stmt.value, stmt.resolved_type)) {
+    diagnose_.Error({stmt.name.location.line},
+                    "Global initializer is not a compile-time constant: " +
+                        stmt.name.lexeme);
+    return;
+  }
+  if (!stmt.is_const || !IsScalar(stmt.resolved_type)) {
+    return;
+  }
+  std::optional<ConstValue> value;
+  if (stmt.value->constant) {
+    value = Convert(*stmt.value->constant, stmt.value->type,
+                    stmt.resolved_type);
+  }
+  if (!value) {
+    diagnose_.Error({stmt.name.location.line},
+                    "Constant initializer is not a compile-time constant: " +
+                        stmt.name.lexeme);
+    return;
+  }
+  consts_[stmt.GetID()] = *value;
+}
+
+void ConstEvaluator::Visit(Variable& expr) {
+  Record(expr);
+}
+
+void ConstEvaluator::Visit(MemberAccess& expr) {
+  Fold(expr.object.get());
+  // Only a qualified name (`mod.NAME`) carries a symbol id.
+  if (expr.HasID()) {
+    Record(expr);
+  }
+}
+
+void ConstEvaluator::Visit(Binary& expr) {
+  Fold(expr.left.get());
+  Fold(expr.right.get());
+  if (expr.left->constant && expr.right->constant) {
+    Record(expr);
+  }
+}
+
+void ConstEvaluator::Visit(Assign& expr) {
+  Fold(expr.value.get());
+}
+
+void ConstEvaluator::Visit(MemberAssign& expr) {
+  Fold(expr.target.get());
+  Fold(expr.value.get());
+}
+
+void ConstEvaluator::Visit(Grouping& expr) {
+  Fold(expr.expr.get());
+  if (expr.expr->constant) {
+    Record(expr);
+  }
+}
+
+void ConstEvaluator::Visit(Conditional& expr) {
+  Fold(expr.left.get());
+  Fold(expr.right.get());
+  if (expr.left->constant && expr.right->constant) {
+    Record(expr);
+  }
+}
+
+void ConstEvaluator::Visit(Logical& expr) {
+  Fold(expr.left.get());
+  Fold(expr.right.get());
+  // A constant left side may decide the result without the right.
+  if (expr.left->constant) {
+    Record(expr);
+  }
+}
+
+void ConstEvaluator::Visit(Unary& expr) {
+  Fold(expr.operand.get());
+  if (expr.operand->constant) {
+    Record(expr);
+  }
+}
+
+void ConstEvaluator::Visit(IfExpr& expr) {
+  Fold(expr.cond.get());
+  Fold(expr.then.get());
+  Fold(expr.otherwise.get());
+  if (expr.cond->constant) {
+    Record(expr);
+  }
+}
+
+void ConstEvaluator::Visit(PreFixOp& expr) {}
+
+void ConstEvaluator::Visit(CallExpr& expr) {
+  for (auto& arg : expr.args) {
+    Fold(arg.get());
+  }
+  if (std::all_of(expr.args.begin(), expr.args.end(),
+                  [](auto& arg) { return arg->constant.has_value(); })) {
+    Record(expr);
+  }
+}
+
+void ConstEvaluator::Visit(Literal& expr) {
+  Record(expr);
+}
+
+void ConstEvaluator::Visit(IndexAccess& expr) {
+  Fold(expr.object.get());
+  Fold(expr.index.get());
+}
+
+void ConstEvaluator::Visit(IndexAssign& expr) {
+  Fold(expr.target.get());
+  Fold(expr.value.get());
+}
+
+void ConstEvaluator::Visit(ArrayLiteral& expr) {
+  for (auto& element : expr.elements) {
+    Fold(element.get());
+  }
+}
+
+void ConstEvaluator::Visit(NewArray& expr) {
+  Fold(expr.length.get());
+}
+
+void ConstEvaluator::Visit(Cast& expr) {
+  Fold(expr.value.get());
+  if (expr.value->constant) {
+    Record(expr);
+  }
+}
+
+void ConstEvaluator::Visit(SliceExpr& expr) {
+  Fold(expr.object.get());
+  Fold(expr.start.get());
+  Fold(expr.end.get());
+}
+
+void ConstEvaluator::Visit(IntrinsicCall& expr) {
+  for (auto& arg : expr.args) {
+    Fold(arg.get());
+  }
+}
+
+std::optional<ConstValue> ConstEvaluator::Evaluate(Expr& expr, Frame* frame) {
+  // Folded operands still cost a step, so a loop over them terminates.
+  if (steps_ == 0) {
+    return std::nullopt;
+  }
+  --steps_;
+  if (expr.constant) {
+    return expr.constant;
+  }
+  if (!IsScalar(expr.type)) {
+    return std::nullopt;
+  }
+
+  switch (expr.expr_type) {
+    case Expr::ExprType::Literal: {
+      auto& literal = static_cast<Literal&>(expr);
+      if (const bool* flag = std::get_if<bool>(&literal.value)) {
+        return *flag;
+      }
+      if (const double* real = std::get_if<double>(&literal.value)) {
+        return Convert(*real, expr.type, expr.type);
+      }
+      if (const int64_t* raw = std::get_if<int64_t>(&literal.value)) {
+        return Convert(*raw, expr.type, expr.type);
+      }
+      return std::nullopt;
+    }
+    case Expr::ExprType::Variable:
+    case Expr::ExprType::MemberAccess: {
+      if (!expr.HasID()) {
+        return std::nullopt;
+      }
+      if (auto it = consts_.find(expr.GetID()); it != consts_.end()) {
+        return it->second;
+      }
+      if (frame) {
+        if (auto it = frame->find(expr.GetID()); it != frame->end()) {
+          return it->second;
+        }
+      }
+      return std::nullopt;
+    }
+    case Expr::ExprType::Grouping:
+      return Evaluate(*static_cast<Grouping&>(expr).expr, frame);
+    case Expr::ExprType::Binary: {
+      auto& binary = static_cast<Binary&>(expr);
+      auto lhs = EvaluateAs(*binary.left, expr.type, frame);
+      if (!lhs) {
+        return std::nullopt;
+      }
+      auto rhs = EvaluateAs(*binary.right, expr.type, frame);
+      if (!rhs) {
+        return std::nullopt;
+      }
+      return Arithmetic(binary.op.kind, *lhs, *rhs, expr.type);
+    }
+    case Expr::ExprType::Conditional: {
+      auto& cond = static_cast<Conditional&>(expr);
+      if (!IsScalar(cond.operand_type)) {
+        return std::nullopt;
+      }
+      auto lhs = EvaluateAs(*cond.left, cond.operand_type, frame);
+      if (!lhs) {
+        return std::nullopt;
+      }
+      auto rhs = EvaluateAs(*cond.right, cond.operand_type, frame);
+      if (!rhs) {
+        return std::nullopt;
+      }
+      if (auto result = Compare(cond.op.kind, *lhs, *rhs, cond.operand_type)) {
+        return *result;
+      }
+      return std::nullopt;
+    }
+    case Expr::ExprType::Logical: {
+      auto& logical = static_cast<Logical&>(expr);
+      auto lhs = Evaluate(*logical.left, frame);
+      if (!lhs || !std::holds_alternative<bool>(*lhs)) {
+        return std::nullopt;
+      }
+      bool is_and = logical.op.kind == Token::Type::AMPAMP;
+      if (std::get<bool>(*lhs) != is_and) {
+        return *lhs;
+      }
+      return Evaluate(*logical.right, frame);
+    }
+    case Expr::ExprType::Unary: {
+      auto operand = Evaluate(*static_cast<Unary&>(expr).operand, frame);
+      if (!operand) {
+        return std::nullopt;
+      }
+      if (const bool* flag = std::get_if<bool>(&*operand)) {
+        return !*flag;
+      }
+      auto* int_type = dynamic_cast<types::IntType*>(expr.type);
+      const int64_t* raw = std::get_if<int64_t>(&*operand);
+      if (!int_type || !raw) {
+        return std::nullopt;
+      }
+      return WrapInt(~static_cast<uint64_t>(*raw), *int_type);
+    }
+    case Expr::ExprType::IfExpr: {
+      auto& if_expr = static_cast<IfExpr&>(expr);
+      auto cond = Evaluate(*if_expr.cond, frame);
+      if (!cond || !std::holds_alternative<bool>(*cond)) {
+        return std::nullopt;
+      }
+      Expr& chosen = std::get<bool>(*cond) ? *if_expr.then : *if_expr.otherwise;
+      return EvaluateAs(chosen, expr.type, frame);
+    }
+    case Expr::ExprType::Cast:
+      return EvaluateAs(*static_cast<Cast&>(expr).value, expr.type, frame);
+    case Expr::ExprType::Call:
+      return Call(static_cast<CallExpr&>(expr), frame);
+    case Expr::ExprType::Assign: {
+      auto& assign = static_cast<Assign&>(expr);
+      if (!frame || !assign.HasID() || !frame->contains(assign.GetID())) {
+        return std::nullopt;
+      }
+      auto value = EvaluateAs(*assign.value, expr.type, frame);
+      if (value) {
+        (*frame)[assign.GetID()] = *value;
+      }
+      return value;
+    }
+    case Expr::ExprType::PreFix: {
+      auto& prefix = static_cast<PreFixOp&>(expr);
+      if (!frame || !prefix.HasID()) {
+        return std::nullopt;
+      }
+      auto it = frame->find(prefix.GetID());
+      if (it == frame->end()) {
+        return std::nullopt;
+      }
+      ConstValue one =
+          expr.type->Float() ? ConstValue(1.0) : ConstValue(int64_t{1});
+      Token::Type op = prefix.op.kind == Token::Type::PlusPlus
+                           ? Token::Type::Plus
+                           : Token::Type::Minus;
+      auto value = Arithmetic(op, it->second, one, expr.type);
+      if (value) {
+        it->second = *value;
+      }
+      return value;
+    }
+    default:
+      return std::nullopt;
+  }
+}
+
+std::optional<ConstValue> ConstEvaluator::EvaluateAs(Expr& expr,
+                                                     types::Type* type,
+                                                     Frame* frame) {
+  if (!IsScalar(type)) {
+    return std::nullopt;
+  }
+  auto value = Evaluate(expr, frame);
+  if (!value) {
+    return std::nullopt;
+  }
+  return Convert(*value, expr.type, type);
+}
+
+std::optional<ConstValue> ConstEvaluator::Call(CallExpr& expr, Frame* frame) {
+  auto* callee = dynamic_cast<Variable*>(expr.callee.get());
+  if (!callee || !callee->HasID() || depth_ >= kMaxCallDepth) {
+    return std::nullopt;
+  }
+  auto fn = functions_.find(callee->GetID());
+  if (fn == functions_.end()) {
+    return std::nullopt;
+  }
+  auto* proto = dynamic_cast<FunctionProto*>(fn->second->proto.get());
+  if (!proto || proto->is_variadic || proto->args.size() != expr.args.size()) {
+    return std::nullopt;
+  }
+
+  Frame locals;
+  for (size_t i = 0; i < expr.args.size(); ++i) {
+    // A reference may write its caller's storage, which frames do not model.
+    const FuncArg& param = proto->args[i];
+    if (!param.id || !param.resolved_type || param.resolved_type->Reference()) {
+      return std::nullopt;
+    }
+    auto value = EvaluateAs(*expr.args[i], param.resolved_type, frame);
+    if (!value) {
+      return std::nullopt;
+    }
+    locals[*param.id] = *value;
+  }
+
+  ++depth_;
+  std::optional<ConstValue> result;
+  Flow flow = ExecuteBlock(fn->second->body, locals, result);
+  --depth_;
+  if (flow != Flow::Return) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+ConstEvaluator::Flow ConstEvaluator::ExecuteBlock(
+    std::vector<std::unique_ptr<Stmt>>& body, Frame& frame,
+    std::optional<ConstValue>& result) {
+  for (auto& stmt : body) {
+    Flow flow = Execute(*stmt, frame, result);
+    if (flow != Flow::Next) {
+      return flow;
+    }
+  }
+  return Flow::Next;
+}
+
+ConstEvaluator::Flow ConstEvaluator::Execute(
+    Stmt& stmt, Frame& frame, std::optional<ConstValue>& result) {
+  if (auto* decl = dynamic_cast<VarDeclarationStmt*>(&stmt)) {
+    if (!decl->HasID() || !decl->resolved_type ||
+        decl->resolved_type->Reference()) {
+      return Flow::Abort;
+    }
+    auto value = EvaluateAs(*decl->value, decl->resolved_type, &frame);
+    if (!value) {
+      return Flow::Abort;
+    }
+    frame[decl->GetID()] = *value;
+    return Flow::Next;
+  }
+  if (auto* expr_stmt = dynamic_cast<ExpressionStmt*>(&stmt)) {
+    return Evaluate(*expr_stmt->expr, &frame) ? Flow::Next : Flow::Abort;
+  }
+  if (auto* ret = dynamic_cast<ReturnStmt*>(&stmt)) {
+    if (!ret->value) {
+      return Flow::Abort;
+    }
+    result = EvaluateAs(*ret->value, ret->resolved_type, &frame);
+    return result ? Flow::Return : Flow::Abort;
+  }
+  if (auto* branch = dynamic_cast<IfStmt*>(&stmt)) {
+    auto cond = Evaluate(*branch->cond, &frame);
+    if (!cond || !std::holds_alternative<bool>(*cond)) {
+      return Flow::Abort;
+    }
+    Stmt* taken = std::get<bool>(*cond) ? branch->then.get()
+                                        : branch->otherwise.get();
+    return taken ? Execute(*taken, frame, result) : Flow::Next;
+  }
+  if (auto* match = dynamic_cast<MatchStmt*>(&stmt)) {
+    auto* type = dynamic_cast<types::IntType*>(match->subject->type);
+    auto subject = Evaluate(*match->subject, &frame);
+    if (!type || !subject || !std::holds_alternative<int64_t>(*subject)) {
+      return Flow::Abort;
+    }
+    int64_t value = std::get<int64_t>(*subject);
+    for (MatchArm& arm : match->arms) {
+      for (const MatchPattern& pattern : arm.patterns) {
+        // A caller can run before `Visit(MatchStmt)` stores the folded
+        // bounds, so evaluate them here rather than read `low_value`.
+        auto low = EvaluateAs(*pattern.low, type, &frame);
+        auto high =
+            pattern.high ? EvaluateAs(*pattern.high, type, &frame) : low;
+        if (!low || !high || !std::holds_alternative<int64_t>(*low) ||
+            !std::holds_alternative<int64_t>(*high)) {
+          return Flow::Abort;
+        }
+        if (!IntLess(value, std::get<int64_t>(*low), *type) &&
+            !IntLess(std::get<int64_t>(*high), value, *type)) {
+          return ExecuteBlock(arm.body, frame, result);
+        }
+      }
+    }
+    return ExecuteBlock(match->otherwise, frame, result);
+  }
+  if (auto* loop = dynamic_cast<WhileStmt*>(&stmt)) {
+    while (true) {
+      auto cond = Evaluate(*loop->condition, &frame);
+      if (!cond || !std::holds_alternative<bool>(*cond)) {
+        return Flow::Abort;
+      }
+      if (!std::get<bool>(*cond)) {
+        return Flow::Next;
+      }
+      Flow flow = ExecuteBlock(loop->body, frame, result);
+      if (flow != Flow::Next) {
+        return flow;
+      }
+    }
+  }
+  if (auto* loop = dynamic_cast<ForStmt*>(&stmt)) {
+    Flow flow = Execute(*loop->initializer, frame, result);
+    while (flow == Flow::Next) {
+      auto cond = Evaluate(*loop->condition, &frame);
+      if (!cond || !std::holds_alternative<bool>(*cond)) {
+        return Flow::Abort;
+      }
+      if (!std::get<bool>(*cond)) {
+        return Flow::Next;
+      }
+      flow = ExecuteBlock(loop->body, frame, result);
+      if (flow == Flow::Next && loop->step &&
+          !Evaluate(*loop->step, &frame)) {
+        return Flow::Abort;
+      }
+    }
+    return flow;
+  }
+  return Flow::Abort;
+}
@@ -1,12 +1,178 @@
 #include "cinder/semantic/semantic_analyzer.hpp"
 
+#include <algorithm>
+#include <charconv>
 #include <unordered_set>
 
 #include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/semantic/const_evaluator.hpp"
+#include "cinder/support/phase_timer.hpp"
 #include "cinder/support/utils.hpp"
 
 using namespace cinder;
 
+/** @brief Returns whether a type spelling starts with `ref` or `ptr`. */
+static bool HasReferencePrefix(const std::string& lexeme) {
+  return lexeme.rfind("ref ", 0) == 0 || lexeme.rfind("ptr ", 0) == 0;
+}
+
+/**
+ * @brief Returns whether the literal payload `raw` is representable in `type`.
+ *
+ * Negative payloads are literals above `INT64_MAX` stored wrapped, which only
+ * `uint64` holds.
+ */
+static bool IntLiteralFits(int64_t raw, const types::IntType& type) {
+  if (raw < 0) {
+    return !type.is_signed && type.bits == 64;
+  }
+  if (type.bits >= 64) {
+    return true;
+  }
+  unsigned magnitude = type.is_signed ? type.bits - 1 : type.bits;
+  return static_cast<uint64_t>(raw) < (uint64_t{1} << magnitude);
+}
+
+/**
+ * @brief Returns whether every `from` value is representable in `to`.
+ *
+ * Integers widen within their signedness, and unsigned integers widen into
+ * strictly wider signed ones. `flt32` widens into `flt64`.
+ */
+static bool IsWidening(types::Type* from, types::Type* to) {
+  auto* source_flt = dynamic_cast<types::FloatType*>(from);
+  auto* target_flt = dynamic_cast<types::FloatType*>(to);
+  if (source_flt && target_flt) {
+    return target_flt->bits > source_flt->bits;
+  }
+  auto* source = dynamic_cast<types::IntType*>(from);
+  auto* target = dynamic_cast<types::IntType*>(to);
+  if (!source || !target || target->bits <= source->bits) {
+    return false;
+  }
+  return source->is_signed == target->is_signed || target->is_signed;
+}
+
+/** @brief Returns whether values of `type` may point at other storage. */
+static bool HoldsPointer(types::Type* type) {
+  if (type->String() || type->Slice() || type->Reference()) {
+    return true;
+  }
+  if (auto* array = dynamic_cast<types::ArrayType*>(type)) {
+    return HoldsPointer(array->element);
+  }
+  if (auto* strct = dynamic_cast<types::StructType*>(type)) {
+    return std::any_of(strct->fields.begin(), strct->fields.end(),
+                       HoldsPointer);
+  }
+  return false;
+}
+
+/**
+ * Scalar fields a struct may carry into a `return tail` call. Two scalars
+ * fit the 16 bytes codegen passes in registers on every target, so no
+ * argument within the budget is copied `byval`.
+ */
+constexpr size_t kTailCallFieldBudget = 2;
+
+/**
+ * @brief Counts the scalars `type` holds: `str` and slices are a pointer and
+ * a length, arrays and vectors one per element.
+ */
+static size_t ScalarCount(types::Type* type) {
+  if (type->String() || type->Slice()) {
+    return 2;
+  }
+  if (auto* array = dynamic_cast<types::ArrayType*>(type)) {
+    return array->length * ScalarCount(array->element);
+  }
+  if (auto* vector = dynamic_cast<types::VectorType*>(type)) {
+    return vector->lanes;
+  }
+  if (auto* strct = dynamic_cast<types::StructType*>(type)) {
+    size_t count = 0;
+    for (types::Type* field : strct->fields) {
+      count += ScalarCount(field);
+    }
+    return count;
+  }
+  return 1;
+}
+
+/** @brief Returns whether two functions take and return the same types. */
+static bool SameSignature(types::FunctionType* a, types::FunctionType* b) {
+  auto same = [](types::Type* x, types::Type* y) {
+    return x && x->IsThisType(y);
+  };
+  if (!a || !b || a->params.size() != b->params.size() ||
+      !same(a->return_type, b->return_type)) {
+    return false;
+  }
+  for (size_t i = 0; i < a->params.size(); ++i) {
+    if (!same(a->params[i], b->params[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** @brief Returns whether `type` supports `+ - * /`, lane-wise for vectors. */
+static bool IsArithmetic(types::Type* type) {
+  if (auto* vector = dynamic_cast<types::VectorType*>(type)) {
+    type = vector->element;
+  }
+  return type->Int() || type->Float();
+}
+
+/** @brief Returns whether `type` supports `& | ^ ~ << >>`, lane-wise too. */
+static bool IsBitwise(types::Type* type) {
+  if (auto* vector = dynamic_cast<types::VectorType*>(type)) {
+    type = vector->element;
+  }
+  return type->Int();
+}
+
+/**
+ * @brief Returns whether `expr` is built only from unsuffixed floating-point
+ * literals and arithmetic on them.
+ */
+static bool IsFloatConstant(Expr& expr) {
+  if (auto* literal = dynamic_cast<Literal*>(&expr)) {
+    return !literal->suffix && std::holds_alternative<double>(literal->value);
+  }
+  if (auto* grouping = dynamic_cast<Grouping*>(&expr)) {
+    return IsFloatConstant(*grouping->expr);
+  }
+  if (auto* binary = dynamic_cast<Binary*>(&expr)) {
+    return binary->type && binary->type->Float() &&
+           IsFloatConstant(*binary->left) && IsFloatConstant(*binary->right);
+  }
+  return false;
+}
+
+/** @brief Returns whether `expr` is a literal whose type can still adapt. */
+static bool IsUntypedConstant(Expr& expr) {
+  auto* literal = dynamic_cast<Literal*>(&expr);
+  return (literal && !literal->suffix) || IsFloatConstant(expr);
+}
+
+/** @brief Intrinsic kinds and argument counts, keyed by name after `@`. */
+static const std::unordered_map<std::string, std::pair<IntrinsicKind, size_t>>
+    intrinsics = {
+        {"sqrt", {IntrinsicKind::Sqrt, 1}},
+        {"fma", {IntrinsicKind::Fma, 3}},
+        {"abs", {IntrinsicKind::Abs, 1}},
+        {"floor", {IntrinsicKind::Floor, 1}},
+        {"ceil", {IntrinsicKind::Ceil, 1}},
+        {"min", {IntrinsicKind::Min, 2}},
+        {"max", {IntrinsicKind::Max, 2}},
+        {"popcount", {IntrinsicKind::Popcount, 1}},
+        {"ctz", {IntrinsicKind::Ctz, 1}},
+        {"clz", {IntrinsicKind::Clz, 1}},
+        {"prefetch", {IntrinsicKind::Prefetch, 1}},
+        {"expect", {IntrinsicKind::Expect, 2}},
+};
+
 /// TODO: Add a control flow analysis check to make sure that there is a return
 /// for every path possible in non-void functions
 
@@ -42,7 +208,7 @@ void SemanticAnalyzer::Visit(StructStmt& stmt) {
     seen.insert(field.identifier.lexeme);
 
     types::Type* ty = ResolveType(field.type_token);
-    if (!ty || ty->Void() || ty->Function()) {
+    if (!ty || ty->Void() || ty->Function() || ty->Reference()) {
       diagnose_.Error({field.identifier.location.line},
                       "Invalid struct field type: " + field.type_token.lexeme);
       return;
@@ -70,13 +236,32 @@ void SemanticAnalyzer::Visit(StructStmt& stmt) {
 }
 
 void SemanticAnalyzer::Visit(FunctionProto& stmt) {
+  if (stmt.is_extern && (stmt.inline_policy == InlinePolicy::Hint ||
+                         stmt.inline_policy == InlinePolicy::Always)) {
+    diagnose_.Error({stmt.name.location.line},
+                    "Extern functions have no body to inline: " +
+                        stmt.name.lexeme);
+  }
+
   types::Type* ret = ResolveType(stmt.return_type);
+  if (ret && ret->Reference()) {
+    diagnose_.Error({stmt.return_type.location.line},
+                    "Functions cannot return references: " +
+                        stmt.return_type.lexeme);
+  }
 
   std::vector<types::Type*> params;
   for (auto& arg : stmt.args) {
     types::Type* arg_type = ResolveArgType(arg.type_token);
     arg.resolved_type = arg_type;
     params.push_back(arg_type);
+    // A `const` function may not even read what its arguments point to.
+    if (stmt.effects == ExternEffects::Const && arg_type &&
+        HoldsPointer(arg_type)) {
+      diagnose_.Error({arg.identifier.location.line},
+                      "Const extern cannot take pointers: " +
+                          arg.identifier.lexeme);
+    }
   }
 
   std::string declared_name = stmt.name.lexeme;
@@ -84,11 +269,17 @@ void SemanticAnalyzer::Visit(FunctionProto& stmt) {
     declared_name = QualifiedName(current_mod_, stmt.name.lexeme);
   }
 
-  std::optional<SymbolId> id =
-      Declare(declared_name, types_.Function(ret, params, stmt.is_variadic),
-              true, {stmt.name.location.line});
+  stmt.resolved_type = types_.Function(ret, params, stmt.is_variadic);
+  std::optional<SymbolId> id = Declare(declared_name, stmt.resolved_type, true,
+                                       {stmt.name.location.line});
   if (id.has_value()) {
     stmt.id = id.value();
+    if (stmt.is_extern) {
+      extern_functions_.insert(id.value());
+    }
+    if (stmt.IsExported()) {
+      exported_functions_.insert(id.value());
+    }
   } else {
     std::string err = "Function could not be declared: " + stmt.name.lexeme;
     diagnose_.Error({stmt.name.location.line}, err);
@@ -105,13 +296,26 @@ void SemanticAnalyzer::Visit(FunctionStmt& stmt) {
   }
 
   current_return = ResolveType(proto->return_type);
+  current_function_ =
+      dynamic_cast<types::FunctionType*>(proto->resolved_type);
+  current_exported_ = proto->IsExported();
+  frame_params_.clear();
+  frame_locals_.clear();
 
   BeginScope();
 
   for (auto& arg : proto->args) {
+    // A reference parameter reads and writes like the value it refers to.
     types::Type* arg_type = ResolveArgType(arg.type_token);
-    Declare(arg.identifier.lexeme, arg_type, false,
-            {arg.identifier.location.line});
+    auto* ref = dynamic_cast<types::ReferenceType*>(arg_type);
+    if (ref) {
+      arg_type = ref->referent;
+    }
+    arg.id = Declare(arg.identifier.lexeme, arg_type, false,
+                     {arg.identifier.location.line});
+    if (arg.id.has_value() && !ref) {
+      frame_params_.insert(arg.id.value());
+    }
   }
 
   for (auto& s : stmt.body) {
@@ -152,6 +356,42 @@ void SemanticAnalyzer::Visit(IfStmt& stmt) {
   }
 }
 
+void SemanticAnalyzer::Visit(MatchStmt& stmt) {
+  Resolve(*stmt.subject);
+  types::Type* subject = stmt.subject->type;
+  if (subject && !subject->Int()) {
+    diagnose_.Error({stmt.match_token.location.line},
+                    "Match subject must be an integer");
+    subject = nullptr;
+  }
+
+  for (MatchArm& arm : stmt.arms) {
+    for (MatchPattern& pattern : arm.patterns) {
+      for (Expr* bound : {pattern.low.get(), pattern.high.get()}) {
+        if (!bound) {
+          continue;
+        }
+        Resolve(*bound);
+        if (subject && bound->type && !IsConvertible(subject, *bound)) {
+          diagnose_.Error({arm.case_token.location.line},
+                          "Match case type mismatch");
+        }
+      }
+    }
+    BeginScope();
+    for (auto& s : arm.body) {
+      Resolve(*s);
+    }
+    EndScope();
+  }
+
+  BeginScope();
+  for (auto& s : stmt.otherwise) {
+    Resolve(*s);
+  }
+  EndScope();
+}
+
 void SemanticAnalyzer::Visit(ExpressionStmt& stmt) {
   Resolve(*stmt.expr);
 }
@@ -175,15 +415,24 @@ void SemanticAnalyzer::Visit(ReturnStmt& stmt) {
   if (!stmt.value->type) {
     return;
   }
-  if (!stmt.value->type->IsThisType(current_return)) {
+  if (!IsConvertible(current_return, *stmt.value)) {
     diagnose_.Error({stmt.ret_token.location.line},
                     "Return value does not match current return type");
     return;
   }
+  stmt.resolved_type = current_return;
+  if (stmt.is_tail) {
+    CheckTailCall(stmt);
+  }
 }
 
 void SemanticAnalyzer::Visit(VarDeclarationStmt& stmt) {
-  if (env_.IsDeclaredInCurrentScope(stmt.name.lexeme)) {
+  // Globals share the module namespace with functions.
+  std::string declared_name = stmt.name.lexeme;
+  if (stmt.is_global && !current_mod_.empty()) {
+    declared_name = QualifiedName(current_mod_, stmt.name.lexeme);
+  }
+  if (env_.IsDeclaredInCurrentScope(declared_name)) {
     std::string error = "Variable already declared: " + stmt.name.lexeme;
     diagnose_.Error({stmt.name.location.line}, error);
     return;
@@ -196,18 +445,47 @@ void SemanticAnalyzer::Visit(VarDeclarationStmt& stmt) {
     return;
   }
 
-  if (!stmt.value->type->IsThisType(declared_type)) {
+  types::Type* symbol_type = declared_type;
+  if (auto* ref = dynamic_cast<types::ReferenceType*>(declared_type)) {
+    if (stmt.is_global || stmt.is_const) {
+      diagnose_.Error({stmt.name.location.line},
+                      "References must be local variables: " +
+                          stmt.name.lexeme);
+      return;
+    }
+    if (!CheckReferenceBinding(ref, *stmt.value, {stmt.name.location.line})) {
+      return;
+    }
+    symbol_type = ref->referent;
+  } else if (!IsAssignable(declared_type, *stmt.value, true)) {
     std::string error =
         "Type mismatch in variable declaration: " + stmt.name.lexeme;
     diagnose_.Error({stmt.name.location.line}, error);
     return;
   }
 
-  stmt.value->type = declared_type;
-  std::optional<SymbolId> id = Declare(stmt.name.lexeme, declared_type, false,
-                                       {stmt.name.location.line});
+  // Aggregate constants need storage, which only globals provide.
+  bool is_scalar =
+      declared_type->Int() || declared_type->Float() || declared_type->Bool();
+  if (stmt.is_const && !is_scalar && !stmt.is_global) {
+    diagnose_.Error({stmt.name.location.line},
+                    "Local constants must have a numeric or bool type: " +
+                        stmt.name.lexeme);
+    return;
+  }
+
+  if (stmt.value->type->IsThisType(declared_type)) {
+    stmt.value->type = declared_type;
+  }
+  stmt.resolved_type = declared_type;
+  std::optional<SymbolId> id =
+      Declare(declared_name, symbol_type, false, {stmt.name.location.line});
   if (id.has_value()) {
     stmt.id = id.value();
+    symbols_.GetSymbolInfo(id.value())->is_const = stmt.is_const;
+    if (!stmt.is_global) {
+      frame_locals_.insert(id.value());
+    }
   }
 }
 
@@ -238,6 +516,40 @@ void SemanticAnalyzer::Visit(MemberAccess& expr) {
     base_sym = LookupInCurrentModule(base->name.lexeme);
   }
 
+  if (base_sym && base_sym->type &&
+      (base_sym->type->Array() || base_sym->type->Slice() ||
+       base_sym->type->String())) {
+    base->id = base_sym->id;
+    base->type = base_sym->type;
+    if (expr.member.lexeme != "len") {
+      diagnose_.Error({expr.member.location.line},
+                      "Unknown field: " + expr.member.lexeme);
+      return;
+    }
+    expr.type = types_.Int32();
+    return;
+  }
+
+  if (base_sym && base_sym->type && base_sym->type->Vector()) {
+    base->id = base_sym->id;
+    base->type = base_sym->type;
+    auto* vector = static_cast<types::VectorType*>(base_sym->type);
+    const std::string& member = expr.member.lexeme;
+    bool is_mask = vector->element->Bool();
+    if (member == "len") {
+      expr.type = types_.Int32();
+    } else if (!is_mask &&
+               (member == "sum" || member == "min" || member == "max")) {
+      expr.type = vector->element;
+    } else if (is_mask && (member == "any" || member == "all")) {
+      expr.type = types_.Bool();
+    } else {
+      diagnose_.Error({expr.member.location.line},
+                      "Unknown field: " + member);
+    }
+    return;
+  }
+
   if (base_sym && base_sym->type && base_sym->type->Struct()) {
     base->id = base_sym->id;
     base->type = base_sym->type;
@@ -281,7 +593,8 @@ void SemanticAnalyzer::Visit(Binary& expr) {
     return;
   }
 
-  if (!expr.left->type->IsThisType(expr.right->type)) {
+  types::Type* operand = CommonType(*expr.left, *expr.right);
+  if (!operand) {
     std::string err = "Type mismatch: " + expr.op.lexeme;
     diagnose_.Error({expr.op.location.line}, err);
     return;
@@ -292,11 +605,31 @@ void SemanticAnalyzer::Visit(Binary& expr) {
     case Token::Type::Minus:
     case Token::Type::STAR:
     case Token::Type::SLASH:
-      expr.type = expr.left->type;
+    case Token::Type::MODULO:
+      if (!IsArithmetic(operand)) {
+        diagnose_.Error({expr.op.location.line},
+                        "Arithmetic requires numeric operands: " +
+                            expr.op.lexeme);
+        return;
+      }
+      expr.type = operand;
+      break;
+    case Token::Type::AMP:
+    case Token::Type::PIPE:
+    case Token::Type::CARET:
+    case Token::Type::LESSER_LESSER:
+    case Token::Type::GREATER_GREATER:
+      if (!IsBitwise(operand)) {
+        diagnose_.Error({expr.op.location.line},
+                        "Bitwise operators require integer operands: " +
+                            expr.op.lexeme);
+        return;
+      }
+      expr.type = operand;
       break;
     case Token::Type::EQEQ:
     case Token::Type::BANGEQ:
-      expr.type = types_.Bool();
+      expr.type = ComparisonType(operand);
       break;
     default:
       UNREACHABLE(VisitBinary, "Unknown operation: " + expr.op.lexeme);
@@ -309,13 +642,22 @@ void SemanticAnalyzer::Visit(Assign& expr) {
     return;
   }
   auto* sym = LookupSymbol(expr.name.lexeme);
+  if (!sym) {
+    sym = LookupInCurrentModule(expr.name.lexeme);
+  }
   if (!sym) {
     std::string err = "Assignment to undelcared variable: " + expr.name.lexeme;
     diagnose_.Error({expr.name.location.line}, err);
     return;
   }
 
-  if (!sym->type || !sym->type->IsThisType(expr.value->type)) {
+  if (sym->is_const) {
+    diagnose_.Error({expr.name.location.line},
+                    "Assignment to constant: " + expr.name.lexeme);
+    return;
+  }
+
+  if (!sym->type || !IsAssignable(sym->type, *expr.value)) {
     std::string err = "Type mismatch in assignment: " + expr.name.lexeme;
     diagnose_.Error({expr.name.location.line}, err);
     return;
@@ -335,7 +677,7 @@ void SemanticAnalyzer::Visit(MemberAssign& expr) {
     return;
   }
 
-  if (!expr.target->type->IsThisType(expr.value->type)) {
+  if (!expr.value->type || !IsConvertible(expr.target->type, *expr.value)) {
     diagnose_.Error({expr.target->member.location.line},
                     "Type mismatch in member assignment");
     return;
@@ -354,6 +696,12 @@ void SemanticAnalyzer::Visit(MemberAssign& expr) {
     return;
   }
 
+  if (symbols_.GetSymbolInfo(base->GetID())->is_const) {
+    diagnose_.Error({expr.target->member.location.line},
+                    "Assignment to constant: " + base->name.lexeme);
+    return;
+  }
+
   expr.base_id = base->GetID();
   expr.id = base->id;
   expr.type = expr.target->type;
@@ -361,12 +709,21 @@ void SemanticAnalyzer::Visit(MemberAssign& expr) {
 
 void SemanticAnalyzer::Visit(PreFixOp& expr) {
   auto* sym = LookupSymbol(expr.name.lexeme);
+  if (!sym) {
+    sym = LookupInCurrentModule(expr.name.lexeme);
+  }
   if (!sym) {
     std::string err = "Variable is not defined: " + expr.name.lexeme;
     diagnose_.Error({expr.op.location.line}, err);
     return;
   }
 
+  if (sym->is_const) {
+    diagnose_.Error({expr.op.location.line},
+                    "Assignment to constant: " + expr.name.lexeme);
+    return;
+  }
+
   if (sym->type->kind != types::TypeKind::Int &&
       sym->type->kind != types::TypeKind::Float) {
     std::string err =
@@ -381,16 +738,81 @@ void SemanticAnalyzer::Visit(PreFixOp& expr) {
 void SemanticAnalyzer::Visit(Conditional& expr) {
   Resolve(*expr.left);
   Resolve(*expr.right);
-  if (expr.left->type->kind != expr.right->type->kind) {
+  if (!expr.left->type || !expr.right->type) {
+    return;
+  }
+  expr.operand_type = CommonType(*expr.left, *expr.right);
+  if (!expr.operand_type) {
     std::string err = "Type mismatch: " + expr.op.lexeme;
     diagnose_.Error({expr.op.location.line}, err);
     return;
   }
-  expr.type = types_.Bool();
+  expr.type = ComparisonType(expr.operand_type);
+}
+
+void SemanticAnalyzer::Visit(Logical& expr) {
+  Resolve(*expr.left);
+  Resolve(*expr.right);
+  if (!expr.left->type || !expr.right->type) {
+    return;
+  }
+  if (!expr.left->type->Bool() || !expr.right->type->Bool()) {
+    diagnose_.Error({expr.op.location.line},
+                    "Logical operands must be bool: " + expr.op.lexeme);
+    return;
+  }
+  expr.type = expr.left->type;
+}
+
+void SemanticAnalyzer::Visit(Unary& expr) {
+  Resolve(*expr.operand);
+  if (!expr.operand->type) {
+    return;
+  }
+  bool is_not = expr.op.kind == Token::Type::BANG;
+  if (is_not && !expr.operand->type->Bool()) {
+    diagnose_.Error({expr.op.location.line},
+                    "Operand must be bool: " + expr.op.lexeme);
+    return;
+  }
+  if (!is_not && !IsBitwise(expr.operand->type)) {
+    diagnose_.Error({expr.op.location.line},
+                    "Operand must be an integer: " + expr.op.lexeme);
+    return;
+  }
+  expr.type = expr.operand->type;
+}
+
+void SemanticAnalyzer::Visit(IfExpr& expr) {
+  Resolve(*expr.cond);
+  Resolve(*expr.then);
+  Resolve(*expr.otherwise);
+  if (!expr.cond->type || !expr.then->type || !expr.otherwise->type) {
+    return;
+  }
+  if (!expr.cond->type->Bool()) {
+    diagnose_.Error({expr.if_token.location.line},
+                    "Conditional expression condition must be bool");
+    return;
+  }
+  types::Type* type = CommonType(*expr.then, *expr.otherwise);
+  if (!type || type->Void()) {
+    diagnose_.Error({expr.if_token.location.line},
+                    "Conditional expression branches have different types");
+    return;
+  }
+  // Arrays are built in place rather than passed around as values.
+  if (type->Array()) {
+    diagnose_.Error({expr.if_token.location.line},
+                    "Conditional expression cannot choose between arrays");
+    return;
+  }
+  expr.type = type;
 }
 
 void SemanticAnalyzer::Visit(Grouping& expr) {
   Resolve(*expr.expr);
+  expr.type = expr.expr->type;
 }
 
 void SemanticAnalyzer::Visit(CallExpr& expr) {
@@ -461,7 +883,7 @@ void SemanticAnalyzer::Visit(CallExpr& expr) {
       if (!expr.args[i]->type) {
         return;
       }
-      if (!expr.args[i]->type->IsThisType(struct_type->fields[i])) {
+      if (!IsConvertible(struct_type->fields[i], *expr.args[i])) {
         diagnose_.Error(call_loc,
                         "Type mismatch in struct constructor argument");
         return;
@@ -507,25 +929,53 @@ void SemanticAnalyzer::Visit(CallExpr& expr) {
       return;
     }
     if (i < num_params) {
-      if (expr.args[i]->type->kind != func_type->params[i]->kind) {
+      types::Type* param = func_type->params[i];
+      if (!param) {
+        // The parameter's own declaration was already reported.
+        return;
+      }
+      if (auto* ref = dynamic_cast<types::ReferenceType*>(param)) {
+        if (!CheckReferenceBinding(ref, *expr.args[i], call_loc)) {
+          return;
+        }
+        continue;
+      }
+      bool matches = param->Slice() ? IsAssignable(param, *expr.args[i])
+                                    : IsConvertible(param, *expr.args[i]);
+      if (!matches) {
         diagnose_.Error(call_loc, "Type mismatch in fixed argument");
         return;
       }
-    } else {
-      // This should come in handy later when types get extended
-      VariadicPromotion(expr.args[i].get());
+    } else if (expr.args[i]->type->Array() || expr.args[i]->type->Slice()) {
+      diagnose_.Error(call_loc,
+                      "Arrays cannot be passed as variadic arguments");
+      return;
+    } else if (expr.args[i]->type->Vector()) {
+      diagnose_.Error(call_loc,
+                      "Vectors cannot be passed as variadic arguments");
+      return;
     }
+    // Variadic arguments keep their type; codegen applies C's default
+    // argument promotions.
   }
 
   expr.type = func_type->return_type;
 }
 
-/// TODO: Extend literal types
 void SemanticAnalyzer::Visit(Literal& expr) {
-  if (std::holds_alternative<int>(expr.value)) {
-    expr.type = types_.Int32();
-  } else if (std::holds_alternative<float>(expr.value)) {
-    expr.type = types_.Float32();
+  if (expr.suffix) {
+    // The lexer already checked that the value fits its suffix.
+    expr.type = ResolveNumericSuffix(*expr.suffix);
+    return;
+  }
+  if (const int64_t* raw = std::get_if<int64_t>(&expr.value)) {
+    if (IntLiteralFits(*raw, *types_.Int32())) {
+      expr.type = types_.Int32();
+    } else {
+      expr.type = *raw < 0 ? types_.UInt64() : types_.Int64();
+    }
+  } else if (std::holds_alternative<double>(expr.value)) {
+    expr.type = types_.Float64();
   } else if (std::holds_alternative<std::string>(expr.value)) {
     expr.type = types_.String();
   } else if (std::holds_alternative<bool>(expr.value)) {
@@ -535,7 +985,434 @@ void SemanticAnalyzer::Visit(Literal& expr) {
   }
 }
 
+void SemanticAnalyzer::Visit(IndexAccess& expr) {
+  Resolve(*expr.object);
+  Resolve(*expr.index);
+  if (!expr.object->type || !expr.index->type) {
+    return;
+  }
+
+  if (!expr.index->type->Int()) {
+    diagnose_.Error({expr.bracket.location.line},
+                    "Array index must be an integer");
+    return;
+  }
+
+  std::error_code ec;
+  if (auto* array = expr.object->type->CastTo<types::ArrayType>(ec)) {
+    expr.type = array->element;
+    return;
+  }
+  ec.clear();
+  if (auto* slice = expr.object->type->CastTo<types::SliceType>(ec)) {
+    expr.type = slice->element;
+    return;
+  }
+  ec.clear();
+  if (auto* vector = expr.object->type->CastTo<types::VectorType>(ec)) {
+    expr.type = vector->element;
+    return;
+  }
+  diagnose_.Error({expr.bracket.location.line},
+                  "Indexed value is not an array, slice or vector");
+}
+
+void SemanticAnalyzer::Visit(SliceExpr& expr) {
+  Resolve(*expr.object);
+  for (Expr* bound : {expr.start.get(), expr.end.get()}) {
+    if (!bound) {
+      continue;
+    }
+    Resolve(*bound);
+    if (!bound->type) {
+      return;
+    }
+    if (!bound->type->Int()) {
+      diagnose_.Error({expr.bracket.location.line},
+                      "Slice bounds must be integers");
+      return;
+    }
+  }
+  if (!expr.object->type) {
+    return;
+  }
+
+  // Subranges borrow the object's storage, like an array passed as a slice.
+  types::Type* object = expr.object->type;
+  if (object->String() || object->Slice()) {
+    expr.type = object;
+    return;
+  }
+  if (auto* array = dynamic_cast<types::ArrayType*>(object)) {
+    // The subrange is a mutable slice, which must not view read-only data.
+    if (SymbolInfo* owner = ConstantOwner(*expr.object)) {
+      diagnose_.Error({expr.bracket.location.line},
+                      "Slice of constant array: " + owner->name);
+      return;
+    }
+    expr.type = types_.Slice(array->element);
+    return;
+  }
+  diagnose_.Error({expr.bracket.location.line},
+                  "Sliced value is not a string, slice or array");
+}
+
+void SemanticAnalyzer::Visit(IndexAssign& expr) {
+  Resolve(*expr.target);
+  Resolve(*expr.value);
+  if (!expr.target->type || !expr.value->type) {
+    return;
+  }
+
+  if (!IsAssignable(expr.target->type, *expr.value)) {
+    diagnose_.Error({expr.target->bracket.location.line},
+                    "Type mismatch in element assignment");
+    return;
+  }
+  if (ConstantOwner(*expr.target)) {
+    diagnose_.Error({expr.target->bracket.location.line},
+                    "Assignment to constant array element");
+    return;
+  }
+  expr.type = expr.target->type;
+}
+
+void SemanticAnalyzer::Visit(ArrayLiteral& expr) {
+  if (expr.elements.empty()) {
+    diagnose_.Error({expr.bracket.location.line},
+                    "Array literal needs at least one element");
+    return;
+  }
+
+  types::Type* element = nullptr;
+  for (auto& e : expr.elements) {
+    Resolve(*e);
+    if (!e->type) {
+      return;
+    }
+    if (!element) {
+      element = e->type;
+    } else if (IsWidening(element, e->type)) {
+      element = e->type;
+    } else if (!e->type->IsThisType(element) && !AdaptLiteral(element, *e) &&
+               !IsWidening(e->type, element)) {
+      diagnose_.Error({expr.bracket.location.line},
+                      "Array literal elements must have the same type");
+      return;
+    }
+  }
+
+  if (element->Void() || element->Function()) {
+    diagnose_.Error({expr.bracket.location.line}, "Invalid array element type");
+    return;
+  }
+  expr.type = types_.Array(element, expr.elements.size());
+}
+
+void SemanticAnalyzer::Visit(NewArray& expr) {
+  types::Type* element = ResolveType(expr.element_type);
+  Resolve(*expr.length);
+  if (!element || !expr.length->type) {
+    return;
+  }
+
+  if (element->Void()) {
+    diagnose_.Error({expr.keyword.location.line},
+                    "Invalid slice element type: " + expr.element_type.lexeme);
+    return;
+  }
+  if (!expr.length->type->Int()) {
+    diagnose_.Error({expr.keyword.location.line},
+                    "Slice length must be an integer");
+    return;
+  }
+  expr.type = types_.Slice(element);
+}
+
+void SemanticAnalyzer::Visit(Cast& expr) {
+  types::Type* target = ResolveType(expr.target);
+  Resolve(*expr.value);
+  if (!target || !expr.value->type) {
+    return;
+  }
+
+  // Vectors convert lane by lane; a scalar is broadcast to every lane.
+  types::Type* source = expr.value->type;
+  if (auto* vector = dynamic_cast<types::VectorType*>(target)) {
+    auto* from = dynamic_cast<types::VectorType*>(source);
+    if (from && from->lanes == vector->lanes) {
+      source = from->element;
+    }
+    if (vector->element->Bool()) {
+      source = nullptr;
+    }
+  }
+  if (!source || (!source->Int() && !source->Float() && !source->Bool())) {
+    diagnose_.Error({expr.target.location.line},
+                    "Invalid conversion to " + expr.target.lexeme);
+    return;
+  }
+  // A literal that fits is retyped instead of converted at runtime.
+  AdaptLiteral(target, *expr.value);
+  expr.type = target;
+}
+
+void SemanticAnalyzer::Visit(IntrinsicCall& expr) {
+  for (auto& arg : expr.args) {
+    Resolve(*arg);
+  }
+  const std::string name = "@" + expr.name.lexeme;
+  auto it = intrinsics.find(expr.name.lexeme);
+  if (it == intrinsics.end()) {
+    diagnose_.Error({expr.name.location.line}, "Unknown intrinsic: " + name);
+    return;
+  }
+  auto [kind, arity] = it->second;
+  if (expr.args.size() != arity) {
+    diagnose_.Error({expr.name.location.line},
+                    "Expected " + std::to_string(arity) +
+                        " arguments to " + name);
+    return;
+  }
+  for (auto& arg : expr.args) {
+    if (!arg->type) {
+      return;
+    }
+  }
+  expr.kind = kind;
+
+  if (kind == IntrinsicKind::Prefetch) {
+    // Only memory can be prefetched, so the operand must address an element.
+    auto* access = dynamic_cast<IndexAccess*>(expr.args[0].get());
+    if (!access || access->object->type->Vector()) {
+      diagnose_.Error({expr.name.location.line},
+                      name + " expects an array or slice element");
+      return;
+    }
+    expr.type = types_.Void();
+    return;
+  }
+
+  // Operands share the widest typed operand's type; unsuffixed literals
+  // adapt to it, as they do across a binary operator.
+  types::Type* operand = nullptr;
+  for (auto& arg : expr.args) {
+    if (IsUntypedConstant(*arg)) {
+      continue;
+    }
+    if (!operand || IsWidening(operand, arg->type)) {
+      operand = arg->type;
+    }
+  }
+  if (!operand) {
+    operand = expr.args[0]->type;
+  }
+  for (auto& arg : expr.args) {
+    if (operand && !IsConvertible(operand, *arg)) {
+      operand = nullptr;
+    }
+  }
+  if (!operand) {
+    diagnose_.Error({expr.name.location.line}, "Type mismatch: " + name);
+    return;
+  }
+
+  types::Type* lane = operand;
+  if (auto* vector = dynamic_cast<types::VectorType*>(operand)) {
+    lane = vector->element;
+  }
+  bool valid = false;
+  switch (kind) {
+    case IntrinsicKind::Sqrt:
+    case IntrinsicKind::Fma:
+    case IntrinsicKind::Floor:
+    case IntrinsicKind::Ceil:
+      valid = lane->Float();
+      break;
+    case IntrinsicKind::Abs:
+    case IntrinsicKind::Min:
+    case IntrinsicKind::Max:
+      valid = IsArithmetic(operand);
+      break;
+    case IntrinsicKind::Popcount:
+    case IntrinsicKind::Ctz:
+    case IntrinsicKind::Clz:
+      valid = lane->Int();
+      break;
+    case IntrinsicKind::Expect:
+      // The hint must be a constant for the optimizer to act on it.
+      valid = (operand->Int() || operand->Bool()) &&
+              dynamic_cast<Literal*>(expr.args[1].get());
+      break;
+    case IntrinsicKind::Prefetch:
+      break;
+  }
+  if (!valid) {
+    diagnose_.Error({expr.name.location.line},
+                    "Invalid operand type for " + name);
+    return;
+  }
+  expr.type = operand;
+}
+
+bool SemanticAnalyzer::AdaptLiteral(types::Type* target, Expr& value) {
+  if (auto* vector = dynamic_cast<types::VectorType*>(target)) {
+    // Literals broadcast; codegen splats the lane-typed scalar.
+    return AdaptLiteral(vector->element, value);
+  }
+  if (!target || (!target->Int() && !target->Float())) {
+    return false;
+  }
+  if (auto* grouping = dynamic_cast<Grouping*>(&value)) {
+    if (!AdaptLiteral(target, *grouping->expr)) {
+      return false;
+    }
+    grouping->type = target;
+    return true;
+  }
+  if (auto* binary = dynamic_cast<Binary*>(&value)) {
+    // Float constant expressions such as `0.0 - 1.5` adapt as a whole, since
+    // rounding cannot make them unrepresentable the way overflow could.
+    if (!target->Float() || !IsFloatConstant(*binary)) {
+      return false;
+    }
+    AdaptLiteral(target, *binary->left);
+    AdaptLiteral(target, *binary->right);
+    binary->type = target;
+    return true;
+  }
+
+  auto* literal = dynamic_cast<Literal*>(&value);
+  if (!literal || literal->suffix) {
+    return false;
+  }
+  if (auto* int_type = dynamic_cast<types::IntType*>(target)) {
+    const int64_t* raw = std::get_if<int64_t>(&literal->value);
+    if (!raw || !IntLiteralFits(*raw, *int_type)) {
+      return false;
+    }
+  } else if (!std::holds_alternative<double>(literal->value)) {
+    return false;
+  }
+  value.type = target;
+  return true;
+}
+
+types::Type* SemanticAnalyzer::ResolveNumericSuffix(cinder::Token::Type kind) {
+  switch (kind) {
+    case cinder::Token::Type::FLT32_SPECIFIER:
+      return types_.Float32();
+    case cinder::Token::Type::FLT64_SPECIFIER:
+      return types_.Float64();
+    default:
+      return ResolveIntType(kind);
+  }
+}
+
+bool SemanticAnalyzer::IsConvertible(types::Type* target, Expr& value) {
+  if (!target || !value.type) {
+    return false;
+  }
+  return value.type->IsThisType(target) || AdaptLiteral(target, value) ||
+         IsWidening(value.type, target);
+}
+
+types::Type* SemanticAnalyzer::CommonType(Expr& left, Expr& right) {
+  types::Type* lhs = left.type;
+  types::Type* rhs = right.type;
+  // Literals take the other operand's type before anything widens, so
+  // `0.5 * x` stays `flt32` for a `flt32` x.
+  if (lhs->IsThisType(rhs) || AdaptLiteral(lhs, right)) {
+    return lhs;
+  }
+  if (AdaptLiteral(rhs, left)) {
+    return rhs;
+  }
+  if (IsWidening(rhs, lhs)) {
+    return lhs;
+  }
+  if (IsWidening(lhs, rhs)) {
+    return rhs;
+  }
+  return nullptr;
+}
+
+bool SemanticAnalyzer::IsAssignable(types::Type* target, Expr& value,
+                                    bool is_declaration) {
+  types::Type* source = value.type;
+  if (!target || !source) {
+    return false;
+  }
+  if (IsConvertible(target, value)) {
+    return true;
+  }
+
+  std::error_code ec;
+  auto* array = source->CastTo<types::ArrayType>(ec);
+  if (ec) {
+    return false;
+  }
+
+  // Slices borrow the array's storage, so it needs an address. Constant
+  // arrays live in read-only data and a slice could write them.
+  if (auto* slice = target->CastTo<types::SliceType>(ec)) {
+    return array->element->IsThisType(slice->element) &&
+           (value.IsVariable() || value.IsIndexAccess()) &&
+           !ConstantOwner(value);
+  }
+  ec.clear();
+
+  if (auto* declared = target->CastTo<types::ArrayType>(ec)) {
+    if (!is_declaration || !value.IsArrayLiteral() ||
+        array->length > declared->length) {
+      return false;
+    }
+    if (array->element->IsThisType(declared->element)) {
+      return true;
+    }
+    auto& literal = static_cast<ArrayLiteral&>(value);
+    for (auto& element : literal.elements) {
+      if (!IsAssignable(declared->element, *element, true)) {
+        return false;
+      }
+    }
+    value.type = types_.Array(declared->element, array->length);
+    return true;
+  }
+  ec.clear();
+
+  // `flt32x4: v = [a, b, c, d];` builds a vector from its lanes.
+  if (auto* declared = target->CastTo<types::VectorType>(ec)) {
+    if (!is_declaration || !value.IsArrayLiteral() ||
+        array->length > declared->lanes) {
+      return false;
+    }
+    auto& literal = static_cast<ArrayLiteral&>(value);
+    for (auto& element : literal.elements) {
+      if (!IsConvertible(declared->element, *element)) {
+        return false;
+      }
+    }
+    value.type = declared;
+    return true;
+  }
+  return false;
+}
+
 types::Type* SemanticAnalyzer::ResolveArgType(Token type) {
+  if (HasReferencePrefix(type.lexeme)) {
+    return ResolveReferenceType(type);
+  }
+  if (type.lexeme.find('[') != std::string::npos) {
+    types::Type* resolved = ResolveArrayType(type);
+    if (resolved && resolved->Array()) {
+      diagnose_.Error({type.location.line},
+                      "Array parameters must be slices: " + type.lexeme);
+      return nullptr;
+    }
+    return resolved;
+  }
+
   if (type.kind == Token::Type::IDENTIFER) {
     types::StructType* struct_type = types_.LookupStruct(
         current_mod_.empty() ? type.lexeme
@@ -548,9 +1425,14 @@ types::Type* SemanticAnalyzer::ResolveArgType(Token type) {
     }
   }
 
+  if (types::IntType* int_type = ResolveIntType(type.kind)) {
+    return int_type;
+  }
+  if (types::VectorType* vector = ResolveVectorType(type.kind)) {
+    return vector;
+  }
+
   switch (type.kind) {
-    case Token::Type::INT32_SPECIFIER:
-      return types_.Int32();
     case Token::Type::FLT32_SPECIFIER:
       return types_.Float32();
     case Token::Type::FLT64_SPECIFIER:
@@ -559,7 +1441,6 @@ types::Type* SemanticAnalyzer::ResolveArgType(Token type) {
       return types_.Bool();
     case Token::Type::STR_SPECIFIER:
       return types_.String();
-    case Token::Type::INT64_SPECIFIER:
     // Not valid in args
     case Token::Type::VOID_SPECIFIER:
     default:
@@ -569,6 +1450,13 @@ types::Type* SemanticAnalyzer::ResolveArgType(Token type) {
 }
 
 types::Type* SemanticAnalyzer::ResolveType(Token type) {
+  if (HasReferencePrefix(type.lexeme)) {
+    return ResolveReferenceType(type);
+  }
+  if (type.lexeme.find('[') != std::string::npos) {
+    return ResolveArrayType(type);
+  }
+
   if (type.kind == Token::Type::IDENTIFER) {
     types::StructType* struct_type = types_.LookupStruct(
         current_mod_.empty() ? type.lexeme
@@ -581,9 +1469,14 @@ types::Type* SemanticAnalyzer::ResolveType(Token type) {
     }
   }
 
+  if (types::IntType* int_type = ResolveIntType(type.kind)) {
+    return int_type;
+  }
+  if (types::VectorType* vector = ResolveVectorType(type.kind)) {
+    return vector;
+  }
+
   switch (type.kind) {
-    case Token::Type::INT32_SPECIFIER:
-      return types_.Int32();
     case Token::Type::FLT32_SPECIFIER:
       return types_.Float32();
     case Token::Type::FLT64_SPECIFIER:
@@ -594,13 +1487,273 @@ types::Type* SemanticAnalyzer::ResolveType(Token type) {
       return types_.String();
     case Token::Type::BOOL_SPECIFIER:
       return types_.Bool();
-    case Token::Type::INT64_SPECIFIER:
     default:
       diagnose_.Error({type.location.line}, "Invalid type: " + type.lexeme);
   }
   return nullptr;
 }
 
+types::Type* SemanticAnalyzer::ResolveReferenceType(Token type) {
+  size_t space = type.lexeme.find(' ');
+  bool nullable = type.lexeme.compare(0, space, "ptr") == 0;
+  type.lexeme.erase(0, space + 1);
+
+  types::Type* referent = ResolveType(type);
+  if (!referent) {
+    return nullptr;
+  }
+  if (referent->Void() || referent->Reference()) {
+    diagnose_.Error({type.location.line},
+                    "Invalid reference type: " + type.lexeme);
+    return nullptr;
+  }
+  return types_.Reference(referent, nullable);
+}
+
+SymbolInfo* SemanticAnalyzer::ConstantOwner(Expr& value) {
+  // Fields and array elements share their owner's storage; slice elements
+  // live on the heap and belong to no constant.
+  Expr* root = &value;
+  while (true) {
+    if (auto* index = dynamic_cast<IndexAccess*>(root)) {
+      types::Type* object = index->object->type;
+      if (object && object->Slice()) {
+        return nullptr;
+      }
+      root = index->object.get();
+    } else if (auto* member = dynamic_cast<MemberAccess*>(root);
+               member && member->field_index.has_value()) {
+      root = member->object.get();
+    } else {
+      break;
+    }
+  }
+  if (!root->HasID()) {
+    return nullptr;
+  }
+  SymbolInfo* owner = symbols_.GetSymbolInfo(root->GetID());
+  return owner && owner->is_const ? owner : nullptr;
+}
+
+bool SemanticAnalyzer::CheckReferenceBinding(types::ReferenceType* target,
+                                             Expr& value, SourceLoc loc) {
+  // Walk fields and array elements down to the variable that owns them;
+  // slice elements live on the heap and need no owner.
+  Expr* root = &value;
+  while (root) {
+    if (auto* index = dynamic_cast<IndexAccess*>(root)) {
+      types::Type* object = index->object->type;
+      if (object && object->Vector()) {
+        diagnose_.Error(loc, "Vector lanes cannot be referenced");
+        return false;
+      }
+      root = object && object->Slice() ? nullptr : index->object.get();
+    } else if (auto* member = dynamic_cast<MemberAccess*>(root);
+               member && member->field_index.has_value()) {
+      root = member->object.get();
+    } else {
+      break;
+    }
+  }
+
+  bool is_storage = !root || ((root->IsVariable() || root->IsMemberAccess()) &&
+                              root->HasID());
+  SymbolInfo* owner =
+      root && is_storage ? symbols_.GetSymbolInfo(root->GetID()) : nullptr;
+  if (!is_storage || (owner && owner->is_function)) {
+    diagnose_.Error(loc, "Reference must bind to a variable, field or element");
+    return false;
+  }
+  if (owner && owner->is_const) {
+    diagnose_.Error(loc, "Reference to constant: " + owner->name);
+    return false;
+  }
+  if (!value.type || !value.type->IsThisType(target->referent)) {
+    diagnose_.Error(loc, "Type mismatch in reference binding");
+    return false;
+  }
+  return true;
+}
+
+void SemanticAnalyzer::CheckTailCall(ReturnStmt& stmt) {
+  auto& call = static_cast<CallExpr&>(*stmt.value);
+  SourceLoc loc{stmt.ret_token.location.line};
+  auto* callee = dynamic_cast<types::FunctionType*>(call.callee->type);
+  if (!callee || !call.callee->HasID()) {
+    diagnose_.Error(loc, "Tail call target must be a function");
+    return;
+  }
+  std::string name = symbols_.GetSymbolInfo(call.callee->GetID())->name;
+  if (extern_functions_.count(call.callee->GetID())) {
+    diagnose_.Error(loc, "Tail call target cannot be extern: " + name);
+    return;
+  }
+  if (!SameSignature(callee, current_function_) || callee->IsVariadic()) {
+    diagnose_.Error(loc, "Tail call signature mismatch: " + name);
+    return;
+  }
+  // `musttail` needs both sides on one calling convention.
+  if (exported_functions_.count(call.callee->GetID()) != current_exported_) {
+    diagnose_.Error(loc, "Tail call calling convention mismatch: " + name);
+    return;
+  }
+
+  for (size_t i = 0; i < call.args.size(); ++i) {
+    types::Type* param = callee->params[i];
+    Expr& arg = *call.args[i];
+    bool escapes = false;
+    if (param->Reference()) {
+      escapes = MayAddressFrame(arg);
+    } else if (HoldsPointer(param)) {
+      escapes = MayViewFrame(arg);
+    }
+    if (escapes) {
+      diagnose_.Error(loc, "Tail call argument may point into the frame: " +
+                               name);
+      return;
+    }
+    // Backends cannot reliably copy a `byval` argument into the frame the
+    // tail call is reusing.
+    if (param->Struct() && ScalarCount(param) > kTailCallFieldBudget) {
+      diagnose_.Error(loc, "Tail call cannot copy a large struct: " + name);
+      return;
+    }
+  }
+}
+
+bool SemanticAnalyzer::MayAddressFrame(Expr& lvalue) {
+  if (auto* group = dynamic_cast<Grouping*>(&lvalue)) {
+    return MayAddressFrame(*group->expr);
+  }
+  if (auto* index = dynamic_cast<IndexAccess*>(&lvalue)) {
+    // Slice elements live wherever the slice points.
+    types::Type* object = index->object->type;
+    return object && object->Slice() ? MayViewFrame(*index->object)
+                                     : MayAddressFrame(*index->object);
+  }
+  if (auto* member = dynamic_cast<MemberAccess*>(&lvalue)) {
+    // Without a field index this names a global of another module.
+    return member->field_index.has_value() && MayAddressFrame(*member->object);
+  }
+  if (lvalue.IsVariable() && lvalue.HasID()) {
+    return frame_params_.count(lvalue.GetID()) ||
+           frame_locals_.count(lvalue.GetID());
+  }
+  return true;
+}
+
+bool SemanticAnalyzer::MayViewFrame(Expr& value) {
+  if (value.type && value.type->Array()) {
+    // An array passed on views, or copies pointers out of, its own storage.
+    return MayAddressFrame(value);
+  }
+  if (auto* group = dynamic_cast<Grouping*>(&value)) {
+    return MayViewFrame(*group->expr);
+  }
+  if (auto* slice = dynamic_cast<SliceExpr*>(&value)) {
+    return MayViewFrame(*slice->object);
+  }
+  if (dynamic_cast<Literal*>(&value) || dynamic_cast<NewArray*>(&value)) {
+    return false;
+  }
+  // Parameters and globals point wherever the caller's caller chose; a
+  // local may have been bound to the caller's own arrays.
+  if (value.IsVariable() && value.HasID()) {
+    return frame_locals_.count(value.GetID());
+  }
+  return true;
+}
+
+types::Type* SemanticAnalyzer::ResolveArrayType(Token type) {
+  size_t bracket = type.lexeme.find('[');
+  std::string suffixes = type.lexeme.substr(bracket);
+  type.lexeme.resize(bracket);
+
+  types::Type* element = ResolveType(type);
+  if (!element) {
+    return nullptr;
+  }
+  if (element->Void()) {
+    diagnose_.Error({type.location.line},
+                    "Invalid array element type: " + type.lexeme);
+    return nullptr;
+  }
+
+  // `T[a][b]` is `a` rows of `T[b]`, so wrap the innermost suffix first.
+  std::vector<std::string> dims;
+  size_t pos = 0;
+  while (pos < suffixes.size()) {
+    size_t close = suffixes.find(']', pos);
+    dims.push_back(suffixes.substr(pos + 1, close - pos - 1));
+    pos = close + 1;
+  }
+
+  for (auto it = dims.rbegin(); it != dims.rend(); ++it) {
+    if (it->empty()) {
+      element = types_.Slice(element);
+      continue;
+    }
+    uint64_t length = 0;
+    auto [ptr, ec] =
+        std::from_chars(it->data(), it->data() + it->size(), length);
+    if (ec != std::errc() || length == 0) {
+      diagnose_.Error({type.location.line}, "Invalid array length: " + *it);
+      return nullptr;
+    }
+    element = types_.Array(element, length);
+  }
+  return element;
+}
+
+types::IntType* SemanticAnalyzer::ResolveIntType(Token::Type kind) {
+  switch (kind) {
+    case Token::Type::INT8_SPECIFIER:
+      return types_.Int8();
+    case Token::Type::INT16_SPECIFIER:
+      return types_.Int16();
+    case Token::Type::INT32_SPECIFIER:
+      return types_.Int32();
+    case Token::Type::INT64_SPECIFIER:
+      return types_.Int64();
+    case Token::Type::UINT8_SPECIFIER:
+      return types_.UInt8();
+    case Token::Type::UINT16_SPECIFIER:
+      return types_.UInt16();
+    case Token::Type::UINT32_SPECIFIER:
+      return types_.UInt32();
+    case Token::Type::UINT64_SPECIFIER:
+      return types_.UInt64();
+    default:
+      return nullptr;
+  }
+}
+
+types::VectorType* SemanticAnalyzer::ResolveVectorType(Token::Type kind) {
+  switch (kind) {
+    case Token::Type::FLT32X4_SPECIFIER:
+      return types_.Vector(types_.Float32(), 4);
+    case Token::Type::FLT32X8_SPECIFIER:
+      return types_.Vector(types_.Float32(), 8);
+    case Token::Type::INT32X4_SPECIFIER:
+      return types_.Vector(types_.Int32(), 4);
+    case Token::Type::INT32X8_SPECIFIER:
+      return types_.Vector(types_.Int32(), 8);
+    case Token::Type::BOOLX4_SPECIFIER:
+      return types_.Vector(types_.Bool(), 4);
+    case Token::Type::BOOLX8_SPECIFIER:
+      return types_.Vector(types_.Bool(), 8);
+    default:
+      return nullptr;
+  }
+}
+
+types::Type* SemanticAnalyzer::ComparisonType(types::Type* operand) {
+  if (auto* vector = dynamic_cast<types::VectorType*>(operand)) {
+    return types_.Vector(types_.Bool(), vector->lanes);
+  }
+  return types_.Bool();
+}
+
 void SemanticAnalyzer::Resolve(Stmt& stmt) {
   stmt.Accept(*this);
 }
@@ -657,6 +1810,7 @@ void SemanticAnalyzer::Analyze(ModuleStmt& mod) {
 }
 
 void SemanticAnalyzer::AnalyzeProgram(const std::vector<ModuleStmt*>& modules) {
+  PhaseTimer timer("sema", "Semantic analysis");
   BeginScope();
 
   for (ModuleStmt* mod : modules) {
@@ -679,10 +1833,21 @@ void SemanticAnalyzer::AnalyzeProgram(const std::vector<ModuleStmt*>& modules) {
     }
   }
 
+  // Globals come before bodies so functions may use them in any order.
+  for (ModuleStmt* mod : modules) {
+    current_mod_ = mod->name.lexeme;
+    for (auto& stmt : mod->stmts) {
+      if (auto* global = dynamic_cast<VarDeclarationStmt*>(stmt.get())) {
+        global->is_global = true;
+        Resolve(*global);
+      }
+    }
+  }
   for (ModuleStmt* mod : modules) {
     current_mod_ = mod->name.lexeme;
     for (auto& stmt : mod->stmts) {
-      if (stmt->IsImport() || stmt->IsFunctionP() || stmt->IsStruct()) {
+      if (stmt->IsImport() || stmt->IsFunctionP() || stmt->IsStruct() ||
+          stmt->IsVarDeclaration()) {
         continue;
       }
       Resolve(*stmt);
@@ -690,25 +1855,12 @@ void SemanticAnalyzer::AnalyzeProgram(const std::vector<ModuleStmt*>& modules) {
   }
 
   EndScope();
-}
 
-void SemanticAnalyzer::VariadicPromotion(Expr* expr) {
-  switch (expr->type->kind) {
-    case types::TypeKind::Float:
-      expr->type = types_.Float32();
-      break;
-    case types::TypeKind::Int:
-      expr->type = types_.Int32();
-      break;
-    case types::TypeKind::Bool:
-      expr->type = types_.Int32();
-      break;
-    case types::TypeKind::Function:
-    case types::TypeKind::String:
-    case types::TypeKind::Struct:
-    case types::TypeKind::Void:
-    default:
-      break;
+  // Folding needs settled types, and literals only settle once their whole
+  // expression has been checked.
+  if (!HadError()) {
+    ConstEvaluator folder(diagnose_);
+    folder.Run(modules);
   }
 }
 
@@ -738,6 +1890,14 @@ static std::string SymbolTypeToString(types::Type& type) {
       return "Void";
     case types::TypeKind::Function:
       return "Function";
+    case types::TypeKind::Array:
+      return "Array";
+    case types::TypeKind::Slice:
+      return "Slice";
+    case types::TypeKind::Vector:
+      return "Vector";
+    case types::TypeKind::Reference:
+      return "Reference";
     default:
       return "Not matched to type";
   }
@@ -755,3 +1915,7 @@ void SemanticAnalyzer::DebugSymbols() {
     diagnose_.Debug(loc, symbol);
   }
 }
+
+size_t SemanticAnalyzer::SymbolCount() const {
+  return symbols_.Size();
+}
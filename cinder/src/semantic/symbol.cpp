@@ -25,4 +25,8 @@ const SymbolInfo* ResolvedSymbols::GetSymbolInfo(SymbolId id) const {
 
 std::vector<SymbolInfo> ResolvedSymbols::GetSymbolTable() {
   return symbols_;
+}
+
+size_t ResolvedSymbols::Size() const {
+  return symbols_.size();
 }
\ No newline at end of file
@@ -4,6 +4,14 @@
 
 using namespace cinder;
 
+types::IntType* TypeContext::Int8() {
+  return &int8_;
+}
+
+types::IntType* TypeContext::Int16() {
+  return &int16_;
+}
+
 types::IntType* TypeContext::Int32() {
   return &int32_;
 }
@@ -12,6 +20,37 @@ types::IntType* TypeContext::Int64() {
   return &int64_;
 }
 
+types::IntType* TypeContext::UInt8() {
+  return &uint8_;
+}
+
+types::IntType* TypeContext::UInt16() {
+  return &uint16_;
+}
+
+types::IntType* TypeContext::UInt32() {
+  return &uint32_;
+}
+
+types::IntType* TypeContext::UInt64() {
+  return &uint64_;
+}
+
+types::IntType* TypeContext::Int(unsigned bits, bool is_signed) {
+  switch (bits) {
+    case 8:
+      return is_signed ? Int8() : UInt8();
+    case 16:
+      return is_signed ? Int16() : UInt16();
+    case 32:
+      return is_signed ? Int32() : UInt32();
+    case 64:
+      return is_signed ? Int64() : UInt64();
+    default:
+      return nullptr;
+  }
+}
+
 types::FloatType* TypeContext::Float32() {
   return &flt32_;
 }
@@ -57,3 +96,44 @@ types::StructType* TypeContext::LookupStruct(const std::string& name) {
   }
   return it->second.get();
 }
+
+types::ArrayType* TypeContext::Array(types::Type* element, uint64_t length) {
+  auto& slot = array_types_[{element, length}];
+  if (!slot) {
+    slot = std::make_unique<types::ArrayType>(element, length);
+  }
+  return slot.get();
+}
+
+types::SliceType* TypeContext::Slice(types::Type* element) {
+  auto& slot = slice_types_[element];
+  if (!slot) {
+    slot = std::make_unique<types::SliceType>(element);
+  }
+  return slot.get();
+}
+
+types::VectorType* TypeContext::Vector(types::Type* element, unsigned lanes) {
+  auto& slot = vector_types_[{element, lanes}];
+  if (!slot) {
+    slot = std::make_unique<types::VectorType>(element, lanes);
+  }
+  return slot.get();
+}
+
+types::ReferenceType* TypeContext::Reference(types::Type* referent,
+                                             bool nullable) {
+  auto& slot = reference_types_[{referent, nullable}];
+  if (!slot) {
+    slot = std::make_unique<types::ReferenceType>(referent, nullable);
+  }
+  return slot.get();
+}
+
+size_t TypeContext::FunctionTypeCount() const {
+  return function_pool_.size();
+}
+
+size_t TypeContext::StructTypeCount() const {
+  return struct_types_.size();
+}
@@ -33,6 +33,33 @@ static std::string EscapeString(const std::string& value) {
   return escaped;
 }
 
+/** @brief Returns the ` likely`/` unlikely` label for a branch hint. */
+static std::string HintLabel(BranchHint hint) {
+  switch (hint) {
+    case BranchHint::Likely:
+      return " likely";
+    case BranchHint::Unlikely:
+      return " unlikely";
+    case BranchHint::None:
+      break;
+  }
+  return "";
+}
+
+static std::string InlineLabel(InlinePolicy policy) {
+  switch (policy) {
+    case InlinePolicy::Hint:
+      return " @inline";
+    case InlinePolicy::Always:
+      return " @always_inline";
+    case InlinePolicy::Never:
+      return " @noinline";
+    case InlinePolicy::Default:
+      break;
+  }
+  return "";
+}
+
 template <class... Ts>
 struct overload : Ts... {
   using Ts::operator()...;
@@ -147,6 +174,98 @@ std::string AstDumper::Visit(Conditional& expr) {
   return out;
 }
 
+std::string AstDumper::Visit(Logical& expr) {
+  std::string out = "Logical " + expr.op.lexeme + "\n";
+  AppendTreeBlock(&out, "", false, "left", expr.left->Accept(*this));
+  AppendTreeBlock(&out, "", true, "right", expr.right->Accept(*this));
+  TrimTrailingNewline(&out);
+  return out;
+}
+
+std::string AstDumper::Visit(Unary& expr) {
+  std::string out = "Unary " + expr.op.lexeme + "\n";
+  AppendTreeBlock(&out, "", true, "operand", expr.operand->Accept(*this));
+  TrimTrailingNewline(&out);
+  return out;
+}
+
+std::string AstDumper::Visit(IfExpr& expr) {
+  std::string out = "IfExpr\n";
+  AppendTreeBlock(&out, "", false, "cond", expr.cond->Accept(*this));
+  AppendTreeBlock(&out, "", false, "then", expr.then->Accept(*this));
+  AppendTreeBlock(&out, "", true, "else", expr.otherwise->Accept(*this));
+  TrimTrailingNewline(&out);
+  return out;
+}
+
+std::string AstDumper::Visit(IndexAccess& expr) {
+  std::string out = "IndexAccess\n";
+  AppendTreeBlock(&out, "", false, "object", expr.object->Accept(*this));
+  AppendTreeBlock(&out, "", true, "index", expr.index->Accept(*this));
+  TrimTrailingNewline(&out);
+  return out;
+}
+
+std::string AstDumper::Visit(IndexAssign& expr) {
+  std::string out = "IndexAssign\n";
+  AppendTreeBlock(&out, "", false, "target", expr.target->Accept(*this));
+  AppendTreeBlock(&out, "", true, "value", expr.value->Accept(*this));
+  TrimTrailingNewline(&out);
+  return out;
+}
+
+std::string AstDumper::Visit(ArrayLiteral& expr) {
+  std::string out = "ArrayLiteral\n";
+  for (size_t i = 0; i < expr.elements.size(); ++i) {
+    const bool is_last = (i + 1) == expr.elements.size();
+    AppendTreeBlock(&out, "", is_last, "elem[" + std::to_string(i) + "]",
+                    expr.elements[i]->Accept(*this));
+  }
+  TrimTrailingNewline(&out);
+  return out;
+}
+
+std::string AstDumper::Visit(NewArray& expr) {
+  std::string out = "NewArray " + expr.element_type.lexeme + "\n";
+  AppendTreeBlock(&out, "", true, "length", expr.length->Accept(*this));
+  TrimTrailingNewline(&out);
+  return out;
+}
+
+std::string AstDumper::Visit(Cast& expr) {
+  std::string out = "Cast " + expr.target.lexeme + "\n";
+  AppendTreeBlock(&out, "", true, "value", expr.value->Accept(*this));
+  TrimTrailingNewline(&out);
+  return out;
+}
+
+std::string AstDumper::Visit(IntrinsicCall& expr) {
+  std::string out = "IntrinsicCall @" + expr.name.lexeme + "\n";
+  for (size_t i = 0; i < expr.args.size(); ++i) {
+    const bool is_last = (i + 1) == expr.args.size();
+    AppendTreeBlock(&out, "", is_last, "arg[" + std::to_string(i) + "]",
+                    expr.args[i]->Accept(*this));
+  }
+  TrimTrailingNewline(&out);
+  return out;
+}
+
+std::string AstDumper::Visit(SliceExpr& expr) {
+  std::string out = "SliceExpr\n";
+  bool has_start = expr.start != nullptr;
+  bool has_end = expr.end != nullptr;
+  AppendTreeBlock(&out, "", !has_start && !has_end, "object",
+                  expr.object->Accept(*this));
+  if (has_start) {
+    AppendTreeBlock(&out, "", !has_end, "start", expr.start->Accept(*this));
+  }
+  if (has_end) {
+    AppendTreeBlock(&out, "", true, "end", expr.end->Accept(*this));
+  }
+  TrimTrailingNewline(&out);
+  return out;
+}
+
 std::string AstDumper::Visit(ExpressionStmt& stmt) {
   std::string out = "ExpressionStmt\n";
   AppendTreeBlock(&out, "", true, "expr", stmt.expr->Accept(*this));
@@ -168,7 +287,7 @@ std::string AstDumper::Visit(FunctionStmt& stmt) {
 }
 
 std::string AstDumper::Visit(ReturnStmt& stmt) {
-  std::string out = "ReturnStmt\n";
+  std::string out = stmt.is_tail ? "ReturnStmt tail\n" : "ReturnStmt\n";
   if (stmt.value) {
     AppendTreeBlock(&out, "", true, "value", stmt.value->Accept(*this));
   }
@@ -177,16 +296,28 @@ std::string AstDumper::Visit(ReturnStmt& stmt) {
 }
 
 std::string AstDumper::Visit(VarDeclarationStmt& stmt) {
-  std::string out =
-      "VarDeclaration " + stmt.type.lexeme + " " + stmt.name.lexeme + "\n";
+  std::string out = "VarDeclaration " +
+                    std::string(stmt.is_const ? "const " : "") +
+                    stmt.type.lexeme + " " + stmt.name.lexeme + "\n";
   AppendTreeBlock(&out, "", true, "value", stmt.value->Accept(*this));
   TrimTrailingNewline(&out);
   return out;
 }
 
 std::string AstDumper::Visit(FunctionProto& stmt) {
-  std::string out = "FunctionProto " + stmt.name.lexeme + " -> " +
-                    stmt.return_type.lexeme + "\n";
+  std::string out = "FunctionProto";
+  if (stmt.effects == ExternEffects::Pure) {
+    out += " pure";
+  } else if (stmt.effects == ExternEffects::Const) {
+    out += " const";
+  }
+  out += InlineLabel(stmt.inline_policy);
+  if (stmt.frequency == CallFrequency::Cold) {
+    out += " @cold";
+  } else if (stmt.frequency == CallFrequency::Hot) {
+    out += " @hot";
+  }
+  out += " " + stmt.name.lexeme + " -> " + stmt.return_type.lexeme + "\n";
   for (size_t i = 0; i < stmt.args.size(); ++i) {
     const auto& arg = stmt.args[i];
     const std::string arg_line =
@@ -214,7 +345,7 @@ std::string AstDumper::Visit(ModuleStmt& stmt) {
 }
 
 std::string AstDumper::Visit(IfStmt& stmt) {
-  std::string out = "IfStmt\n";
+  std::string out = "IfStmt" + HintLabel(stmt.hint) + "\n";
 
   const bool has_else = static_cast<bool>(stmt.otherwise);
   AppendTreeBlock(&out, "", false, "condition", stmt.cond->Accept(*this));
@@ -228,7 +359,7 @@ std::string AstDumper::Visit(IfStmt& stmt) {
 }
 
 std::string AstDumper::Visit(ForStmt& stmt) {
-  std::string out = "ForStmt\n";
+  std::string out = "ForStmt" + HintLabel(stmt.hint) + "\n";
 
   const bool has_step = static_cast<bool>(stmt.step);
   const bool has_body = !stmt.body.empty();
@@ -256,7 +387,7 @@ std::string AstDumper::Visit(ForStmt& stmt) {
 }
 
 std::string AstDumper::Visit(WhileStmt& stmt) {
-  std::string out = "WhileStmt\n";
+  std::string out = "WhileStmt" + HintLabel(stmt.hint) + "\n";
   const bool has_body = !stmt.body.empty();
   AppendTreeBlock(&out, "", !has_body, "condition",
                   stmt.condition->Accept(*this));
@@ -268,6 +399,47 @@ std::string AstDumper::Visit(WhileStmt& stmt) {
   TrimTrailingNewline(&out);
   return out;
 }
+
+std::string AstDumper::Visit(MatchStmt& stmt) {
+  std::string out = "MatchStmt\n";
+  const bool has_else = !stmt.otherwise.empty();
+  AppendTreeBlock(&out, "", stmt.arms.empty() && !has_else, "subject",
+                  stmt.subject->Accept(*this));
+  for (size_t i = 0; i < stmt.arms.size(); ++i) {
+    const MatchArm& arm = stmt.arms[i];
+    std::string arm_out = "MatchArm\n";
+    for (size_t j = 0; j < arm.patterns.size(); ++j) {
+      const MatchPattern& pattern = arm.patterns[j];
+      const bool is_last = (j + 1) == arm.patterns.size() && arm.body.empty();
+      std::string value = pattern.low->Accept(*this);
+      if (pattern.high) {
+        value = "Range\n";
+        AppendTreeBlock(&value, "", false, "low", pattern.low->Accept(*this));
+        AppendTreeBlock(&value, "", true, "high", pattern.high->Accept(*this));
+        TrimTrailingNewline(&value);
+      }
+      AppendTreeBlock(&arm_out, "", is_last,
+                      "case[" + std::to_string(j) + "]", value);
+    }
+    for (size_t j = 0; j < arm.body.size(); ++j) {
+      const bool is_last = (j + 1) == arm.body.size();
+      AppendTreeBlock(&arm_out, "", is_last, "body[" + std::to_string(j) + "]",
+                      arm.body[j]->Accept(*this));
+    }
+    TrimTrailingNewline(&arm_out);
+    const bool is_last = (i + 1) == stmt.arms.size() && !has_else;
+    AppendTreeBlock(&out, "", is_last, "arm[" + std::to_string(i) + "]",
+                    arm_out);
+  }
+  for (size_t i = 0; i < stmt.otherwise.size(); ++i) {
+    const bool is_last = (i + 1) == stmt.otherwise.size();
+    AppendTreeBlock(&out, "", is_last, "else[" + std::to_string(i) + "]",
+                    stmt.otherwise[i]->Accept(*this));
+  }
+  TrimTrailingNewline(&out);
+  return out;
+}
+
 std::string AstDumper::Visit(ImportStmt& stmt) {
   return "ImportStmt " + stmt.mod_name.lexeme;
 }
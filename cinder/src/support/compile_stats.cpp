@@ -0,0 +1,381 @@
+#include "cinder/support/compile_stats.hpp"
+
+#include "cinder/ast/expr/expr.hpp"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+static bool stats_enabled = false;
+
+namespace {
+
+const char* ExprTypeName(Expr::ExprType type) {
+  switch (type) {
+    case Expr::ExprType::Literal:
+      return "Literal";
+    case Expr::ExprType::Variable:
+      return "Variable";
+    case Expr::ExprType::MemberAccess:
+      return "MemberAccess";
+    case Expr::ExprType::Grouping:
+      return "Grouping";
+    case Expr::ExprType::PreFix:
+      return "PreFix";
+    case Expr::ExprType::Binary:
+      return "Binary";
+    case Expr::ExprType::Call:
+      return "Call";
+    case Expr::ExprType::Assign:
+      return "Assign";
+    case Expr::ExprType::MemberAssign:
+      return "MemberAssign";
+    case Expr::ExprType::Conditional:
+      return "Conditional";
+    case Expr::ExprType::Logical:
+      return "Logical";
+    case Expr::ExprType::Unary:
+      return "Unary";
+    case Expr::ExprType::IfExpr:
+      return "IfExpr";
+    case Expr::ExprType::Index:
+      return "Index";
+    case Expr::ExprType::IndexAssign:
+      return "IndexAssign";
+    case Expr::ExprType::ArrayLiteral:
+      return "ArrayLiteral";
+    case Expr::ExprType::NewArray:
+      return "NewArray";
+    case Expr::ExprType::Cast:
+      return "Cast";
+    case Expr::ExprType::Intrinsic:
+      return "Intrinsic";
+    case Expr::ExprType::Slice:
+      return "Slice";
+    case Expr::ExprType::Unknown:
+      return "Unknown";
+  }
+  return "Unknown";
+}
+
+const char* StmtTypeName(Stmt::StmtType type) {
+  switch (type) {
+    case Stmt::StmtType::Module:
+      return "Module";
+    case Stmt::StmtType::Expression:
+      return "Expression";
+    case Stmt::StmtType::Function:
+      return "Function";
+    case Stmt::StmtType::FunctionProto:
+      return "FunctionProto";
+    case Stmt::StmtType::Return:
+      return "Return";
+    case Stmt::StmtType::VarDeclaration:
+      return "VarDeclaration";
+    case Stmt::StmtType::If:
+      return "If";
+    case Stmt::StmtType::For:
+      return "For";
+    case Stmt::StmtType::While:
+      return "While";
+    case Stmt::StmtType::Match:
+      return "Match";
+    case Stmt::StmtType::Import:
+      return "Import";
+    case Stmt::StmtType::Struct:
+      return "Struct";
+  }
+  return "Unknown";
+}
+
+/** @brief Walks an AST and tallies nodes by their type tag. */
+struct AstCounter : SemanticExprVisitor, SemanticStmtVisitor {
+  CompileStats& stats;
+
+  explicit AstCounter(CompileStats& stats) : stats(stats) {}
+
+  using SemanticExprVisitor::Visit;
+  using SemanticStmtVisitor::Visit;
+
+  void Count(Expr* expr) {
+    if (!expr) {
+      return;
+    }
+    ++stats.expr_counts[ExprTypeName(expr->expr_type)];
+    expr->Accept(*this);
+  }
+
+  void Count(Stmt* stmt) {
+    if (!stmt) {
+      return;
+    }
+    ++stats.stmt_counts[StmtTypeName(stmt->stmt_type)];
+    stmt->Accept(*this);
+  }
+
+  void Count(const std::vector<std::unique_ptr<Stmt>>& stmts) {
+    for (const auto& stmt : stmts) {
+      Count(stmt.get());
+    }
+  }
+
+  void Visit(Literal& expr) override {}
+  void Visit(Variable& expr) override {}
+  void Visit(MemberAccess& expr) override { Count(expr.object.get()); }
+  void Visit(Grouping& expr) override { Count(expr.expr.get()); }
+  void Visit(PreFixOp& expr) override {}
+  void Visit(Binary& expr) override {
+    Count(expr.left.get());
+    Count(expr.right.get());
+  }
+  void Visit(CallExpr& expr) override {
+    Count(expr.callee.get());
+    for (const auto& arg : expr.args) {
+      Count(arg.get());
+    }
+  }
+  void Visit(Assign& expr) override { Count(expr.value.get()); }
+  void Visit(MemberAssign& expr) override {
+    Count(expr.target.get());
+    Count(expr.value.get());
+  }
+  void Visit(Conditional& expr) override {
+    Count(expr.left.get());
+    Count(expr.right.get());
+  }
+  void Visit(Logical& expr) override {
+    Count(expr.left.get());
+    Count(expr.right.get());
+  }
+  void Visit(Unary& expr) override { Count(expr.operand.get()); }
+  void Visit(IfExpr& expr) override {
+    Count(expr.cond.get());
+    Count(expr.then.get());
+    Count(expr.otherwise.get());
+  }
+  void Visit(IndexAccess& expr) override {
+    Count(expr.object.get());
+    Count(expr.index.get());
+  }
+  void Visit(IndexAssign& expr) override {
+    Count(expr.target.get());
+    Count(expr.value.get());
+  }
+  void Visit(ArrayLiteral& expr) override {
+    for (const auto& element : expr.elements) {
+      Count(element.get());
+    }
+  }
+  void Visit(NewArray& expr) override { Count(expr.length.get()); }
+  void Visit(Cast& expr) override { Count(expr.value.get()); }
+  void Visit(IntrinsicCall& expr) override {
+    for (const auto& arg : expr.args) {
+      Count(arg.get());
+    }
+  }
+  void Visit(SliceExpr& expr) override {
+    Count(expr.object.get());
+    Count(expr.start.get());
+    Count(expr.end.get());
+  }
+
+  void Visit(ExpressionStmt& stmt) override { Count(stmt.expr.get()); }
+  void Visit(FunctionStmt& stmt) override {
+    Count(stmt.proto.get());
+    Count(stmt.body);
+  }
+  void Visit(ReturnStmt& stmt) override { Count(stmt.value.get()); }
+  void Visit(VarDeclarationStmt& stmt) override { Count(stmt.value.get()); }
+  void Visit(FunctionProto& stmt) override {}
+  void Visit(ModuleStmt& stmt) override { Count(stmt.stmts); }
+  void Visit(IfStmt& stmt) override {
+    Count(stmt.cond.get());
+    Count(stmt.then.get());
+    Count(stmt.otherwise.get());
+  }
+  void Visit(ForStmt& stmt) override {
+    Count(stmt.initializer.get());
+    Count(stmt.condition.get());
+    Count(stmt.step.get());
+    Count(stmt.body);
+  }
+  void Visit(WhileStmt& stmt) override {
+    Count(stmt.condition.get());
+    Count(stmt.body);
+  }
+  void Visit(MatchStmt& stmt) override {
+    Count(stmt.subject.get());
+    for (MatchArm& arm : stmt.arms) {
+      for (MatchPattern& pattern : arm.patterns) {
+        Count(pattern.low.get());
+        Count(pattern.high.get());
+      }
+      Count(arm.body);
+    }
+    Count(stmt.otherwise);
+  }
+  void Visit(ImportStmt& stmt) override {}
+  void Visit(StructStmt& stmt) override {}
+};
+
+uint64_t PeakRSSBytes() {
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+  return 0;
+#endif
+}
+
+void PrintIRCounts(llvm::raw_ostream& os, llvm::StringRef label,
+                   const CompileStats::IRCounts& counts) {
+  os << llvm::formatv("  {0,-26}{1,12}\n", label.str() + " functions",
+                      counts.functions);
+  os << llvm::formatv("  {0,-26}{1,12}\n", label.str() + " basic blocks",
+                      counts.basic_blocks);
+  os << llvm::formatv("  {0,-26}{1,12}\n", label.str() + " instructions",
+                      counts.instructions);
+}
+
+llvm::json::Object IRCountsToJSON(const CompileStats::IRCounts& counts) {
+  return llvm::json::Object{{"functions", counts.functions},
+                            {"basic_blocks", counts.basic_blocks},
+                            {"instructions", counts.instructions}};
+}
+
+llvm::json::Object CountsToJSON(const std::map<std::string, uint64_t>& counts) {
+  llvm::json::Object out;
+  for (const auto& [name, count] : counts) {
+    out[name] = count;
+  }
+  return out;
+}
+
+}  // namespace
+
+void CompileStats::Enable(bool enabled) {
+  stats_enabled = enabled;
+}
+
+bool CompileStats::Enabled() {
+  return stats_enabled;
+}
+
+CompileStats& CompileStats::Global() {
+  static CompileStats stats;
+  return stats;
+}
+
+void CompileStats::Reset() {
+  *this = CompileStats{};
+}
+
+void CompileStats::AddTokens(uint64_t count) {
+  if (!stats_enabled) {
+    return;
+  }
+  tokens += count;
+}
+
+void CompileStats::CountAst(const std::vector<ModuleStmt*>& modules) {
+  if (!stats_enabled) {
+    return;
+  }
+  AstCounter counter{*this};
+  for (ModuleStmt* mod : modules) {
+    counter.Count(mod);
+  }
+}
+
+void CompileStats::RecordSemantic(uint64_t symbol_count,
+                                  uint64_t function_type_count,
+                                  uint64_t struct_type_count) {
+  if (!stats_enabled) {
+    return;
+  }
+  symbols = symbol_count;
+  function_types = function_type_count;
+  struct_types = struct_type_count;
+}
+
+void CompileStats::RecordIR(const llvm::Module& mod, bool optimized) {
+  if (!stats_enabled) {
+    return;
+  }
+  IRCounts counts;
+  for (const llvm::Function& func : mod) {
+    if (func.isDeclaration()) {
+      continue;
+    }
+    ++counts.functions;
+    for (const llvm::BasicBlock& block : func) {
+      ++counts.basic_blocks;
+      counts.instructions += block.size();
+    }
+  }
+  (optimized ? ir_after_opt : ir_before_opt) = counts;
+}
+
+void CompileStats::RecordPhase(llvm::StringRef phase) {
+  if (!stats_enabled) {
+    return;
+  }
+  memory.push_back({phase.str(), PeakRSSBytes()});
+}
+
+void CompileStats::Print(llvm::raw_ostream& os) const {
+  os << "===-------------------------------------------------------------===\n"
+     << "                 Cinder compilation statistics\n"
+     << "===-------------------------------------------------------------===\n";
+  os << llvm::formatv("  {0,-26}{1,12}\n", "tokens", tokens);
+  os << "AST expressions:\n";
+  for (const auto& [name, count] : expr_counts) {
+    os << llvm::formatv("  {0,-26}{1,12}\n", name, count);
+  }
+  os << "AST statements:\n";
+  for (const auto& [name, count] : stmt_counts) {
+    os << llvm::formatv("  {0,-26}{1,12}\n", name, count);
+  }
+  os << "Semantic:\n";
+  os << llvm::formatv("  {0,-26}{1,12}\n", "symbols", symbols);
+  os << llvm::formatv("  {0,-26}{1,12}\n", "function types", function_types);
+  os << llvm::formatv("  {0,-26}{1,12}\n", "struct types", struct_types);
+  os << "LLVM IR:\n";
+  PrintIRCounts(os, "pre-opt", ir_before_opt);
+  PrintIRCounts(os, "post-opt", ir_after_opt);
+  os << "Peak RSS (KiB):\n";
+  for (const auto& entry : memory) {
+    os << llvm::formatv("  {0,-26}{1,12}\n", entry.phase,
+                        entry.peak_rss_bytes / 1024);
+  }
+}
+
+void CompileStats::PrintJSON(llvm::raw_ostream& os) const {
+  llvm::json::Array phases;
+  for (const auto& entry : memory) {
+    phases.push_back(llvm::json::Object{
+        {"phase", entry.phase}, {"peak_rss_bytes", entry.peak_rss_bytes}});
+  }
+
+  llvm::json::Value root = llvm::json::Object{
+      {"tokens", tokens},
+      {"ast", llvm::json::Object{{"expr", CountsToJSON(expr_counts)},
+                                 {"stmt", CountsToJSON(stmt_counts)}}},
+      {"symbols", symbols},
+      {"types", llvm::json::Object{{"function", function_types},
+                                   {"struct", struct_types}}},
+      {"ir", llvm::json::Object{{"before_opt", IRCountsToJSON(ir_before_opt)},
+                                {"after_opt", IRCountsToJSON(ir_after_opt)}}},
+      {"memory", std::move(phases)},
+  };
+  os << llvm::formatv("{0:2}", root) << "\n";
+}
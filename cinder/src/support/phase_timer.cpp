@@ -0,0 +1,26 @@
+#include "cinder/support/phase_timer.hpp"
+
+#include "llvm/Support/raw_ostream.h"
+
+static bool phase_timing_enabled = false;
+
+PhaseTimer::PhaseTimer(llvm::StringRef name, llvm::StringRef description,
+                       llvm::StringRef detail)
+    : trace_(description, detail),
+      timer_(name, description, "cinder", "Cinder compilation phases",
+             phase_timing_enabled) {}
+
+void PhaseTimer::Enable(bool enabled) {
+  phase_timing_enabled = enabled;
+}
+
+bool PhaseTimer::Enabled() {
+  return phase_timing_enabled;
+}
+
+void PhaseTimer::Report() {
+  if (!phase_timing_enabled) {
+    return;
+  }
+  llvm::TimerGroup::printAll(llvm::errs());
+}
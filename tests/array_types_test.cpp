@@ -0,0 +1,221 @@
+#include <memory>
+#include <string>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+bool AnalyzeSource(const std::string& source) {
+  auto mod = ParseModuleFromSource(source);
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  return !analyzer.HadError();
+}
+
+}  // namespace
+
+TEST(ArrayTypesTest, ParsesArrayAndSliceTypeSuffixes) {
+  auto module = ParseModuleFromSource(R"(
+mod main;
+def sum(int32[] xs) -> int32
+  int32[4][2]: grid = [[1, 2], [3, 4], [5, 6], [7, 8]];
+  return xs[0];
+end
+)");
+
+  ASSERT_EQ(module->stmts.size(), 1u);
+
+  auto* fn = dynamic_cast<FunctionStmt*>(module->stmts[0].get());
+  ASSERT_NE(fn, nullptr);
+
+  std::error_code ec;
+  auto* proto = fn->proto->CastTo<FunctionProto>(ec);
+  ASSERT_EQ(ec.value(), 0);
+  ASSERT_EQ(proto->args.size(), 1u);
+  EXPECT_EQ(proto->args[0].type_token.lexeme, "int32[]");
+
+  auto* decl = dynamic_cast<VarDeclarationStmt*>(fn->body[0].get());
+  ASSERT_NE(decl, nullptr);
+  EXPECT_EQ(decl->type.kind, cinder::Token::Type::INT32_SPECIFIER);
+  EXPECT_EQ(decl->type.lexeme, "int32[4][2]");
+  EXPECT_TRUE(decl->value->IsArrayLiteral());
+}
+
+TEST(ArrayTypesTest, ParsesIndexAssignment) {
+  auto module = ParseModuleFromSource(R"(
+mod main;
+def main() -> int32
+  int32[]: xs = new int32[8];
+  xs[1] = xs[0] + 1;
+  return 0;
+end
+)");
+
+  auto* fn = dynamic_cast<FunctionStmt*>(module->stmts[0].get());
+  ASSERT_NE(fn, nullptr);
+  ASSERT_EQ(fn->body.size(), 3u);
+
+  auto* decl = dynamic_cast<VarDeclarationStmt*>(fn->body[0].get());
+  ASSERT_NE(decl, nullptr);
+  EXPECT_TRUE(decl->value->IsNewArray());
+
+  auto* stmt = dynamic_cast<ExpressionStmt*>(fn->body[1].get());
+  ASSERT_NE(stmt, nullptr);
+  EXPECT_TRUE(stmt->expr->IsIndexAssign());
+}
+
+TEST(ArrayTypesTest, AcceptsArraysSlicesAndLength) {
+  EXPECT_TRUE(AnalyzeSource(R"(
+mod main;
+
+def sum(int32[] xs) -> int32
+  int32: total = 0;
+  for int32: i = 0; i < xs.len; ++i
+    total = total + xs[i];
+  end
+  return total;
+end
+
+def main() -> int32
+  int32[4]: fixed = [1, 2, 3, 4];
+  int32[]: heap = new int32[fixed.len];
+  heap[0] = fixed[3];
+  flt32[16]: zeroed = [0.0];
+  return sum(fixed) + sum(heap);
+end
+)"));
+}
+
+TEST(ArrayTypesTest, RejectsNonIntegerIndex) {
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  int32[4]: xs = [1, 2, 3, 4];
+  return xs[1.0];
+end
+)"));
+}
+
+TEST(ArrayTypesTest, RejectsElementTypeMismatch) {
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  int32[]: xs = new int32[4];
+  xs[0] = 2.5;
+  return 0;
+end
+)"));
+}
+
+TEST(ArrayTypesTest, RejectsFixedSizeArrayParameter) {
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def first(int32[4] xs) -> int32
+  return xs[0];
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def first(int32[4] xs) -> int32
+  return 0;
+end
+def main() -> int32
+  int32[4]: xs = [0];
+  return first(xs);
+end
+)"));
+}
+
+TEST(ArrayTypesTest, ParsesSliceBounds) {
+  auto module = ParseModuleFromSource(R"(
+mod main;
+def main() -> int32
+  str: s = "hello";
+  str: head = s[:2];
+  str: mid = s[1:3];
+  str: tail = s[2:];
+  return 0;
+end
+)");
+
+  auto* fn = dynamic_cast<FunctionStmt*>(module->stmts[0].get());
+  ASSERT_NE(fn, nullptr);
+  ASSERT_EQ(fn->body.size(), 5u);
+
+  const bool has_start[] = {false, true, true};
+  const bool has_end[] = {true, true, false};
+  for (size_t i = 0; i < 3; ++i) {
+    auto* decl = dynamic_cast<VarDeclarationStmt*>(fn->body[i + 1].get());
+    ASSERT_NE(decl, nullptr);
+    auto* slice = dynamic_cast<SliceExpr*>(decl->value.get());
+    ASSERT_NE(slice, nullptr);
+    EXPECT_EQ(slice->start != nullptr, has_start[i]);
+    EXPECT_EQ(slice->end != nullptr, has_end[i]);
+  }
+}
+
+TEST(ArrayTypesTest, AcceptsStringAndArraySlices) {
+  EXPECT_TRUE(AnalyzeSource(R"(
+mod main;
+
+extern puts(str s) -> int32
+
+def main() -> int32
+  str: s = "hello, world";
+  puts(s[7:s.len]);
+  int32[4]: fixed = [1, 2, 3, 4];
+  int32[]: rest = fixed[1:];
+  int32[]: inner = rest[:2];
+  return inner.len;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  str: s = "hello";
+  str: bad = s[0.5:];
+  return 0;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  int32: n = 4;
+  int32: bad = n[1:2];
+  return 0;
+end
+)"));  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+const int32[4]: TABLE = [1, 2, 3, 4];
+
+def main() -> int32
+  int32[]: head = TABLE[0:2];
+  head[0] = 9;
+  return 0;
+end
+)"));
+}
@@ -0,0 +1,201 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/bounds_check.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+std::unique_ptr<ModuleStmt> AnalyzeBounds(const std::string& source) {
+  auto mod = ParseModuleFromSource(source);
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  EXPECT_FALSE(analyzer.HadError());
+  BoundsCheckAnalysis bounds;
+  bounds.Run({mod.get()});
+  return mod;
+}
+
+/** @brief Returns the loop that is the `index`-th statement of `fn`. */
+ForStmt* LoopAt(ModuleStmt& mod, size_t fn, size_t index) {
+  auto* func = dynamic_cast<FunctionStmt*>(mod.stmts[fn].get());
+  EXPECT_NE(func, nullptr);
+  return dynamic_cast<ForStmt*>(func->body[index].get());
+}
+
+/** @brief Returns the access in `loop`'s first `x = ...xs[...]` statement. */
+IndexAccess* FirstRead(ForStmt& loop) {
+  auto* stmt = dynamic_cast<ExpressionStmt*>(loop.body[0].get());
+  EXPECT_NE(stmt, nullptr);
+  auto* assign = dynamic_cast<Assign*>(stmt->expr.get());
+  EXPECT_NE(assign, nullptr);
+  auto* sum = dynamic_cast<Binary*>(assign->value.get());
+  EXPECT_NE(sum, nullptr);
+  return dynamic_cast<IndexAccess*>(sum->right.get());
+}
+
+}  // namespace
+
+TEST(BoundsCheckTest, ProvesLoopOverSliceLength) {
+  auto mod = AnalyzeBounds(R"(
+mod main;
+
+def sum(int32[] xs) -> int32
+  int32: t = 0;
+  for int32: i = 0; i < xs.len; ++i
+    t = t + xs[i];
+  end
+  return t;
+end
+)");
+
+  ForStmt* loop = LoopAt(*mod, 0, 1);
+  ASSERT_NE(loop, nullptr);
+  IndexAccess* access = FirstRead(*loop);
+  ASSERT_NE(access, nullptr);
+  EXPECT_EQ(access->bounds, BoundsCheck::Proven);
+}
+
+TEST(BoundsCheckTest, ProvesLiteralBoundWithinArrayLength) {
+  auto mod = AnalyzeBounds(R"(
+mod main;
+
+def main() -> int32
+  int32[8]: xs = [1];
+  int32: t = 0;
+  for int32: i = 0; i < 8; ++i
+    t = t + xs[i];
+  end
+  for int32: i = 0; i < 9; ++i
+    t = t + xs[i];
+  end
+  return t;
+end
+)");
+
+  IndexAccess* within = FirstRead(*LoopAt(*mod, 0, 2));
+  IndexAccess* past = FirstRead(*LoopAt(*mod, 0, 3));
+  ASSERT_NE(within, nullptr);
+  ASSERT_NE(past, nullptr);
+  EXPECT_EQ(within->bounds, BoundsCheck::Proven);
+  EXPECT_EQ(past->bounds, BoundsCheck::Hoisted);
+}
+
+TEST(BoundsCheckTest, HoistsAffineAccessWithInvariantOffset) {
+  auto mod = AnalyzeBounds(R"(
+mod main;
+
+def row(int32[] m, int32 r, int32 n) -> int32
+  int32: t = 0;
+  for int32: j = 0; j < n; ++j
+    t = t + m[r * n + j];
+  end
+  return t;
+end
+)");
+
+  ForStmt* loop = LoopAt(*mod, 0, 1);
+  ASSERT_NE(loop, nullptr);
+  IndexAccess* access = FirstRead(*loop);
+  ASSERT_NE(access, nullptr);
+  EXPECT_EQ(access->bounds, BoundsCheck::Hoisted);
+  EXPECT_NE(access->loop_offset, nullptr);
+  ASSERT_EQ(loop->hoisted_checks.size(), 1u);
+  EXPECT_EQ(loop->hoisted_checks[0], access);
+  EXPECT_NE(loop->range_bound, nullptr);
+}
+
+TEST(BoundsCheckTest, KeepsChecksWhenLoopWritesOperands) {
+  auto mod = AnalyzeBounds(R"(
+mod main;
+
+def shrink(int32[] xs, int32 n) -> int32
+  int32: t = 0;
+  int32: k = 0;
+  for int32: i = 0; i < xs.len; ++i
+    t = t + xs[i + k];
+    k = k + 1;
+  end
+  int32[]: ys = xs;
+  for int32: i = 0; i < ys.len; ++i
+    t = t + ys[i];
+    ys = new int32[1];
+  end
+  return t;
+end
+)");
+
+  IndexAccess* moving_offset = FirstRead(*LoopAt(*mod, 0, 2));
+  IndexAccess* reassigned = FirstRead(*LoopAt(*mod, 0, 4));
+  ASSERT_NE(moving_offset, nullptr);
+  ASSERT_NE(reassigned, nullptr);
+  EXPECT_EQ(moving_offset->bounds, BoundsCheck::Required);
+  EXPECT_EQ(reassigned->bounds, BoundsCheck::Required);
+}
+
+TEST(BoundsCheckTest, DoesNotHoistConditionalAccess) {
+  auto mod = AnalyzeBounds(R"(
+mod main;
+
+def pick(int32[] xs, int32 n) -> int32
+  int32: t = 0;
+  for int32: i = 0; i < n; ++i
+    if i < 4
+      t = t + xs[i];
+    end
+  end
+  return t;
+end
+)");
+
+  ForStmt* loop = LoopAt(*mod, 0, 1);
+  ASSERT_NE(loop, nullptr);
+  EXPECT_TRUE(loop->hoisted_checks.empty());
+}
+
+TEST(BoundsCheckTest, MutableGlobalsAreNotLoopInvariant) {
+  auto mod = AnalyzeBounds(R"(
+mod main;
+
+int32: limit = 4;
+const int32: WIDTH = 4;
+
+def sum(int32[] xs) -> int32
+  int32: t = 0;
+  for int32: i = 0; i < limit; ++i
+    t = t + xs[i];
+  end
+  int32[4]: row = [1, 2, 3, 4];
+  for int32: i = 0; i < WIDTH; ++i
+    t = t + row[i];
+  end
+  return t;
+end
+)");
+
+  ForStmt* global_bound = LoopAt(*mod, 2, 1);
+  ForStmt* const_bound = LoopAt(*mod, 2, 3);
+  ASSERT_NE(global_bound, nullptr);
+  ASSERT_NE(const_bound, nullptr);
+  EXPECT_EQ(FirstRead(*global_bound)->bounds, BoundsCheck::Required);
+  EXPECT_TRUE(global_bound->hoisted_checks.empty());
+  EXPECT_EQ(FirstRead(*const_bound)->bounds, BoundsCheck::Proven);
+}
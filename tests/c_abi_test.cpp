@@ -0,0 +1,79 @@
+#include <vector>
+
+#include "cinder/codegen/c_abi.hpp"
+#include "gtest/gtest.h"
+#include "llvm/IR/DataLayout.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/LLVMContext.h"
+
+namespace {
+
+constexpr const char* kX86Layout =
+    "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:"
+    "64-S128";
+constexpr const char* kAArch64Layout =
+    "e-m:e-i8:8:32-i16:16:32-i64:64-i128:128-n32:64-S128";
+
+/** @brief Classifies `params` returning `ret` on `triple`. */
+CAbiSignature Classify(const char* triple, const char* layout,
+                       llvm::Type* ret, std::vector<llvm::Type*> params) {
+  llvm::DataLayout data_layout(layout);
+  CAbi abi{llvm::Triple(triple), data_layout};
+  return abi.Classify(ret, params);
+}
+
+}  // namespace
+
+TEST(CAbiTest, CoercesSmallSysVStructsToRegisterPieces) {
+  llvm::LLVMContext ctx;
+  llvm::Type* f32 = llvm::Type::getFloatTy(ctx);
+  llvm::Type* f64 = llvm::Type::getDoubleTy(ctx);
+  llvm::Type* i32 = llvm::Type::getInt32Ty(ctx);
+  auto* vec3 = llvm::StructType::get(ctx, {f32, f32, f32});
+  auto* mixed = llvm::StructType::get(ctx, {i32, f64});
+
+  CAbiSignature sig =
+      Classify("x86_64-pc-linux-gnu", kX86Layout, vec3, {vec3, mixed});
+  ASSERT_EQ(sig.ret.kind, CAbiArg::Kind::Coerce);
+  EXPECT_EQ(sig.ret.type,
+            llvm::StructType::get(
+                ctx, {llvm::FixedVectorType::get(f32, 2), f32}));
+  ASSERT_EQ(sig.params[1].kind, CAbiArg::Kind::Coerce);
+  EXPECT_EQ(sig.params[1].type,
+            llvm::StructType::get(ctx, {llvm::Type::getInt64Ty(ctx), f64}));
+}
+
+TEST(CAbiTest, PassesLargeOrSpilledSysVStructsInMemory) {
+  llvm::LLVMContext ctx;
+  llvm::Type* i64 = llvm::Type::getInt64Ty(ctx);
+  auto* pair = llvm::StructType::get(ctx, {i64, i64});
+  auto* big = llvm::StructType::get(ctx, {i64, i64, i64});
+
+  CAbiSignature sig = Classify("x86_64-pc-linux-gnu", kX86Layout, big,
+                               {big, i64, i64, i64, i64, pair, pair});
+  EXPECT_EQ(sig.ret.kind, CAbiArg::Kind::Indirect);
+  EXPECT_EQ(sig.params[0].kind, CAbiArg::Kind::Indirect);
+  EXPECT_TRUE(sig.params[0].byval);
+  EXPECT_EQ(sig.params[1].kind, CAbiArg::Kind::Direct);
+  // `sret` and four integers leave one register, too few for a pair.
+  EXPECT_EQ(sig.params[5].kind, CAbiArg::Kind::Indirect);
+  EXPECT_EQ(sig.params[6].kind, CAbiArg::Kind::Indirect);
+}
+
+TEST(CAbiTest, ClassifiesAArch64HomogeneousAndIndirectAggregates) {
+  llvm::LLVMContext ctx;
+  llvm::Type* f64 = llvm::Type::getDoubleTy(ctx);
+  llvm::Type* i8 = llvm::Type::getInt8Ty(ctx);
+  auto* complex = llvm::StructType::get(ctx, {f64, f64});
+  auto* tiny = llvm::StructType::get(ctx, {i8, i8, i8});
+  auto* big = llvm::StructType::get(ctx, {f64, f64, f64, f64, f64});
+
+  CAbiSignature sig = Classify("aarch64-linux-gnu", kAArch64Layout, complex,
+                               {tiny, big});
+  ASSERT_EQ(sig.ret.kind, CAbiArg::Kind::Coerce);
+  EXPECT_EQ(sig.ret.type, llvm::ArrayType::get(f64, 2));
+  ASSERT_EQ(sig.params[0].kind, CAbiArg::Kind::Coerce);
+  EXPECT_EQ(sig.params[0].type, llvm::Type::getInt64Ty(ctx));
+  EXPECT_EQ(sig.params[1].kind, CAbiArg::Kind::Indirect);
+  EXPECT_FALSE(sig.params[1].byval);
+}
@@ -0,0 +1,52 @@
+#include "cinder/codegen/codegen_context.hpp"
+
+#include "gtest/gtest.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Module.h"
+
+TEST(CodegenContextTest, ReusesMatchingPublicDeclarations) {
+  CodegenContext ctx("test");
+  llvm::LLVMContext& llvm_ctx = ctx.GetContext();
+  llvm::Type* ptr = llvm::PointerType::getUnqual(llvm_ctx);
+  auto* strlen_type = llvm::FunctionType::get(
+      llvm::Type::getInt64Ty(llvm_ctx), {ptr}, false);
+
+  llvm::Function* first = ctx.CreatePublicFunc(strlen_type, "strlen");
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(ctx.CreatePublicFunc(strlen_type, "strlen"), first);
+  EXPECT_EQ(ctx.GetModule().getFunction("strlen"), first);
+}
+
+TEST(CodegenContextTest, RejectsConflictingPublicDeclarations) {
+  CodegenContext ctx("test");
+  llvm::LLVMContext& llvm_ctx = ctx.GetContext();
+  llvm::Type* ptr = llvm::PointerType::getUnqual(llvm_ctx);
+  llvm::Type* i32 = llvm::Type::getInt32Ty(llvm_ctx);
+  auto* runtime_type = llvm::FunctionType::get(
+      llvm::Type::getInt64Ty(llvm_ctx), {ptr}, false);
+  auto* user_type = llvm::FunctionType::get(i32, {ptr}, false);
+
+  llvm::Function* runtime = ctx.CreatePublicFunc(runtime_type, "strlen");
+  ASSERT_NE(runtime, nullptr);
+  EXPECT_EQ(ctx.CreatePublicFunc(user_type, "strlen"), nullptr);
+  EXPECT_EQ(ctx.GetModule().getFunction("strlen"), runtime);
+}
+
+TEST(CodegenContextTest, KeepsCSymbolsFreeOfInternalFunctions) {
+  CodegenContext ctx("test");
+  llvm::LLVMContext& llvm_ctx = ctx.GetContext();
+  auto* void_type =
+      llvm::FunctionType::get(llvm::Type::getVoidTy(llvm_ctx), false);
+  auto* int_type =
+      llvm::FunctionType::get(llvm::Type::getInt32Ty(llvm_ctx), false);
+
+  // A cinder `def abort()` is module-qualified, so the runtime's C `abort`
+  // declares cleanly whatever its prototype.
+  llvm::Function* internal = ctx.CreateInternalFunc(int_type, "main.abort");
+  llvm::Function* runtime = ctx.CreatePublicFunc(void_type, "abort");
+  ASSERT_NE(runtime, nullptr);
+  EXPECT_NE(runtime, internal);
+  EXPECT_TRUE(internal->hasLocalLinkage());
+  EXPECT_EQ(ctx.GetModule().getFunction("main.abort"), internal);
+}
@@ -0,0 +1,115 @@
+#include "cinder/support/compile_stats.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+class CompileStatsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    CompileStats::Enable(true);
+    CompileStats::Global().Reset();
+  }
+
+  void TearDown() override {
+    CompileStats::Global().Reset();
+    CompileStats::Enable(false);
+  }
+};
+
+}  // namespace
+
+TEST_F(CompileStatsTest, CountsAstNodesByType) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+
+def add(int32 a, int32 b) -> int32
+  return a + b;
+end
+
+def main() -> int32
+  int32: x = add(1, 2);
+  return x;
+end
+)");
+
+  CompileStats::Global().CountAst({mod.get()});
+  const CompileStats& stats = CompileStats::Global();
+
+  EXPECT_EQ(stats.stmt_counts.at("Module"), 1u);
+  EXPECT_EQ(stats.stmt_counts.at("Function"), 2u);
+  EXPECT_EQ(stats.stmt_counts.at("FunctionProto"), 2u);
+  EXPECT_EQ(stats.stmt_counts.at("Return"), 2u);
+  EXPECT_EQ(stats.stmt_counts.at("VarDeclaration"), 1u);
+  EXPECT_EQ(stats.expr_counts.at("Binary"), 1u);
+  EXPECT_EQ(stats.expr_counts.at("Call"), 1u);
+  EXPECT_EQ(stats.expr_counts.at("Literal"), 2u);
+  EXPECT_EQ(stats.expr_counts.at("Variable"), 4u);
+}
+
+TEST_F(CompileStatsTest, IgnoresRecordsWhileDisabled) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+
+def main() -> int32
+  return 0;
+end
+)");
+
+  CompileStats::Enable(false);
+  CompileStats::Global().AddTokens(10);
+  CompileStats::Global().CountAst({mod.get()});
+
+  EXPECT_EQ(CompileStats::Global().tokens, 0u);
+  EXPECT_TRUE(CompileStats::Global().stmt_counts.empty());
+}
+
+TEST_F(CompileStatsTest, RecordsSemanticTableSizes) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+
+struct Point
+  int32: x;
+  int32: y;
+end
+
+def main() -> int32
+  int32: x = 1;
+  return x;
+end
+)");
+
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  ASSERT_FALSE(analyzer.HadError());
+
+  CompileStats::Global().RecordSemantic(analyzer.SymbolCount(),
+                                        types.FunctionTypeCount(),
+                                        types.StructTypeCount());
+  const CompileStats& stats = CompileStats::Global();
+
+  EXPECT_GE(stats.symbols, 2u);
+  EXPECT_EQ(stats.struct_types, 1u);
+  EXPECT_GE(stats.function_types, 1u);
+}
@@ -0,0 +1,330 @@
+#include <memory>
+#include <string>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+bool AnalyzeSource(const std::string& source) {
+  auto mod = ParseModuleFromSource(source);
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  return !analyzer.HadError();
+}
+
+/** @brief Returns the initializer of the `index`-th statement of `fn`. */
+Expr* InitializerAt(ModuleStmt& mod, size_t fn, size_t index) {
+  auto* func = dynamic_cast<FunctionStmt*>(mod.stmts[fn].get());
+  EXPECT_NE(func, nullptr);
+  auto* decl = dynamic_cast<VarDeclarationStmt*>(func->body[index].get());
+  EXPECT_NE(decl, nullptr);
+  return decl ? decl->value.get() : nullptr;
+}
+
+}  // namespace
+
+TEST(ConstEvaluatorTest, FoldsConstantsThroughArithmetic) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+
+def main() -> int32
+  const int32: width = 4;
+  const int64: area = width * (width + 2);
+  flt32: half = flt32(area) / 2.0;
+  bool: wide = area > 20;
+  uint8: wrapped = uint8(area * 11);
+  int32: x = width;
+  int32: y = x + 1;
+  return 0;
+end
+)");
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  ASSERT_FALSE(analyzer.HadError());
+
+  Expr* area = InitializerAt(*mod, 0, 1);
+  ASSERT_TRUE(area->constant.has_value());
+  EXPECT_EQ(std::get<int64_t>(*area->constant), 24);
+  Expr* half = InitializerAt(*mod, 0, 2);
+  ASSERT_TRUE(half->constant.has_value());
+  EXPECT_EQ(std::get<double>(*half->constant), 12.0);
+  Expr* wide = InitializerAt(*mod, 0, 3);
+  ASSERT_TRUE(wide->constant.has_value());
+  EXPECT_TRUE(std::get<bool>(*wide->constant));
+  Expr* wrapped = InitializerAt(*mod, 0, 4);
+  ASSERT_TRUE(wrapped->constant.has_value());
+  EXPECT_EQ(std::get<int64_t>(*wrapped->constant), 264 % 256);
+  // Plain variables are not constants, even with a constant initializer.
+  EXPECT_FALSE(InitializerAt(*mod, 0, 6)->constant.has_value());
+}
+
+TEST(ConstEvaluatorTest, EvaluatesPureCallsWithConstantArguments) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+
+extern puts(str s) -> int32
+
+def main() -> int32
+  const int32: f = fib(10);
+  const int64: s = sum_to(100);
+  int32: n = 10;
+  int32: runtime = fib(n);
+  int32: io = noisy(1);
+  return 0;
+end
+
+def fib(int32 n) -> int32
+  if n < 2 return n; end
+  return fib(n - 1) + fib(n - 2);
+end
+
+def sum_to(int64 n) -> int64
+  int64: total = 0;
+  for int64: i = 1; i <= n; ++i
+    total = total + i;
+  end
+  return total;
+end
+
+def noisy(int32 x) -> int32
+  puts("side effect");
+  return x;
+end
+)");
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  ASSERT_FALSE(analyzer.HadError());
+
+  Expr* f = InitializerAt(*mod, 1, 0);
+  ASSERT_TRUE(f->constant.has_value());
+  EXPECT_EQ(std::get<int64_t>(*f->constant), 55);
+  Expr* s = InitializerAt(*mod, 1, 1);
+  ASSERT_TRUE(s->constant.has_value());
+  EXPECT_EQ(std::get<int64_t>(*s->constant), 5050);
+  EXPECT_FALSE(InitializerAt(*mod, 1, 3)->constant.has_value());
+  EXPECT_FALSE(InitializerAt(*mod, 1, 4)->constant.has_value());
+}
+
+TEST(ConstEvaluatorTest, RejectsNonConstantsAndReassignment) {
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  int32: n = 3;
+  const int32: twice = n * 2;
+  return twice;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  const int32: n = 3;
+  n = 4;
+  ++n;
+  return n;
+end
+)"));
+  // Signed overflow is poison at runtime, so it never folds.
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  const int32: big = 2147483647 + 1;
+  return 0;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  const int32[2]: pair = [1, 2];
+  return 0;
+end
+)"));
+}
+
+TEST(ConstEvaluatorTest, AcceptsStaticGlobalInitializers) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+
+struct Point
+  int32: x;
+  int32: y;
+end
+
+const int32: SIZE = 4;
+const int32[8]: SQUARES = [0, 1, 4, 9];
+const Point: ORIGIN = Point(SIZE, SIZE * 2);
+flt64: scale = 1.5;
+
+def main() -> int32
+  const int32: area = SIZE * SIZE;
+  scale = scale * 2.0;
+  return SQUARES[2];
+end
+)");
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  ASSERT_FALSE(analyzer.HadError());
+
+  auto* size = dynamic_cast<VarDeclarationStmt*>(mod->stmts[1].get());
+  ASSERT_NE(size, nullptr);
+  EXPECT_TRUE(size->is_global);
+  Expr* area = InitializerAt(*mod, 5, 0);
+  ASSERT_TRUE(area->constant.has_value());
+  EXPECT_EQ(std::get<int64_t>(*area->constant), 16);
+}
+
+TEST(ConstEvaluatorTest, RejectsRuntimeGlobalInitializers) {
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+extern rand() -> int32
+
+int32: seed = rand();
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+int32: a = 1;
+int32: b = a;
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+const int32[2]: PAIR = [1, 2];
+
+def main() -> int32
+  PAIR[0] = 3;
+  return 0;
+end
+)"));
+}
+
+TEST(ConstEvaluatorTest, RejectsSlicesOfConstantArrays) {
+  EXPECT_TRUE(AnalyzeSource(R"(
+mod main;
+
+int32[4]: counts = [0];
+const int32[4]: TABLE = [1, 2, 3, 4];
+
+def sum(int32[] xs) -> int32
+  return xs[0];
+end
+
+def main() -> int32
+  int32[]: view = counts;
+  view[0] = TABLE[1];
+  return sum(counts);
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+const int32[4]: TABLE = [1, 2, 3, 4];
+
+def main() -> int32
+  int32[]: view = TABLE;
+  view[0] = 9;
+  return 0;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+const int32[4]: TABLE = [1, 2, 3, 4];
+
+def sum(int32[] xs) -> int32
+  return xs[0];
+end
+
+def main() -> int32
+  return sum(TABLE);
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+const int32[2][2]: GRID = [[1, 2], [3, 4]];
+
+def main() -> int32
+  int32[4]: scratch = [0];
+  int32[]: row = scratch;
+  row = GRID[1];
+  return 0;
+end
+)"));
+}
+
+TEST(ConstEvaluatorTest, RejectsWritesThroughConstantFields) {
+  EXPECT_TRUE(AnalyzeSource(R"(
+mod main;
+
+struct Table
+  int32[4]: xs;
+  int32: n;
+end
+
+Table: scratch = Table([0, 0, 0, 0], 4);
+
+def main() -> int32
+  scratch.xs[0] = 9;
+  return 0;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+struct Table
+  int32[4]: xs;
+  int32: n;
+end
+
+const Table: T = Table([1, 2, 3, 4], 4);
+
+def main() -> int32
+  T.xs[0] = 9;
+  return 0;
+end
+)"));
+
+  auto tables = ParseModuleFromSource(R"(
+mod tables;
+
+const int32[4]: SQUARES = [0, 1, 4, 9];
+)");
+  auto main = ParseModuleFromSource(R"(
+mod main;
+import tables;
+
+def main() -> int32
+  tables.SQUARES[0] = 9;
+  return 0;
+end
+)");
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({tables.get(), main.get()});
+  EXPECT_TRUE(analyzer.HadError());
+}
@@ -0,0 +1,122 @@
+#include <memory>
+#include <string>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+bool AnalyzeSource(const std::string& source) {
+  auto mod = ParseModuleFromSource(source);
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  return !analyzer.HadError();
+}
+
+}  // namespace
+
+TEST(FunctionAttributesTest, ParsesExternEffects) {
+  auto module = ParseModuleFromSource(R"(
+mod main;
+extern const hypot(flt64 x, flt64 y) -> flt64
+extern pure strlen(str s) -> int64
+extern puts(str s) -> int32
+)");
+
+  ASSERT_EQ(module->stmts.size(), 3u);
+  auto* hypot = dynamic_cast<FunctionProto*>(module->stmts[0].get());
+  auto* strlen = dynamic_cast<FunctionProto*>(module->stmts[1].get());
+  auto* puts = dynamic_cast<FunctionProto*>(module->stmts[2].get());
+  ASSERT_NE(hypot, nullptr);
+  ASSERT_NE(strlen, nullptr);
+  ASSERT_NE(puts, nullptr);
+  EXPECT_EQ(hypot->effects, ExternEffects::Const);
+  EXPECT_EQ(strlen->effects, ExternEffects::Pure);
+  EXPECT_EQ(puts->effects, ExternEffects::None);
+  EXPECT_TRUE(hypot->is_extern);
+}
+
+TEST(FunctionAttributesTest, RejectsConstExternReadingThroughPointers) {
+  EXPECT_TRUE(AnalyzeSource(R"(
+mod main;
+extern pure strlen(str s) -> int64
+extern const hypot(flt64 x, flt64 y) -> flt64
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+extern const strlen(str s) -> int64
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+extern const frexp(flt64 x, ptr int32 e) -> flt64
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+struct View
+  int32[]: data;
+end
+extern const first(View v) -> int32
+)"));
+}
+
+TEST(FunctionAttributesTest, ParsesDefAnnotations) {
+  auto module = ParseModuleFromSource(R"(
+mod main;
+extern @cold abort() -> void
+def @always_inline @hot step(int32 x) -> int32
+  return x + 1;
+end
+def @noinline fail() -> void
+  abort();
+end
+def @inline plain(int32 x) -> int32
+  return x;
+end
+)");
+
+  ASSERT_EQ(module->stmts.size(), 4u);
+  auto* abort = dynamic_cast<FunctionProto*>(module->stmts[0].get());
+  ASSERT_NE(abort, nullptr);
+  EXPECT_EQ(abort->frequency, CallFrequency::Cold);
+
+  auto proto_at = [&](size_t index) {
+    auto* fn = dynamic_cast<FunctionStmt*>(module->stmts[index].get());
+    EXPECT_NE(fn, nullptr);
+    return dynamic_cast<FunctionProto*>(fn->proto.get());
+  };
+  FunctionProto* step = proto_at(1);
+  ASSERT_NE(step, nullptr);
+  EXPECT_EQ(step->name.lexeme, "step");
+  EXPECT_EQ(step->inline_policy, InlinePolicy::Always);
+  EXPECT_EQ(step->frequency, CallFrequency::Hot);
+  EXPECT_EQ(proto_at(2)->inline_policy, InlinePolicy::Never);
+  EXPECT_EQ(proto_at(2)->frequency, CallFrequency::Default);
+  EXPECT_EQ(proto_at(3)->inline_policy, InlinePolicy::Hint);
+}
+
+TEST(FunctionAttributesTest, RejectsInliningExterns) {
+  EXPECT_TRUE(AnalyzeSource(R"(
+mod main;
+extern @noinline @cold abort() -> void
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+extern @inline abs(int32 x) -> int32
+)"));
+}
@@ -0,0 +1,206 @@
+#include <memory>
+#include <string>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+bool AnalyzeSource(const std::string& source) {
+  auto mod = ParseModuleFromSource(source);
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  return !analyzer.HadError();
+}
+
+}  // namespace
+
+TEST(IntegerTypesTest, AcceptsEveryWidthAndSignedness) {
+  EXPECT_TRUE(AnalyzeSource(R"(
+mod main;
+
+def mix(int8 a, int16 b, int64 c, uint8 d, uint16 e, uint32 f,
+        uint64 g) -> int64
+  return c;
+end
+
+def main() -> int32
+  int8: a = 127;
+  int16: b = 32767;
+  uint8: d = 255;
+  uint64: g = 18446744073709551615;
+  int64: wide = mix(a, b, 3000000000, d, 65535, 4000000000, g);
+  return 0;
+end
+)"));
+}
+
+TEST(IntegerTypesTest, TypesLiteralsByValue) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+
+def main() -> int32
+  int64: a = 3000000000;
+  uint64: b = 18446744073709551615;
+  uint8: c = 200;
+  return 0;
+end
+)");
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  ASSERT_FALSE(analyzer.HadError());
+
+  auto* fn = dynamic_cast<FunctionStmt*>(mod->stmts[0].get());
+  ASSERT_NE(fn, nullptr);
+  auto value_type = [&](size_t i) {
+    auto* decl = dynamic_cast<VarDeclarationStmt*>(fn->body[i].get());
+    return decl ? decl->value->type : nullptr;
+  };
+  EXPECT_EQ(value_type(0), types.Int64());
+  EXPECT_EQ(value_type(1), types.UInt64());
+  EXPECT_EQ(value_type(2), types.UInt8());
+}
+
+TEST(IntegerTypesTest, WidensLosslessly) {
+  EXPECT_TRUE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  int8: small = 1;
+  uint16: half = 2;
+  int64: total = small;
+  total = total + half;
+  uint32: count = half;
+  if small < total
+    return 1;
+  end
+  return small;
+end
+)"));
+}
+
+TEST(IntegerTypesTest, RejectsNarrowingAndMixedSignedness) {
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  int64: wide = 1;
+  int32: narrow = wide;
+  return 0;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  uint32: u = 1;
+  int32: s = 2;
+  return s + u;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  uint8: byte = 256;
+  return 0;
+end
+)"));
+}
+
+TEST(IntegerTypesTest, ConvertsExplicitly) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+
+def main() -> int32
+  int64: wide = 5;
+  flt32: ratio = flt32(wide);
+  return int32(wide) + int32(ratio);
+end
+)");
+  auto* fn = dynamic_cast<FunctionStmt*>(mod->stmts[0].get());
+  ASSERT_NE(fn, nullptr);
+  auto* decl = dynamic_cast<VarDeclarationStmt*>(fn->body[1].get());
+  ASSERT_NE(decl, nullptr);
+  EXPECT_TRUE(decl->value->IsCast());
+
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  EXPECT_FALSE(analyzer.HadError());
+}
+
+TEST(IntegerTypesTest, TypesSuffixedAndFloatLiterals) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+
+def main() -> int32
+  flt32: a = 0.5;
+  flt64: b = 0.1;
+  int64: c = 10i64;
+  flt64: d = a * 2.0;
+  return 0;
+end
+)");
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  ASSERT_FALSE(analyzer.HadError());
+
+  auto* fn = dynamic_cast<FunctionStmt*>(mod->stmts[0].get());
+  ASSERT_NE(fn, nullptr);
+  auto value_type = [&](size_t i) {
+    auto* decl = dynamic_cast<VarDeclarationStmt*>(fn->body[i].get());
+    return decl ? decl->value->type : nullptr;
+  };
+  EXPECT_EQ(value_type(0), types.Float32());
+  EXPECT_EQ(value_type(1), types.Float64());
+  EXPECT_EQ(value_type(2), types.Int64());
+  // The literal adapts to `a`, and the product widens on assignment.
+  EXPECT_EQ(value_type(3), types.Float32());
+}
+
+TEST(IntegerTypesTest, SuffixedLiteralsKeepTheirType) {
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  int32: a = 10i64;
+  return 0;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  flt32: a = 1.0f64;
+  return 0;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  flt64: wide = 1.0;
+  flt32: narrow = wide;
+  return 0;
+end
+)"));
+}
@@ -0,0 +1,131 @@
+#include <memory>
+#include <string>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/bounds_check.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+bool AnalyzeSource(const std::string& source) {
+  auto mod = ParseModuleFromSource(source);
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  return !analyzer.HadError();
+}
+
+}  // namespace
+
+TEST(IntrinsicsTest, TypesIntrinsicsByOperand) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+
+def main() -> int32
+  flt32: x = 2.0;
+  flt32: r = @sqrt(x);
+  flt64: y = @fma(x, 2.0, 1.0f64);
+  uint32: bits = 12;
+  uint32: n = @popcount(bits);
+  flt32x4: v = @max(flt32x4(x), 0.5);
+  return @clz(int32(n));
+end
+)");
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  ASSERT_FALSE(analyzer.HadError());
+
+  auto* fn = dynamic_cast<FunctionStmt*>(mod->stmts[0].get());
+  ASSERT_NE(fn, nullptr);
+  auto value_type = [&](size_t i) {
+    auto* decl = dynamic_cast<VarDeclarationStmt*>(fn->body[i].get());
+    return decl ? decl->value->type : nullptr;
+  };
+  EXPECT_EQ(value_type(1), types.Float32());
+  // `x` widens to the widest operand; the bare literal adapts to it.
+  EXPECT_EQ(value_type(2), types.Float64());
+  EXPECT_EQ(value_type(4), types.UInt32());
+  EXPECT_EQ(value_type(5), types.Vector(types.Float32(), 4));
+}
+
+TEST(IntrinsicsTest, RejectsInvalidIntrinsics) {
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  return @frobnicate(1);
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  int32: n = 4;
+  flt32: r = @sqrt(n);
+  return 0;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  return @min(1);
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  int32: n = 4;
+  int32: k = 0;
+  if @expect(n == 4, k == 0)
+    return 1;
+  end
+  @prefetch(n);
+  return 0;
+end
+)"));
+}
+
+TEST(IntrinsicsTest, PrefetchAddressIsNotHoisted) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+
+def sum(int32[] xs) -> int32
+  int32: t = 0;
+  for int32: i = 0; i < xs.len; ++i
+    t = t + xs[i];
+    @prefetch(xs[i + 16]);
+  end
+  return t;
+end
+)");
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  ASSERT_FALSE(analyzer.HadError());
+  BoundsCheckAnalysis bounds;
+  bounds.Run({mod.get()});
+
+  auto* fn = dynamic_cast<FunctionStmt*>(mod->stmts[0].get());
+  ASSERT_NE(fn, nullptr);
+  auto* loop = dynamic_cast<ForStmt*>(fn->body[1].get());
+  ASSERT_NE(loop, nullptr);
+  EXPECT_TRUE(loop->hoisted_checks.empty());
+}
@@ -26,18 +26,33 @@ TEST(LexerTest, LexKeyWords) {
     if
     elif
     else 
+    int8
+    int16
     int32
     int64
+    uint8
+    uint16
+    uint32
+    uint64
     flt32
     flt64
+    flt32x4
+    flt32x8
+    int32x4
+    int32x8
+    boolx4
+    boolx8
     str
     bool
     struct
     for
     while
+    likely
+    unlikely
     return
     void
     extern
+    const
     import
     ...
     )");
@@ -50,18 +65,33 @@ TEST(LexerTest, LexKeyWords) {
       cinder::Token::Type::IF,
       cinder::Token::Type::ELSEIF,
       cinder::Token::Type::ELSE,
+      cinder::Token::Type::INT8_SPECIFIER,
+      cinder::Token::Type::INT16_SPECIFIER,
       cinder::Token::Type::INT32_SPECIFIER,
       cinder::Token::Type::INT64_SPECIFIER,
+      cinder::Token::Type::UINT8_SPECIFIER,
+      cinder::Token::Type::UINT16_SPECIFIER,
+      cinder::Token::Type::UINT32_SPECIFIER,
+      cinder::Token::Type::UINT64_SPECIFIER,
       cinder::Token::Type::FLT32_SPECIFIER,
       cinder::Token::Type::FLT64_SPECIFIER,
+      cinder::Token::Type::FLT32X4_SPECIFIER,
+      cinder::Token::Type::FLT32X8_SPECIFIER,
+      cinder::Token::Type::INT32X4_SPECIFIER,
+      cinder::Token::Type::INT32X8_SPECIFIER,
+      cinder::Token::Type::BOOLX4_SPECIFIER,
+      cinder::Token::Type::BOOLX8_SPECIFIER,
       cinder::Token::Type::STR_SPECIFIER,
       cinder::Token::Type::BOOL_SPECIFIER,
       cinder::Token::Type::STRUCT_SPECIFIER,
       cinder::Token::Type::FOR,
       cinder::Token::Type::WHILE,
+      cinder::Token::Type::LIKELY,
+      cinder::Token::Type::UNLIKELY,
       cinder::Token::Type::RETURN,
       cinder::Token::Type::VOID_SPECIFIER,
       cinder::Token::Type::EXTERN,
+      cinder::Token::Type::CONST,
       cinder::Token::Type::IMPORT,
       cinder::Token::Type::ELLIPSIS,
   };
@@ -69,4 +99,41 @@ TEST(LexerTest, LexKeyWords) {
   for (auto it = toks.size(); it < toks.size(); it++) {
     ASSERT_EQ(toks[it].kind, TYPES[it]);
   }
-}
\ No newline at end of file
+}
+
+TEST(LexerTest, LexIntegerLiteralsUpToUint64) {
+  auto toks = TokenizeFromSource(
+      "7 3000000000 18446744073709551615 18446744073709551616");
+  ASSERT_EQ(toks.size(), 5u);
+
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(toks[i].kind, cinder::Token::Type::INT_LITERAL);
+  }
+  EXPECT_EQ(std::get<int64_t>(*toks[0].literal), 7);
+  EXPECT_EQ(std::get<int64_t>(*toks[1].literal), 3000000000);
+  // Values past INT64_MAX keep their bit pattern.
+  EXPECT_EQ(static_cast<uint64_t>(std::get<int64_t>(*toks[2].literal)),
+            UINT64_MAX);
+  EXPECT_FALSE(toks[3].literal.has_value());
+}
+
+TEST(LexerTest, LexNumericLiteralSuffixes) {
+  auto toks = TokenizeFromSource("1.0f32 0.1 10i64 255u8 256u8 2f64 1.5i32 3q");
+  ASSERT_EQ(toks.size(), 9u);
+
+  EXPECT_EQ(toks[0].kind, cinder::Token::Type::FLT_LITERAL);
+  EXPECT_EQ(toks[0].suffix, cinder::Token::Type::FLT32_SPECIFIER);
+  EXPECT_EQ(std::get<double>(*toks[0].literal), 1.0);
+  EXPECT_FALSE(toks[1].suffix.has_value());
+  EXPECT_EQ(std::get<double>(*toks[1].literal), 0.1);
+  EXPECT_EQ(toks[2].suffix, cinder::Token::Type::INT64_SPECIFIER);
+  EXPECT_EQ(std::get<int64_t>(*toks[2].literal), 10);
+  EXPECT_EQ(std::get<int64_t>(*toks[3].literal), 255);
+  EXPECT_EQ(toks[5].kind, cinder::Token::Type::FLT_LITERAL);
+  EXPECT_EQ(std::get<double>(*toks[5].literal), 2.0);
+
+  // Out-of-range, mismatched and unknown suffixes leave no value.
+  EXPECT_FALSE(toks[4].literal.has_value());
+  EXPECT_FALSE(toks[6].literal.has_value());
+  EXPECT_FALSE(toks[7].literal.has_value());
+}
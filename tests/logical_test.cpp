@@ -0,0 +1,121 @@
+#include <memory>
+#include <string>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+bool AnalyzeSource(const std::string& source) {
+  auto mod = ParseModuleFromSource(source);
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  return !analyzer.HadError();
+}
+
+/** @brief Returns the value returned by the first statement of `fn`. */
+Expr* ReturnedValue(ModuleStmt& mod, size_t index) {
+  auto* fn = dynamic_cast<FunctionStmt*>(mod.stmts[index].get());
+  EXPECT_NE(fn, nullptr);
+  auto* ret = dynamic_cast<ReturnStmt*>(fn->body[0].get());
+  EXPECT_NE(ret, nullptr);
+  return ret->value.get();
+}
+
+}  // namespace
+
+TEST(LogicalTest, ParsesPrecedence) {
+  auto module = ParseModuleFromSource(R"(
+mod main;
+def f(bool a, bool b, int32 x) -> bool
+  return a || b && !(x < 3);
+end
+def g(bool a, int32 x, int32 y) -> int32
+  return x if a else y if x < y else 0;
+end
+)");
+
+  auto* logical_or = dynamic_cast<Logical*>(ReturnedValue(*module, 0));
+  ASSERT_NE(logical_or, nullptr);
+  EXPECT_EQ(logical_or->op.kind, cinder::Token::Type::PIPEPIPE);
+  auto* logical_and = dynamic_cast<Logical*>(logical_or->right.get());
+  ASSERT_NE(logical_and, nullptr);
+  EXPECT_EQ(logical_and->op.kind, cinder::Token::Type::AMPAMP);
+  EXPECT_TRUE(logical_and->right->IsUnary());
+
+  auto* outer = dynamic_cast<IfExpr*>(ReturnedValue(*module, 1));
+  ASSERT_NE(outer, nullptr);
+  EXPECT_TRUE(outer->then->IsVariable());
+  EXPECT_TRUE(outer->otherwise->IsIfExpr());
+}
+
+TEST(LogicalTest, LeavesIfStatementsAfterExpressions) {
+  auto module = ParseModuleFromSource(R"(
+mod main;
+def f(int32 n) -> int32
+  int32: i = 0;
+  while i < n if i == 3 return i; else i = i + 1; end
+  end
+  return n;
+end
+)");
+
+  auto* fn = dynamic_cast<FunctionStmt*>(module->stmts[0].get());
+  ASSERT_NE(fn, nullptr);
+  ASSERT_EQ(fn->body.size(), 3u);
+  auto* loop = dynamic_cast<WhileStmt*>(fn->body[1].get());
+  ASSERT_NE(loop, nullptr);
+  EXPECT_TRUE(loop->condition->IsConditional());
+  ASSERT_EQ(loop->body.size(), 1u);
+  EXPECT_NE(dynamic_cast<IfStmt*>(loop->body[0].get()), nullptr);
+}
+
+TEST(LogicalTest, RequiresBoolOperandsAndMatchingBranches) {
+  EXPECT_TRUE(AnalyzeSource(R"(
+mod main;
+def f(bool a, int32 x, int64 y) -> int64
+  bool: ok = a && x > 0 || !a;
+  return y if ok else x;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+def f(int32 x) -> bool
+  return x && true;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+def f(int32 x) -> bool
+  return !x;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+def f(int32 x) -> int32
+  return 1 if x else 2;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+def f(bool a, int32 x) -> int32
+  return x if a else "no";
+end
+)"));
+}
@@ -0,0 +1,209 @@
+#include <memory>
+#include <string>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+bool AnalyzeSource(const std::string& source) {
+  auto mod = ParseModuleFromSource(source);
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  return !analyzer.HadError();
+}
+
+/** @brief Returns the first statement of the body of function `index`. */
+MatchStmt* MatchIn(ModuleStmt& mod, size_t index) {
+  auto* fn = dynamic_cast<FunctionStmt*>(mod.stmts[index].get());
+  EXPECT_NE(fn, nullptr);
+  return dynamic_cast<MatchStmt*>(fn->body[0].get());
+}
+
+}  // namespace
+
+TEST(MatchTest, ParsesArmsRangesAndElse) {
+  auto module = ParseModuleFromSource(R"(
+mod main;
+def step(int32 op) -> int32
+  match op
+  case 0
+    return 1;
+  case 1, 2, 10...20
+    int32: x = op;
+    return x;
+  else
+    return 0;
+  end
+  return 0;
+end
+)");
+
+  MatchStmt* match = MatchIn(*module, 0);
+  ASSERT_NE(match, nullptr);
+  ASSERT_EQ(match->arms.size(), 2u);
+  EXPECT_EQ(match->arms[0].patterns.size(), 1u);
+  EXPECT_EQ(match->arms[0].body.size(), 1u);
+  ASSERT_EQ(match->arms[1].patterns.size(), 3u);
+  EXPECT_EQ(match->arms[1].patterns[1].high, nullptr);
+  EXPECT_NE(match->arms[1].patterns[2].high, nullptr);
+  EXPECT_EQ(match->arms[1].body.size(), 2u);
+  EXPECT_EQ(match->otherwise.size(), 1u);
+}
+
+TEST(MatchTest, FoldsCaseValuesToTheSubjectType) {
+  auto module = ParseModuleFromSource(R"(
+mod main;
+const int32: BASE = 100;
+def step(uint8 op) -> int32
+  match op
+  case 200...255
+    return 1;
+  case 0
+    return 2;
+  end
+  return 0;
+end
+def offset(int64 op) -> int32
+  match op
+  case 0 - 5...0 - 1, BASE + 1
+    return 1;
+  end
+  return 0;
+end
+)");
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({module.get()});
+  ASSERT_FALSE(analyzer.HadError());
+
+  MatchStmt* unsigned_match = MatchIn(*module, 1);
+  ASSERT_NE(unsigned_match, nullptr);
+  EXPECT_EQ(unsigned_match->arms[0].patterns[0].low_value, 200);
+  EXPECT_EQ(unsigned_match->arms[0].patterns[0].high_value, 255);
+
+  MatchStmt* signed_match = MatchIn(*module, 2);
+  ASSERT_NE(signed_match, nullptr);
+  EXPECT_EQ(signed_match->arms[0].patterns[0].low_value, -5);
+  EXPECT_EQ(signed_match->arms[0].patterns[0].high_value, -1);
+  EXPECT_EQ(signed_match->arms[0].patterns[1].low_value, 101);
+  EXPECT_EQ(signed_match->arms[0].patterns[1].high_value, 101);
+}
+
+TEST(MatchTest, EvaluatesCallsFoldedBeforeTheMatch) {
+  auto module = ParseModuleFromSource(R"(
+mod main;
+def main() -> int32
+  const int32: one = classify(1);
+  const int32: zero = classify(0);
+  return one + zero;
+end
+def classify(int32 x) -> int32
+  match x
+  case 1
+    return 10;
+  else
+    return 20;
+  end
+  return 0;
+end
+const int32: K = classify(1);
+)");
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({module.get()});
+  ASSERT_FALSE(analyzer.HadError());
+
+  auto* global = dynamic_cast<VarDeclarationStmt*>(module->stmts[2].get());
+  ASSERT_NE(global, nullptr);
+  ASSERT_TRUE(global->value->constant.has_value());
+  EXPECT_EQ(std::get<int64_t>(*global->value->constant), 10);
+
+  auto* main_fn = dynamic_cast<FunctionStmt*>(module->stmts[0].get());
+  ASSERT_NE(main_fn, nullptr);
+  auto* one = dynamic_cast<VarDeclarationStmt*>(main_fn->body[0].get());
+  auto* zero = dynamic_cast<VarDeclarationStmt*>(main_fn->body[1].get());
+  ASSERT_NE(one, nullptr);
+  ASSERT_NE(zero, nullptr);
+  ASSERT_TRUE(one->value->constant.has_value());
+  EXPECT_EQ(std::get<int64_t>(*one->value->constant), 10);
+  ASSERT_TRUE(zero->value->constant.has_value());
+  EXPECT_EQ(std::get<int64_t>(*zero->value->constant), 20);
+}
+
+TEST(MatchTest, RejectsInvalidCases) {
+  const char* kFloatSubject = R"(
+mod main;
+def f(flt64 x) -> int32
+  match x
+  case 1
+    return 1;
+  end
+  return 0;
+end
+)";
+  const char* kNotConstant = R"(
+mod main;
+def f(int32 x, int32 y) -> int32
+  match x
+  case y
+    return 1;
+  end
+  return 0;
+end
+)";
+  const char* kOverlap = R"(
+mod main;
+def f(int32 x) -> int32
+  match x
+  case 1...10
+    return 1;
+  case 10
+    return 2;
+  end
+  return 0;
+end
+)";
+  const char* kDuplicate = R"(
+mod main;
+def f(int32 x) -> int32
+  match x
+  case 3, 3
+    return 1;
+  end
+  return 0;
+end
+)";
+  const char* kEmptyRange = R"(
+mod main;
+def f(int32 x) -> int32
+  match x
+  case 5...1
+    return 1;
+  end
+  return 0;
+end
+)";
+
+  EXPECT_FALSE(AnalyzeSource(kFloatSubject));
+  EXPECT_FALSE(AnalyzeSource(kNotConstant));
+  EXPECT_FALSE(AnalyzeSource(kOverlap));
+  EXPECT_FALSE(AnalyzeSource(kDuplicate));
+  EXPECT_FALSE(AnalyzeSource(kEmptyRange));
+}
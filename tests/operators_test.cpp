@@ -0,0 +1,122 @@
+#include <memory>
+#include <string>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+bool AnalyzeSource(const std::string& source) {
+  auto mod = ParseModuleFromSource(source);
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  return !analyzer.HadError();
+}
+
+/** @brief Returns the initializer of the `index`-th statement of `fn`. */
+Expr* InitializerAt(ModuleStmt& mod, size_t fn, size_t index) {
+  auto* func = dynamic_cast<FunctionStmt*>(mod.stmts[fn].get());
+  EXPECT_NE(func, nullptr);
+  auto* decl = dynamic_cast<VarDeclarationStmt*>(func->body[index].get());
+  EXPECT_NE(decl, nullptr);
+  return decl ? decl->value.get() : nullptr;
+}
+
+}  // namespace
+
+TEST(OperatorsTest, BitwiseOperatorsBindTighterThanComparisons) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+def f(int32 x) -> int32
+  bool: even = x & 1 == 0;
+  int32: packed = x << 8 | x >> 4 & 15 ^ 3;
+  int32: rest = x % 4 + 1;
+  return 0;
+end
+)");
+
+  auto* even = dynamic_cast<Conditional*>(InitializerAt(*mod, 0, 0));
+  ASSERT_NE(even, nullptr);
+  auto* mask = dynamic_cast<Binary*>(even->left.get());
+  ASSERT_NE(mask, nullptr);
+  EXPECT_EQ(mask->op.kind, cinder::Token::Type::AMP);
+
+  // `|` < `^` < `&` < shifts, as in Python.
+  auto* packed = dynamic_cast<Binary*>(InitializerAt(*mod, 0, 1));
+  ASSERT_NE(packed, nullptr);
+  EXPECT_EQ(packed->op.kind, cinder::Token::Type::PIPE);
+  auto* xor_op = dynamic_cast<Binary*>(packed->right.get());
+  ASSERT_NE(xor_op, nullptr);
+  EXPECT_EQ(xor_op->op.kind, cinder::Token::Type::CARET);
+  auto* and_op = dynamic_cast<Binary*>(xor_op->left.get());
+  ASSERT_NE(and_op, nullptr);
+  EXPECT_EQ(and_op->op.kind, cinder::Token::Type::AMP);
+
+  auto* rest = dynamic_cast<Binary*>(InitializerAt(*mod, 0, 2));
+  ASSERT_NE(rest, nullptr);
+  EXPECT_EQ(rest->op.kind, cinder::Token::Type::Plus);
+  EXPECT_TRUE(rest->left->IsBinary());
+}
+
+TEST(OperatorsTest, FoldsBitwiseAndRemainder) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+def main() -> int32
+  const int32: a = (0 - 7) % 4;
+  const uint8: b = uint8(200) << 1;
+  const int32: c = (0 - 64) >> 2;
+  const int32: d = ~5 & 255 | 1 ^ 3;
+  const int32: e = 1 << 33;
+  return 0;
+end
+)");
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  ASSERT_FALSE(analyzer.HadError());
+
+  const int64_t expected[] = {-3, 144, -16, 250 | (1 ^ 3), 2};
+  for (size_t i = 0; i < 5; ++i) {
+    Expr* value = InitializerAt(*mod, 0, i);
+    ASSERT_TRUE(value->constant.has_value()) << i;
+    EXPECT_EQ(std::get<int64_t>(*value->constant), expected[i]) << i;
+  }
+}
+
+TEST(OperatorsTest, RequiresIntegerOperandsForBitOperations) {
+  EXPECT_TRUE(AnalyzeSource(R"(
+mod main;
+def f(uint64 x, flt64 y) -> flt64
+  uint64: h = (x ^ (x >> 33)) * 3;
+  return y % 2.0;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+def f(flt64 x) -> flt64
+  return x & 1.0;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+def f(bool x) -> bool
+  return ~x;
+end
+)"));
+}
@@ -0,0 +1,64 @@
+#include <memory>
+#include <string>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+}  // namespace
+
+TEST(ParserBranchHintTest, ParsesHintsBeforeConditions) {
+  auto module = ParseModuleFromSource(R"(
+mod main;
+def main() -> int32
+  int32: n = 0;
+  for int32: i = 0; likely i < 100; ++i
+    n = n + i;
+  end
+  while unlikely n < 0
+    n = n + 1;
+  end
+  if unlikely n == 7
+    return 1;
+  end
+  if n == 8
+    return 2;
+  end
+  return 0;
+end
+)");
+
+  auto* fn = dynamic_cast<FunctionStmt*>(module->stmts[0].get());
+  ASSERT_NE(fn, nullptr);
+  ASSERT_EQ(fn->body.size(), 6u);
+
+  auto* loop = dynamic_cast<ForStmt*>(fn->body[1].get());
+  ASSERT_NE(loop, nullptr);
+  EXPECT_EQ(loop->hint, BranchHint::Likely);
+  EXPECT_TRUE(loop->condition->IsConditional());
+
+  auto* spin = dynamic_cast<WhileStmt*>(fn->body[2].get());
+  ASSERT_NE(spin, nullptr);
+  EXPECT_EQ(spin->hint, BranchHint::Unlikely);
+
+  auto* rare = dynamic_cast<IfStmt*>(fn->body[3].get());
+  auto* plain = dynamic_cast<IfStmt*>(fn->body[4].get());
+  ASSERT_NE(rare, nullptr);
+  ASSERT_NE(plain, nullptr);
+  EXPECT_EQ(rare->hint, BranchHint::Unlikely);
+  EXPECT_EQ(plain->hint, BranchHint::None);
+}
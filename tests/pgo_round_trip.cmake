@@ -0,0 +1,48 @@
+# Builds a corpus program with --profile-generate, runs it, merges the raw
+# profile with llvm-profdata and rebuilds it with --profile-use. Both binaries
+# must print the expected output and the profile must match the program.
+#
+# Inputs: CINDER, PROFDATA, PROGRAM (path without extension), WORK_DIR.
+
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+get_filename_component(name "${PROGRAM}" NAME)
+file(READ "${PROGRAM}.expected" expected)
+
+function(run_checked)
+  execute_process(COMMAND ${ARGN}
+                  RESULT_VARIABLE rc
+                  OUTPUT_VARIABLE out
+                  ERROR_VARIABLE err)
+  if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "${ARGN} failed (${rc}):\n${out}${err}")
+  endif()
+  set(run_stdout "${out}" PARENT_SCOPE)
+  set(run_stderr "${err}" PARENT_SCOPE)
+endfunction()
+
+run_checked("${CINDER}" --compile -O2 --profile-generate --l-flags=-lm
+            -o "${WORK_DIR}/${name}-instr" "${PROGRAM}.ci")
+set(ENV{LLVM_PROFILE_FILE} "${WORK_DIR}/${name}-%p.profraw")
+run_checked("${WORK_DIR}/${name}-instr")
+if(NOT run_stdout STREQUAL expected)
+  message(FATAL_ERROR "instrumented ${name} printed:\n${run_stdout}")
+endif()
+
+file(GLOB raw_profiles "${WORK_DIR}/*.profraw")
+if(NOT raw_profiles)
+  message(FATAL_ERROR "instrumented ${name} wrote no profile")
+endif()
+run_checked("${PROFDATA}" merge -o "${WORK_DIR}/${name}.profdata"
+            ${raw_profiles})
+
+run_checked("${CINDER}" --compile -O2
+            "--profile-use=${WORK_DIR}/${name}.profdata" --l-flags=-lm
+            -o "${WORK_DIR}/${name}-pgo" "${PROGRAM}.ci")
+if(run_stdout MATCHES "warning" OR run_stderr MATCHES "warning")
+  message(FATAL_ERROR "profile did not apply cleanly:\n${run_stderr}")
+endif()
+run_checked("${WORK_DIR}/${name}-pgo")
+if(NOT run_stdout STREQUAL expected)
+  message(FATAL_ERROR "PGO-built ${name} printed:\n${run_stdout}")
+endif()
@@ -0,0 +1,189 @@
+#include <memory>
+#include <string>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/alias_analysis.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+bool AnalyzeSource(const std::string& source) {
+  auto mod = ParseModuleFromSource(source);
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  return !analyzer.HadError();
+}
+
+std::unique_ptr<ModuleStmt> AnalyzeAliases(const std::string& source,
+                                           TypeContext& types) {
+  auto mod = ParseModuleFromSource(source);
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  EXPECT_FALSE(analyzer.HadError());
+  AliasAnalysis aliases;
+  aliases.Run({mod.get()});
+  return mod;
+}
+
+/** @brief Returns the prototype of the `index`-th statement of `mod`. */
+FunctionProto* ProtoAt(ModuleStmt& mod, size_t index) {
+  auto* fn = dynamic_cast<FunctionStmt*>(mod.stmts[index].get());
+  EXPECT_NE(fn, nullptr);
+  return dynamic_cast<FunctionProto*>(fn->proto.get());
+}
+
+}  // namespace
+
+TEST(ReferenceTypesTest, ParsesReferenceTypePrefixes) {
+  auto module = ParseModuleFromSource(R"(
+mod main;
+def f(ref int32 a, ptr flt64[] b) -> void
+  ref int32: c = a;
+end
+)");
+
+  ASSERT_EQ(module->stmts.size(), 1u);
+  FunctionProto* proto = ProtoAt(*module, 0);
+  ASSERT_NE(proto, nullptr);
+  ASSERT_EQ(proto->args.size(), 2u);
+  EXPECT_EQ(proto->args[0].type_token.lexeme, "ref int32");
+  EXPECT_EQ(proto->args[1].type_token.lexeme, "ptr flt64[]");
+
+  auto* fn = dynamic_cast<FunctionStmt*>(module->stmts[0].get());
+  auto* decl = dynamic_cast<VarDeclarationStmt*>(fn->body[0].get());
+  ASSERT_NE(decl, nullptr);
+  EXPECT_EQ(decl->type.lexeme, "ref int32");
+}
+
+TEST(ReferenceTypesTest, AcceptsReferencesToLvalues) {
+  EXPECT_TRUE(AnalyzeSource(R"(
+mod main;
+struct Point
+  int32: x;
+  int32: y;
+end
+
+def set(ref int32 slot, int32 value) -> void
+  slot = value;
+end
+
+def move(ref Point p) -> void
+  p.x = p.x + 1;
+  set(p.y, 2);
+end
+
+def main() -> int32
+  Point: p = Point(1, 2);
+  int32[4]: xs = [0];
+  move(p);
+  set(xs[1], p.x);
+  ref int32: last = xs[3];
+  last = 4;
+  return xs[3];
+end
+)"));
+}
+
+TEST(ReferenceTypesTest, RejectsInvalidReferences) {
+  const char* kNonLvalue = R"(
+mod main;
+def set(ref int32 slot) -> void
+  slot = 1;
+end
+def main() -> int32
+  set(1 + 2);
+  return 0;
+end
+)";
+  const char* kConstant = R"(
+mod main;
+const int32: K = 3;
+def set(ref int32 slot) -> void
+  slot = 1;
+end
+def main() -> int32
+  set(K);
+  return 0;
+end
+)";
+  const char* kMismatch = R"(
+mod main;
+def set(ref int32 slot) -> void
+  slot = 1;
+end
+def main() -> int32
+  int64: wide = 0;
+  set(wide);
+  return 0;
+end
+)";
+  const char* kReturned = R"(
+mod main;
+def get(ref int32 slot) -> ref int32
+  return slot;
+end
+)";
+  const char* kGlobal = R"(
+mod main;
+int32: n = 0;
+ref int32: alias = n;
+)";
+
+  EXPECT_FALSE(AnalyzeSource(kNonLvalue));
+  EXPECT_FALSE(AnalyzeSource(kConstant));
+  EXPECT_FALSE(AnalyzeSource(kMismatch));
+  EXPECT_FALSE(AnalyzeSource(kReturned));
+  EXPECT_FALSE(AnalyzeSource(kGlobal));
+}
+
+TEST(ReferenceTypesTest, ProvesUnaliasedReferenceParameters) {
+  TypeContext types;
+  auto mod = AnalyzeAliases(R"(
+mod main;
+int32: calls = 0;
+
+def scale(ref flt64[8] xs, flt64 k) -> void
+  for int32: i = 0; i < 8; ++i
+    xs[i] = xs[i] * k;
+  end
+end
+
+def swap(ref int32 a, ref int32 b) -> void
+  int32: t = a;
+  a = b;
+  b = t;
+end
+
+def count(ref int32 a) -> void
+  a = calls;
+end
+
+def read(ref int32 a, ref int32 b) -> int32
+  return a + b;
+end
+)",
+                            types);
+
+  EXPECT_TRUE(ProtoAt(*mod, 1)->args[0].no_alias);
+  EXPECT_FALSE(ProtoAt(*mod, 2)->args[0].no_alias);
+  EXPECT_FALSE(ProtoAt(*mod, 2)->args[1].no_alias);
+  EXPECT_FALSE(ProtoAt(*mod, 3)->args[0].no_alias);
+  EXPECT_TRUE(ProtoAt(*mod, 4)->args[0].no_alias);
+  EXPECT_TRUE(ProtoAt(*mod, 4)->args[1].no_alias);
+}
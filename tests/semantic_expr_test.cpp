@@ -0,0 +1,56 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+bool AnalyzeSource(const std::string& source) {
+  auto mod = ParseModuleFromSource(source);
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  return !analyzer.HadError();
+}
+
+}  // namespace
+
+TEST(SemanticExprTest, GroupingTakesInnerExpressionType) {
+  EXPECT_TRUE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  int32: a = (1 + 2) * (3 - 4);
+  int32: b = ((a));
+  return b;
+end
+)"));
+}
+
+TEST(SemanticExprTest, RejectsGroupingTypeMismatch) {
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  flt32: a = (1 + 2);
+  return 0;
+end
+)"));
+}
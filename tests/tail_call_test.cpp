@@ -0,0 +1,216 @@
+#include <memory>
+#include <string>
+
+#include "cinder/ast/expr/expr.hpp"
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+bool AnalyzeSource(const std::string& source) {
+  auto mod = ParseModuleFromSource(source);
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  return !analyzer.HadError();
+}
+
+}  // namespace
+
+TEST(TailCallTest, ParsesReturnTail) {
+  auto module = ParseModuleFromSource(R"(
+mod main;
+def count(int64 n, int64 acc) -> int64
+  int64: tail = acc + 1;
+  return tail count(n - 1, tail);
+end
+)");
+
+  ASSERT_EQ(module->stmts.size(), 1u);
+  auto* fn = dynamic_cast<FunctionStmt*>(module->stmts[0].get());
+  ASSERT_NE(fn, nullptr);
+  ASSERT_EQ(fn->body.size(), 2u);
+  auto* ret = dynamic_cast<ReturnStmt*>(fn->body[1].get());
+  ASSERT_NE(ret, nullptr);
+  EXPECT_TRUE(ret->is_tail);
+  auto* call = dynamic_cast<CallExpr*>(ret->value.get());
+  ASSERT_NE(call, nullptr);
+  EXPECT_TRUE(call->is_tail);
+}
+
+TEST(TailCallTest, AcceptsMatchingSignatures) {
+  EXPECT_TRUE(AnalyzeSource(R"(
+mod main;
+int32[4]: table = [1, 2, 3, 4];
+
+def is_odd(int64 n) -> bool
+  if n == 0
+    return false;
+  end
+  return tail is_even(n - 1);
+end
+
+def is_even(int64 n) -> bool
+  if n == 0
+    return true;
+  end
+  return tail is_odd(n - 1);
+end
+
+def sum(int32[] xs, int64 i, ref int32 acc) -> void
+  if i == xs.len
+    return;
+  end
+  acc = acc + xs[i];
+  return tail sum(xs[1:], i, acc);
+end
+
+def first(int32[] xs, int64 i, ref int32 acc) -> void
+  return tail sum(table, i, xs[0]);
+end
+)"));
+}
+
+TEST(TailCallTest, RejectsMismatchedTargets) {
+  const char* kSignature = R"(
+mod main;
+def half(int32 n) -> int64
+  return int64(n) / 2;
+end
+def f(int64 n) -> int64
+  return tail half(int32(n));
+end
+)";
+  const char* kExtern = R"(
+mod main;
+extern labs(int64 n) -> int64
+def f(int64 n) -> int64
+  return tail labs(n);
+end
+)";
+  const char* kConstructor = R"(
+mod main;
+struct Point
+  int32: x;
+  int32: y;
+end
+def origin() -> Point
+  return tail Point(0, 0);
+end
+)";
+
+  // `main` keeps the C convention while `run` gets `fastcc`.
+  const char* kFromMain = R"(
+mod main;
+def run() -> int32
+  return 0;
+end
+def main() -> int32
+  return tail run();
+end
+)";
+  const char* kIntoMain = R"(
+mod main;
+def main() -> int32
+  return 0;
+end
+def restart() -> int32
+  return tail main();
+end
+)";
+
+  EXPECT_FALSE(AnalyzeSource(kSignature));
+  EXPECT_FALSE(AnalyzeSource(kExtern));
+  EXPECT_FALSE(AnalyzeSource(kConstructor));
+  EXPECT_FALSE(AnalyzeSource(kFromMain));
+  EXPECT_FALSE(AnalyzeSource(kIntoMain));
+}
+
+TEST(TailCallTest, RejectsPointersIntoTheCallerFrame) {
+  const char* kLocalReference = R"(
+mod main;
+def f(ref int32 acc) -> void
+  int32: local = acc;
+  return tail f(local);
+end
+)";
+  const char* kParameterReference = R"(
+mod main;
+def f(int32 n, ref int32 acc) -> void
+  return tail f(n, n);
+end
+)";
+  const char* kLocalArray = R"(
+mod main;
+def f(int32[] xs) -> int32
+  int32[4]: local = [0];
+  return tail f(local);
+end
+)";
+
+  EXPECT_FALSE(AnalyzeSource(kLocalReference));
+  EXPECT_FALSE(AnalyzeSource(kParameterReference));
+  EXPECT_FALSE(AnalyzeSource(kLocalArray));
+}
+
+TEST(TailCallTest, RejectsStructsCopiedOnTheStack) {
+  const char* kPair = R"(
+mod main;
+struct Pair
+  int64: a;
+  int64: b;
+end
+def f(Pair p, int64 n) -> int64
+  if n == 0
+    return p.a;
+  end
+  return tail f(p, n - 1);
+end
+)";
+  const char* kNamed = R"(
+mod main;
+struct Named
+  str: name;
+  int32: id;
+end
+def f(Named v, int64 n) -> int64
+  if n == 0
+    return 0;
+  end
+  return tail f(v, n - 1);
+end
+)";
+  const char* kTriple = R"(
+mod main;
+struct Triple
+  int32: a;
+  int32: b;
+  int32: c;
+end
+def f(Triple t, int64 n) -> int64
+  if n == 0
+    return 0;
+  end
+  return tail f(t, n - 1);
+end
+)";
+
+  EXPECT_TRUE(AnalyzeSource(kPair));
+  EXPECT_FALSE(AnalyzeSource(kNamed));
+  EXPECT_FALSE(AnalyzeSource(kTriple));
+}
@@ -0,0 +1,144 @@
+#include <memory>
+#include <string>
+
+#include "cinder/ast/stmt/stmt.hpp"
+#include "cinder/frontend/lexer.hpp"
+#include "cinder/frontend/parser.hpp"
+#include "cinder/semantic/bounds_check.hpp"
+#include "cinder/semantic/semantic_analyzer.hpp"
+#include "cinder/semantic/type_context.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<ModuleStmt> ParseModuleFromSource(const std::string& source) {
+  Lexer lexer(source);
+  lexer.ScanTokens();
+  Parser parser(lexer.GetTokens());
+
+  std::unique_ptr<Stmt> root = parser.Parse();
+  auto* mod = dynamic_cast<ModuleStmt*>(root.release());
+  EXPECT_NE(mod, nullptr);
+  return std::unique_ptr<ModuleStmt>(mod);
+}
+
+bool AnalyzeSource(const std::string& source) {
+  auto mod = ParseModuleFromSource(source);
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  return !analyzer.HadError();
+}
+
+}  // namespace
+
+TEST(VectorTypesTest, AcceptsLaneWiseOperations) {
+  EXPECT_TRUE(AnalyzeSource(R"(
+mod main;
+
+def scale(flt32x4 v, flt32 k) -> flt32x4
+  return v * flt32x4(k) + 1.0;
+end
+
+def main() -> int32
+  flt32x4: a = [1.0, 2.0, 3.0, 4.0];
+  flt32x4: b = scale(a, 0.5);
+  a[0] = b[3];
+  boolx4: wider = a < b;
+  int32x8: counts = int32x8(0);
+  counts = counts + int32x8(1);
+  if wider.any
+    return counts.sum;
+  end
+  return int32(a.max) + int32(b.sum) + a.len;
+end
+)"));
+}
+
+TEST(VectorTypesTest, TypesComparisonsAsMasks) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+
+def main() -> int32
+  int32x4: a = int32x4(1);
+  boolx4: m = a == int32x4(2);
+  int32x4: ones = int32x4(m);
+  return 0;
+end
+)");
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  ASSERT_FALSE(analyzer.HadError());
+
+  auto* fn = dynamic_cast<FunctionStmt*>(mod->stmts[0].get());
+  ASSERT_NE(fn, nullptr);
+  auto* decl = dynamic_cast<VarDeclarationStmt*>(fn->body[1].get());
+  ASSERT_NE(decl, nullptr);
+  EXPECT_EQ(decl->value->type, types.Vector(types.Bool(), 4));
+}
+
+TEST(VectorTypesTest, RejectsMismatchedShapes) {
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  flt32x4: a = flt32x4(1.0);
+  flt32x8: b = flt32x8(1.0);
+  flt32x4: c = a + b;
+  return 0;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  flt32x4: a = flt32x4(1.0);
+  flt32: k = 2.0;
+  flt32x4: c = a * k;
+  return 0;
+end
+)"));
+  EXPECT_FALSE(AnalyzeSource(R"(
+mod main;
+
+def main() -> int32
+  boolx4: m = flt32x4(1.0) < flt32x4(2.0);
+  return m.sum;
+end
+)"));
+}
+
+TEST(VectorTypesTest, ProvesLaneLoops) {
+  auto mod = ParseModuleFromSource(R"(
+mod main;
+
+def total(int32x8 v) -> int32
+  int32: t = 0;
+  for int32: i = 0; i < v.len; ++i
+    t = t + v[i];
+  end
+  return t;
+end
+)");
+  TypeContext types;
+  SemanticAnalyzer analyzer(types);
+  analyzer.AnalyzeProgram({mod.get()});
+  ASSERT_FALSE(analyzer.HadError());
+  BoundsCheckAnalysis bounds;
+  bounds.Run({mod.get()});
+
+  auto* fn = dynamic_cast<FunctionStmt*>(mod->stmts[0].get());
+  ASSERT_NE(fn, nullptr);
+  auto* loop = dynamic_cast<ForStmt*>(fn->body[1].get());
+  ASSERT_NE(loop, nullptr);
+  auto* stmt = dynamic_cast<ExpressionStmt*>(loop->body[0].get());
+  ASSERT_NE(stmt, nullptr);
+  auto* assign = dynamic_cast<Assign*>(stmt->expr.get());
+  ASSERT_NE(assign, nullptr);
+  auto* sum = dynamic_cast<Binary*>(assign->value.get());
+  ASSERT_NE(sum, nullptr);
+  auto* access = dynamic_cast<IndexAccess*>(sum->right.get());
+  ASSERT_NE(access, nullptr);
+  EXPECT_EQ(access->bounds, BoundsCheck::Proven);
+}